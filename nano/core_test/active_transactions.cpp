@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
 #include <numeric>
 
 using namespace std::chrono_literals;
@@ -272,10 +273,10 @@ TEST (active_transactions, inactive_votes_cache_existing_vote)
 	ASSERT_EQ (send->hash (), last_vote1.hash);
 	ASSERT_EQ (1, last_vote1.sequence);
 	// Attempt to change vote with inactive_votes_cache
+	node.active.add_inactive_votes_cache (send->hash (), key.pub);
+	ASSERT_EQ (1, node.active.find_inactive_votes_cache (send->hash ()).voters.size ());
 	{
 		nano::lock_guard<std::mutex> active_guard (node.active.mutex);
-		node.active.add_inactive_votes_cache (send->hash (), key.pub);
-		ASSERT_EQ (1, node.active.find_inactive_votes_cache (send->hash ()).voters.size ());
 		election->insert_inactive_votes_cache (send->hash ());
 	}
 	// Check that election data is not changed
@@ -331,12 +332,9 @@ TEST (active_transactions, inactive_votes_cache_multiple_votes)
 	system.deadline_set (5s);
 	while (true)
 	{
+		if (node.active.find_inactive_votes_cache (send1->hash ()).voters.size () == 2)
 		{
-			nano::lock_guard<std::mutex> active_guard (node.active.mutex);
-			if (node.active.find_inactive_votes_cache (send1->hash ()).voters.size () == 2)
-			{
-				break;
-			}
+			break;
 		}
 		ASSERT_NO_ERROR (system.poll ());
 	}
@@ -669,7 +667,7 @@ TEST (active_transactions, vote_replays)
 
 	// Removing blocks as recently confirmed makes every vote indeterminate
 	{
-		nano::lock_guard<std::mutex> guard (node.active.mutex);
+		nano::lock_guard<std::mutex> guard (node.active.recently_confirmed_mutex);
 		node.active.recently_confirmed.clear ();
 	}
 	ASSERT_EQ (nano::vote_code::indeterminate, node.active.vote (vote_send1));
@@ -745,7 +743,7 @@ TEST (active_transactions, confirmation_consistency)
 			ASSERT_NO_ERROR (system.poll (5ms));
 		}
 		ASSERT_NO_ERROR (system.poll_until_true (1s, [&node, &block, i] {
-			nano::lock_guard<std::mutex> guard (node.active.mutex);
+			nano::lock_guard<std::mutex> guard (node.active.recently_confirmed_mutex);
 			EXPECT_EQ (i + 1, node.active.recently_confirmed.size ());
 			EXPECT_EQ (block->qualified_root (), node.active.recently_confirmed.back ().first);
 			return i + 1 == node.active.recently_cemented.size (); // done after a callback
@@ -1556,3 +1554,23 @@ TEST (active_transactions, pessimistic_elections)
 	ASSERT_EQ (2, node.active.expired_optimistic_election_infos.size ());
 }
 }
+
+// The recently confirmed set, the inactive votes cache and frontier prioritization do not wait on the elections lock
+TEST (active_transactions, independent_locks)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_request_loop = true;
+	auto & node = *system.add_node (node_flags);
+	auto send (std::make_shared<nano::state_block> (nano::genesis_account, nano::genesis_hash, nano::genesis_account, nano::genesis_amount - nano::Gxrb_ratio, nano::keypair ().pub, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (nano::genesis_hash)));
+	nano::lock_guard<std::mutex> guard (node.active.mutex);
+	auto future (std::async (std::launch::async, [&node, &send]() {
+		node.active.add_recently_confirmed (send->qualified_root (), send->hash ());
+		node.active.add_recently_cemented (nano::election_status{ send, 0, std::chrono::milliseconds (0), std::chrono::milliseconds (0), 0, 1, 0, nano::election_status_type::active_confirmed_quorum });
+		node.active.add_inactive_votes_cache (send->hash (), nano::dev_genesis_key.pub);
+		return node.active.list_recently_cemented ().size () + node.active.inactive_votes_cache_size () + node.active.priority_cementable_frontiers_size ();
+	}));
+	ASSERT_EQ (std::future_status::ready, future.wait_for (5s));
+	ASSERT_EQ (2, future.get ());
+	ASSERT_EQ (1, node.active.find_inactive_votes_cache (send->hash ()).voters.size ());
+}
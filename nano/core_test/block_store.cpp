@@ -1,6 +1,7 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/lmdbconfig.hpp>
 #include <nano/lib/logger_mt.hpp>
+#include <nano/lib/rocksdbconfig.hpp>
 #include <nano/lib/stats.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/lib/work.hpp>
@@ -8,6 +9,7 @@
 #include <nano/node/lmdb/lmdb.hpp>
 #include <nano/node/rocksdb/rocksdb.hpp>
 #include <nano/node/testing.hpp>
+#include <nano/node/unchecked_map.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/utility.hpp>
 #include <nano/secure/versioning.hpp>
@@ -29,6 +31,8 @@ void modify_confirmation_height_to_v15 (nano::mdb_store & store, nano::transacti
 void write_sideband_v14 (nano::mdb_store & store_a, nano::transaction & transaction_a, nano::block const & block_a, MDB_dbi db_a);
 void write_sideband_v15 (nano::mdb_store & store_a, nano::transaction & transaction_a, nano::block const & block_a);
 void write_block_w_sideband_v18 (nano::mdb_store & store_a, MDB_dbi database, nano::write_transaction & transaction_a, nano::block const & block_a);
+void write_block_w_sideband_v20 (nano::mdb_store & store_a, nano::write_transaction & transaction_a, nano::block const & block_a);
+void write_block_w_sideband_v20 (nano::rocksdb_store & store_a, nano::write_transaction & transaction_a, nano::block const & block_a);
 }
 
 TEST (block_store, construction)
@@ -161,6 +165,159 @@ TEST (block_store, clear_successor)
 	}
 }
 
+TEST (block_store, block_cache)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	auto & cache (store->get_block_cache ());
+	cache.resize (64);
+	nano::keypair key1;
+	nano::open_block block1 (0, 1, 0, key1.prv, key1.pub, 0);
+	block1.sideband_set ({});
+	nano::receive_block block2 (block1.hash (), 2, key1.prv, key1.pub, 0);
+	block2.sideband_set ({});
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block_put (transaction, block1.hash (), block1);
+		store->block_put (transaction, block2.hash (), block2);
+	}
+	ASSERT_EQ (2, cache.size ());
+	uint64_t hits;
+	uint64_t misses;
+	cache.take_counts (hits, misses);
+	{
+		// The cached predecessor was refreshed with its successor
+		auto transaction (store->tx_begin_read ());
+		auto block1_store (store->block_get (transaction, block1.hash ()));
+		ASSERT_NE (nullptr, block1_store);
+		ASSERT_EQ (block2.hash (), block1_store->sideband ().successor);
+		ASSERT_EQ (block1_store, store->block_get (transaction, block1.hash ()));
+		ASSERT_NE (nullptr, store->block_get (transaction, block2.hash ()));
+	}
+	cache.take_counts (hits, misses);
+	ASSERT_EQ (3, hits);
+	ASSERT_EQ (0, misses);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block_del (transaction, block2.hash ());
+		store->block_successor_clear (transaction, block1.hash ());
+	}
+	ASSERT_FALSE (cache.exists (block2.hash ()));
+	{
+		auto transaction (store->tx_begin_read ());
+		ASSERT_EQ (nullptr, store->block_get (transaction, block2.hash ()));
+		auto block1_store (store->block_get (transaction, block1.hash ()));
+		ASSERT_NE (nullptr, block1_store);
+		ASSERT_TRUE (block1_store->sideband ().successor.is_zero ());
+	}
+	// Reads fill the cache while nothing was committed since their snapshot
+	cache.clear ();
+	{
+		auto transaction (store->tx_begin_read ());
+		ASSERT_NE (nullptr, store->block_get (transaction, block1.hash ()));
+		ASSERT_TRUE (cache.exists (block1.hash ()));
+	}
+	{
+		auto transaction (store->tx_begin_write ());
+		ASSERT_NE (nullptr, store->block_get (transaction, block1.hash ()));
+	}
+	cache.take_counts (hits, misses);
+	ASSERT_EQ (2, hits);
+	ASSERT_EQ (2, misses);
+	// Updates are only visible to the writing transaction until it commits, and never to an older snapshot
+	nano::receive_block block3 (block1.hash (), 3, key1.prv, key1.pub, 0);
+	block3.sideband_set ({});
+	{
+		auto read (store->tx_begin_read ());
+		ASSERT_NE (nullptr, store->block_get (read, block1.hash ()));
+		{
+			auto transaction (store->tx_begin_write ());
+			store->block_put (transaction, block3.hash (), block3);
+			ASSERT_NE (nullptr, store->block_get (transaction, block3.hash ()));
+			ASSERT_EQ (block3.hash (), store->block_get (transaction, block1.hash ())->sideband ().successor);
+			ASSERT_EQ (nullptr, store->block_get (read, block3.hash ()));
+			ASSERT_TRUE (store->block_get (read, block1.hash ())->sideband ().successor.is_zero ());
+			ASSERT_FALSE (cache.exists (block3.hash ()));
+		}
+		ASSERT_TRUE (cache.exists (block3.hash ()));
+		ASSERT_EQ (nullptr, store->block_get (read, block3.hash ()));
+		ASSERT_TRUE (store->block_get (read, block1.hash ())->sideband ().successor.is_zero ());
+	}
+	{
+		auto transaction (store->tx_begin_read ());
+		ASSERT_NE (nullptr, store->block_get (transaction, block3.hash ()));
+		ASSERT_EQ (block3.hash (), store->block_get (transaction, block1.hash ())->sideband ().successor);
+	}
+}
+
+TEST (block_store, account_caches)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	store->get_account_info_cache ().resize (64);
+	store->get_confirmation_height_cache ().resize (64);
+	nano::account account (1);
+	nano::account_info info (2, 3, 4, 5, 6, 7, nano::epoch::epoch_0);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->confirmation_height_put (transaction, account, { 1, nano::block_hash (2) });
+		store->account_put (transaction, account, info);
+	}
+	ASSERT_EQ (1, store->get_account_info_cache ().size ());
+	ASSERT_EQ (1, store->get_confirmation_height_cache ().size ());
+	{
+		// An update committed after the snapshot is not visible to the read transaction
+		auto read (store->tx_begin_read ());
+		{
+			auto transaction (store->tx_begin_write ());
+			nano::account_info info_store;
+			ASSERT_FALSE (store->account_get (transaction, account, info_store));
+			ASSERT_EQ (info, info_store);
+			nano::confirmation_height_info confirmation_height_info;
+			ASSERT_FALSE (store->confirmation_height_get (transaction, account, confirmation_height_info));
+			ASSERT_EQ (1, confirmation_height_info.height);
+			store->confirmation_height_put (transaction, account, { 2, nano::block_hash (3) });
+			store->account_put (transaction, account, nano::account_info (8, 3, 4, 5, 6, 8, nano::epoch::epoch_0));
+		}
+		nano::account_info info_store;
+		ASSERT_FALSE (store->account_get (read, account, info_store));
+		ASSERT_EQ (info, info_store);
+		nano::confirmation_height_info confirmation_height_info;
+		ASSERT_FALSE (store->confirmation_height_get (read, account, confirmation_height_info));
+		ASSERT_EQ (1, confirmation_height_info.height);
+		ASSERT_EQ (nano::block_hash (2), confirmation_height_info.frontier);
+	}
+	{
+		// Newer read transactions are served from the caches
+		auto transaction (store->tx_begin_read ());
+		nano::account_info info_store;
+		ASSERT_FALSE (store->account_get (transaction, account, info_store));
+		ASSERT_EQ (8, info_store.block_count);
+		nano::confirmation_height_info confirmation_height_info;
+		ASSERT_FALSE (store->confirmation_height_get (transaction, account, confirmation_height_info));
+		ASSERT_EQ (2, confirmation_height_info.height);
+	}
+	{
+		auto transaction (store->tx_begin_write ());
+		store->account_del (transaction, account);
+		store->confirmation_height_del (transaction, account);
+		nano::account_info info_store;
+		ASSERT_TRUE (store->account_get (transaction, account, info_store));
+		nano::confirmation_height_info confirmation_height_info;
+		ASSERT_TRUE (store->confirmation_height_get (transaction, account, confirmation_height_info));
+	}
+	uint64_t hits;
+	uint64_t misses;
+	store->get_account_info_cache ().take_counts (hits, misses);
+	ASSERT_EQ (2, hits);
+	ASSERT_EQ (2, misses);
+	store->get_confirmation_height_cache ().take_counts (hits, misses);
+	ASSERT_EQ (2, hits);
+	ASSERT_EQ (2, misses);
+}
+
 TEST (block_store, add_nonempty_block)
 {
 	nano::logger_mt logger;
@@ -233,6 +390,78 @@ TEST (block_store, add_receive)
 	ASSERT_EQ (block, *latest2);
 }
 
+TEST (block_store, block_get_batch)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::open_block block1 (0, 1, 0, nano::keypair ().prv, 0, 0);
+	block1.sideband_set ({});
+	nano::open_block block2 (1, 1, 1, nano::keypair ().prv, 0, 0);
+	block2.sideband_set ({});
+	nano::block_hash missing (42);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block_put (transaction, block1.hash (), block1);
+		store->block_put (transaction, block2.hash (), block2);
+		auto blocks (store->block_get_batch (transaction, { block2.hash (), missing, block1.hash () }));
+		ASSERT_EQ (3, blocks.size ());
+		ASSERT_NE (nullptr, blocks[0]);
+		ASSERT_EQ (block2, *blocks[0]);
+		ASSERT_EQ (nullptr, blocks[1]);
+		ASSERT_NE (nullptr, blocks[2]);
+		ASSERT_EQ (block1, *blocks[2]);
+	}
+	auto transaction (store->tx_begin_read ());
+	auto blocks (store->block_get_batch (transaction, { missing, block1.hash (), block2.hash (), block1.hash () }));
+	ASSERT_EQ (4, blocks.size ());
+	ASSERT_EQ (nullptr, blocks[0]);
+	ASSERT_EQ (block1, *blocks[1]);
+	ASSERT_EQ (block2, *blocks[2]);
+	ASSERT_EQ (block1, *blocks[3]);
+	ASSERT_TRUE (store->block_get_batch (transaction, {}).empty ());
+}
+
+TEST (block_store, account_get_batch)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::account account1 (1);
+	nano::account account2 (2);
+	nano::account missing (3);
+	auto transaction (store->tx_begin_write ());
+	store->confirmation_height_put (transaction, account1, { 0, nano::block_hash (0) });
+	store->confirmation_height_put (transaction, account2, { 0, nano::block_hash (0) });
+	store->account_put (transaction, account1, { 10, account1, 10, 42, 100, 1, nano::epoch::epoch_0 });
+	store->account_put (transaction, account2, { 20, account2, 20, 43, 100, 2, nano::epoch::epoch_1 });
+	auto infos (store->account_get_batch (transaction, { account2, missing, account1 }));
+	ASSERT_EQ (3, infos.size ());
+	ASSERT_TRUE (infos[0].is_initialized ());
+	ASSERT_EQ (43, infos[0]->balance.number ());
+	ASSERT_EQ (nano::epoch::epoch_1, infos[0]->epoch ());
+	ASSERT_FALSE (infos[1].is_initialized ());
+	ASSERT_TRUE (infos[2].is_initialized ());
+	ASSERT_EQ (42, infos[2]->balance.number ());
+}
+
+TEST (block_store, pending_get_batch)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::pending_key key1 (1, 2);
+	nano::pending_key key2 (3, 4);
+	nano::pending_info pending1 (5, 6, nano::epoch::epoch_0);
+	auto transaction (store->tx_begin_write ());
+	store->pending_put (transaction, key1, pending1);
+	auto pending (store->pending_get_batch (transaction, { key2, key1 }));
+	ASSERT_EQ (2, pending.size ());
+	ASSERT_FALSE (pending[0].is_initialized ());
+	ASSERT_TRUE (pending[1].is_initialized ());
+	ASSERT_EQ (pending1, *pending[1]);
+}
+
 TEST (block_store, add_pending)
 {
 	nano::logger_mt logger;
@@ -455,6 +684,65 @@ TEST (unchecked, multiple_get)
 	ASSERT_EQ (unchecked5.size (), 0);
 }
 
+TEST (unchecked_map, memory_spill)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::unchecked_map unchecked (*store, 2, std::chrono::hours (1));
+	auto block1 (std::make_shared<nano::send_block> (4, 1, 2, nano::keypair ().prv, 4, 5));
+	auto block2 (std::make_shared<nano::send_block> (4, 1, 3, nano::keypair ().prv, 4, 5));
+	auto block3 (std::make_shared<nano::send_block> (5, 1, 2, nano::keypair ().prv, 4, 5));
+	auto info = [](std::shared_ptr<nano::block> const & block_a) {
+		return nano::unchecked_info (block_a, 0, nano::seconds_since_epoch (), nano::signature_verification::unknown);
+	};
+	{
+		auto transaction (store->tx_begin_write ());
+		unchecked.put (transaction, nano::unchecked_key (block1->previous (), block1->hash ()), info (block1));
+		unchecked.put (transaction, nano::unchecked_key (block2->previous (), block2->hash ()), info (block2));
+		ASSERT_EQ (2, unchecked.memory_size ());
+		ASSERT_EQ (0, store->unchecked_count (transaction));
+		// Over the memory limit, the oldest entry is written to the table
+		unchecked.put (transaction, nano::unchecked_key (block3->previous (), block3->hash ()), info (block3));
+		ASSERT_EQ (2, unchecked.memory_size ());
+		ASSERT_EQ (1, store->unchecked_count (transaction));
+		ASSERT_TRUE (store->unchecked_exists (transaction, nano::unchecked_key (block1->previous (), block1->hash ())));
+		ASSERT_EQ (3, unchecked.count (transaction));
+		// Dependents are found in both memory and the table
+		ASSERT_EQ (2, unchecked.get (transaction, block1->previous ()).size ());
+		ASSERT_EQ (1, unchecked.get (transaction, block3->previous ()).size ());
+		ASSERT_TRUE (unchecked.exists (transaction, nano::unchecked_key (block2->previous (), block2->hash ())));
+		// Entries in memory and in the table are visited in key order
+		std::vector<nano::block_hash> visited;
+		unchecked.for_each (transaction, [&visited](nano::unchecked_key const & key_a, nano::unchecked_info const &) { visited.push_back (key_a.previous); });
+		ASSERT_EQ (3, visited.size ());
+		ASSERT_TRUE (std::is_sorted (visited.begin (), visited.end ()));
+		visited.clear ();
+		unchecked.for_each (
+		transaction, nano::unchecked_key (0, 0), [&visited](nano::unchecked_key const & key_a, nano::unchecked_info const &) { visited.push_back (key_a.previous); }, [&visited]() { return visited.size () < 2; });
+		ASSERT_EQ (2, visited.size ());
+		ASSERT_EQ (block1->previous (), visited[0]);
+		ASSERT_EQ (block2->previous (), visited[1]);
+		unchecked.del (transaction, nano::unchecked_key (block1->previous (), block1->hash ()));
+		unchecked.del (transaction, nano::unchecked_key (block2->previous (), block2->hash ()));
+		ASSERT_EQ (0, store->unchecked_count (transaction));
+		ASSERT_EQ (1, unchecked.memory_size ());
+		ASSERT_FALSE (unchecked.exists (transaction, nano::unchecked_key (block2->previous (), block2->hash ())));
+		unchecked.flush (transaction);
+		ASSERT_EQ (0, unchecked.memory_size ());
+		ASSERT_EQ (1, store->unchecked_count (transaction));
+		ASSERT_EQ (1, unchecked.get (transaction, block3->previous ()).size ());
+		unchecked.clear (transaction);
+		ASSERT_EQ (0, unchecked.count (transaction));
+	}
+	// Without a memory budget every operation goes straight to the table
+	nano::unchecked_map disabled (*store, 0);
+	auto transaction (store->tx_begin_write ());
+	disabled.put (transaction, nano::unchecked_key (block1->previous (), block1->hash ()), info (block1));
+	ASSERT_EQ (0, disabled.memory_size ());
+	ASSERT_EQ (1, store->unchecked_count (transaction));
+}
+
 TEST (block_store, empty_accounts)
 {
 	nano::logger_mt logger;
@@ -1637,10 +1925,20 @@ TEST (mdb_block_store, upgrade_v17_v18)
 	ASSERT_FALSE (store.init_error ());
 	auto transaction (store.tx_begin_read ());
 
-	// Size of state block should equal that set in db (no change)
+	// Size of state block should equal that of the compact format the later upgrades convert to
 	nano::mdb_val value;
 	ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.blocks, nano::mdb_val (state_send.hash ()), value));
-	ASSERT_EQ (value.size (), sizeof (nano::block_type) + nano::state_block::size + nano::block_sideband::size (nano::block_type::state));
+	{
+		auto block (store.block_get (transaction, state_send.hash ()));
+		ASSERT_NE (nullptr, block);
+		std::vector<uint8_t> data;
+		{
+			nano::vectorstream stream (data);
+			nano::serialize_block (stream, *block);
+			block->sideband ().serialize_compact (stream, block->type ());
+		}
+		ASSERT_EQ (value.size (), data.size ());
+	}
 
 	// Check that sidebands are correctly populated
 	{
@@ -1867,6 +2165,7 @@ TEST (mdb_block_store, upgrade_v19_v20)
 		store.initialize (transaction, genesis, ledger.cache);
 		// Delete pruned table
 		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.pruned, 1));
+		write_block_w_sideband_v20 (store, transaction, *genesis.open);
 		store.version_put (transaction, 19);
 	}
 	// Upgrading should create the table
@@ -1879,6 +2178,68 @@ TEST (mdb_block_store, upgrade_v19_v20)
 	ASSERT_LT (19, store.version_get (transaction));
 }
 
+TEST (mdb_block_store, upgrade_v20_v21)
+{
+	if (nano::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (nano::unique_path ());
+	nano::genesis genesis;
+	nano::logger_mt logger;
+	nano::stat stats;
+	nano::keypair key1;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::send_block send (nano::genesis_hash, key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (nano::genesis_hash));
+	nano::state_block state_send (nano::dev_genesis_key.pub, send.hash (), nano::dev_genesis_key.pub, nano::genesis_amount - 2 * nano::Gxrb_ratio, key1.pub, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (send.hash ()));
+	nano::open_block open (send.hash (), key1.pub, key1.pub, key1.prv, key1.pub, *pool.generate (key1.pub));
+	nano::state_block state_receive (key1.pub, open.hash (), key1.pub, 2 * nano::Gxrb_ratio, state_send.hash (), key1.prv, key1.pub, *pool.generate (open.hash ()));
+	std::vector<nano::block const *> blocks_l{ genesis.open.get (), &send, &state_send, &open, &state_receive };
+	std::vector<std::shared_ptr<nano::block>> expected;
+	{
+		nano::mdb_store store (logger, path);
+		nano::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, state_send).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, state_receive).code);
+		for (auto block : blocks_l)
+		{
+			expected.push_back (store.block_get (transaction, block->hash ()));
+			write_block_w_sideband_v20 (store, transaction, *block);
+		}
+		store.version_put (transaction, 20);
+	}
+	nano::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	auto transaction (store.tx_begin_read ());
+	ASSERT_EQ (21, store.version_get (transaction));
+	ASSERT_EQ (blocks_l.size (), store.count (transaction, store.blocks));
+	for (auto const & block : expected)
+	{
+		// Entries are smaller than the fixed layout and decode to the same block and sideband
+		nano::mdb_val value;
+		ASSERT_FALSE (mdb_get (store.env.tx (transaction), store.blocks, nano::mdb_val (block->hash ()), value));
+		ASSERT_LT (value.size (), sizeof (nano::block_type) + nano::block::size (block->type ()) + nano::block_sideband::size (block->type ()));
+		auto upgraded (store.block_get (transaction, block->hash ()));
+		ASSERT_NE (nullptr, upgraded);
+		ASSERT_EQ (*block, *upgraded);
+		auto const & sideband (block->sideband ());
+		auto const & upgraded_sideband (upgraded->sideband ());
+		ASSERT_EQ (sideband.successor, upgraded_sideband.successor);
+		ASSERT_EQ (sideband.successor, store.block_successor (transaction, block->hash ()));
+		ASSERT_EQ (sideband.account, upgraded_sideband.account);
+		ASSERT_EQ (sideband.balance, upgraded_sideband.balance);
+		ASSERT_EQ (sideband.height, upgraded_sideband.height);
+		ASSERT_EQ (sideband.timestamp, upgraded_sideband.timestamp);
+		ASSERT_EQ (sideband.details, upgraded_sideband.details);
+		ASSERT_EQ (sideband.source_epoch, upgraded_sideband.source_epoch);
+	}
+}
+
 TEST (mdb_block_store, upgrade_backup)
 {
 	if (nano::using_rocksdb_in_tests ())
@@ -2070,6 +2431,112 @@ TEST (rocksdb_block_store, tombstone_count)
 }
 }
 
+TEST (rocksdb_block_store, upgrade_v20_v21_resume)
+{
+	if (nano::using_rocksdb_in_tests ())
+	{
+		auto path (nano::unique_path ());
+		nano::genesis genesis;
+		nano::logger_mt logger;
+		nano::stat stats;
+		nano::keypair key1;
+		nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+		nano::send_block send (nano::genesis_hash, key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (nano::genesis_hash));
+		nano::state_block state_send (nano::dev_genesis_key.pub, send.hash (), nano::dev_genesis_key.pub, nano::genesis_amount - 2 * nano::Gxrb_ratio, key1.pub, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (send.hash ()));
+		nano::open_block open (send.hash (), key1.pub, key1.pub, key1.prv, key1.pub, *pool.generate (key1.pub));
+		nano::state_block state_receive (key1.pub, open.hash (), key1.pub, 2 * nano::Gxrb_ratio, state_send.hash (), key1.prv, key1.pub, *pool.generate (open.hash ()));
+		std::vector<nano::block_hash> hashes{ genesis.hash (), send.hash (), state_send.hash (), open.hash (), state_receive.hash () };
+		// Blocks are upgraded in key order
+		std::sort (hashes.begin (), hashes.end (), [](nano::block_hash const & lhs, nano::block_hash const & rhs) { return lhs.number () < rhs.number (); });
+		std::vector<std::shared_ptr<nano::block>> expected;
+		{
+			nano::rocksdb_store store (logger, path);
+			nano::ledger ledger (store, stats);
+			auto transaction (store.tx_begin_write ());
+			store.initialize (transaction, genesis, ledger.cache);
+			ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send).code);
+			ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, state_send).code);
+			ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open).code);
+			ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, state_receive).code);
+			for (auto const & hash : hashes)
+			{
+				expected.push_back (store.block_get (transaction, hash));
+			}
+			// An upgrade of an unversioned ledger was interrupted after converting the first two blocks
+			for (size_t i (2); i < expected.size (); ++i)
+			{
+				write_block_w_sideband_v20 (store, transaction, *expected[i]);
+			}
+			ASSERT_FALSE (store.del (transaction, nano::tables::meta, nano::rocksdb_val (nano::uint256_union (1))));
+			ASSERT_FALSE (store.put (transaction, nano::tables::meta, nano::rocksdb_val (nano::uint256_union (2)), nano::rocksdb_val (hashes[2])));
+		}
+		{
+			// Only a writable open can complete the upgrade
+			nano::rocksdb_store store (logger, path, nano::rocksdb_config{}, true);
+			ASSERT_TRUE (store.init_error ());
+		}
+		nano::rocksdb_store store (logger, path);
+		ASSERT_FALSE (store.init_error ());
+		auto transaction (store.tx_begin_read ());
+		ASSERT_EQ (21, store.version_get (transaction));
+		ASSERT_FALSE (store.exists (transaction, nano::tables::meta, nano::rocksdb_val (nano::uint256_union (2))));
+		ASSERT_EQ (expected.size (), store.count (transaction, nano::tables::blocks));
+		for (auto const & block : expected)
+		{
+			auto upgraded (store.block_get (transaction, block->hash ()));
+			ASSERT_NE (nullptr, upgraded);
+			ASSERT_EQ (*block, *upgraded);
+			ASSERT_EQ (block->sideband ().successor, store.block_successor (transaction, block->hash ()));
+			ASSERT_EQ (block->sideband ().height, upgraded->sideband ().height);
+			ASSERT_EQ (block->sideband ().balance, upgraded->sideband ().balance);
+			ASSERT_EQ (block->sideband ().account, upgraded->sideband ().account);
+		}
+	}
+}
+
+TEST (rocksdb_block_store, read_only_unversioned)
+{
+	if (nano::using_rocksdb_in_tests ())
+	{
+		auto path (nano::unique_path ());
+		nano::genesis genesis;
+		nano::logger_mt logger;
+		nano::stat stats;
+		nano::keypair key1;
+		nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+		nano::send_block send (nano::genesis_hash, key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (nano::genesis_hash));
+		std::vector<std::shared_ptr<nano::block>> expected;
+		{
+			nano::rocksdb_store store (logger, path);
+			nano::ledger ledger (store, stats);
+			auto transaction (store.tx_begin_write ());
+			store.initialize (transaction, genesis, ledger.cache);
+			ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send).code);
+			expected.push_back (store.block_get (transaction, genesis.hash ()));
+			expected.push_back (store.block_get (transaction, send.hash ()));
+			for (auto const & block : expected)
+			{
+				write_block_w_sideband_v20 (store, transaction, *block);
+			}
+			ASSERT_FALSE (store.del (transaction, nano::tables::meta, nano::rocksdb_val (nano::uint256_union (1))));
+		}
+		// Read only opens do not upgrade, the blocks are read in the legacy format
+		nano::rocksdb_store store (logger, path, nano::rocksdb_config{}, true);
+		ASSERT_FALSE (store.init_error ());
+		auto transaction (store.tx_begin_read ());
+		ASSERT_EQ (store.minimum_version, store.version_get (transaction));
+		for (auto const & block : expected)
+		{
+			auto legacy (store.block_get (transaction, block->hash ()));
+			ASSERT_NE (nullptr, legacy);
+			ASSERT_EQ (*block, *legacy);
+			ASSERT_EQ (block->sideband ().successor, store.block_successor (transaction, block->hash ()));
+			ASSERT_EQ (block->sideband ().height, legacy->sideband ().height);
+			ASSERT_EQ (block->sideband ().balance, legacy->sideband ().balance);
+		}
+	}
+}
+
 namespace
 {
 void write_sideband_v14 (nano::mdb_store & store_a, nano::transaction & transaction_a, nano::block const & block_a, MDB_dbi db_a)
@@ -2127,6 +2594,34 @@ void write_block_w_sideband_v18 (nano::mdb_store & store_a, MDB_dbi database, na
 	store_a.del (transaction_a, nano::tables::blocks, nano::mdb_val (block_a.hash ()));
 }
 
+void write_block_w_sideband_v20 (nano::mdb_store & store_a, nano::write_transaction & transaction_a, nano::block const & block_a)
+{
+	auto block = store_a.block_get (transaction_a, block_a.hash ());
+	ASSERT_NE (block, nullptr);
+
+	std::vector<uint8_t> data;
+	{
+		nano::vectorstream stream (data);
+		nano::serialize_block (stream, *block);
+		block->sideband ().serialize (stream, block->type ());
+	}
+
+	MDB_val val{ data.size (), data.data () };
+	ASSERT_FALSE (mdb_put (store_a.env.tx (transaction_a), store_a.blocks, nano::mdb_val (block_a.hash ()), &val, 0));
+}
+
+void write_block_w_sideband_v20 (nano::rocksdb_store & store_a, nano::write_transaction & transaction_a, nano::block const & block_a)
+{
+	std::vector<uint8_t> data;
+	{
+		nano::vectorstream stream (data);
+		nano::serialize_block (stream, block_a);
+		block_a.sideband ().serialize (stream, block_a.type ());
+	}
+
+	ASSERT_FALSE (store_a.put (transaction_a, nano::tables::blocks, nano::rocksdb_val (block_a.hash ()), nano::rocksdb_val (data.size (), data.data ())));
+}
+
 void modify_account_info_to_v14 (nano::mdb_store & store, nano::transaction const & transaction, nano::account const & account, uint64_t confirmation_height, nano::block_hash const & rep_block)
 {
 	nano::account_info info;
@@ -13,3 +13,74 @@ TEST (election, construction)
 	auto election = node.active.insert (genesis.open).election;
 	election->transition_active ();
 }
+
+namespace nano
+{
+// Replacing a representative's vote moves its weight between the blocks of the running tally
+TEST (election, vote_replacement)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	// Keep the election open however the votes move
+	node_config.online_weight_minimum = std::numeric_limits<nano::uint128_t>::max ();
+	auto & node1 (*system.add_node (node_config));
+	nano::genesis genesis;
+	nano::keypair key1;
+	auto send1 (std::make_shared<nano::send_block> (genesis.hash (), key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	nano::keypair key2;
+	auto send2 (std::make_shared<nano::send_block> (genesis.hash (), key2.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	{
+		auto transaction (node1.store.tx_begin_write ());
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, *send1).code);
+	}
+	auto election1 = node1.active.insert (send1);
+	ASSERT_FALSE (node1.active.publish (send2));
+	auto weight (node1.ledger.weight (nano::dev_genesis_key.pub));
+	ASSERT_EQ (nano::vote_code::vote, node1.active.vote (std::make_shared<nano::vote> (key1.pub, key1.prv, 1, send2)));
+	ASSERT_EQ (nano::vote_code::vote, node1.active.vote (std::make_shared<nano::vote> (nano::dev_genesis_key.pub, nano::dev_genesis_key.prv, 1, send1)));
+	{
+		nano::lock_guard<std::mutex> guard (node1.active.mutex);
+		auto tally (election1.election->tally ());
+		ASSERT_EQ (2, tally.size ());
+		ASSERT_EQ (weight, tally.begin ()->first);
+		ASSERT_EQ (*send1, *tally.begin ()->second);
+		// Pretend the cooldown has passed
+		election1.election->last_votes[nano::dev_genesis_key.pub].time = std::chrono::steady_clock::now () - std::chrono::seconds (20);
+	}
+	ASSERT_EQ (nano::vote_code::vote, node1.active.vote (std::make_shared<nano::vote> (nano::dev_genesis_key.pub, nano::dev_genesis_key.prv, 2, send2)));
+	nano::lock_guard<std::mutex> guard (node1.active.mutex);
+	auto tally (election1.election->tally ());
+	ASSERT_EQ (2, tally.size ());
+	ASSERT_EQ (weight, tally.begin ()->first);
+	ASSERT_EQ (*send2, *tally.begin ()->second);
+	// Only the placeholder vote added by the constructor is left on the first block
+	ASSERT_EQ (0, tally.rbegin ()->first);
+	ASSERT_EQ (*send1, *tally.rbegin ()->second);
+	ASSERT_EQ (3, election1.election->last_votes.size ());
+}
+
+// Votes counted before their representative's weight changed are recounted with the new weight
+TEST (election, weight_refresh)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.online_weight_minimum = std::numeric_limits<nano::uint128_t>::max ();
+	auto & node1 (*system.add_node (node_config));
+	nano::genesis genesis;
+	nano::keypair key1;
+	auto send1 (std::make_shared<nano::send_block> (genesis.hash (), key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	{
+		auto transaction (node1.store.tx_begin_write ());
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, *send1).code);
+	}
+	auto election1 = node1.active.insert (send1);
+	ASSERT_EQ (nano::vote_code::vote, node1.active.vote (std::make_shared<nano::vote> (key1.pub, key1.prv, 1, send1)));
+	nano::lock_guard<std::mutex> guard (node1.active.mutex);
+	ASSERT_EQ (0, election1.election->tally ().begin ()->first);
+	ASSERT_FALSE (election1.election->refresh_weights ());
+	node1.ledger.cache.rep_weights.representation_add (key1.pub, nano::Gxrb_ratio);
+	ASSERT_TRUE (election1.election->refresh_weights ());
+	ASSERT_EQ (nano::Gxrb_ratio, election1.election->tally ().begin ()->first);
+	ASSERT_EQ (nano::Gxrb_ratio, election1.election->last_votes[key1.pub].weight);
+}
+}
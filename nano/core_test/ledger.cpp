@@ -637,6 +637,48 @@ TEST (ledger, representation_changes)
 	ASSERT_EQ (2, rep_weights.representation_get (key1.pub));
 }
 
+// Weights stay readable while writers insert enough representatives to replace the table several times
+TEST (ledger, representation_concurrent)
+{
+	nano::rep_weights rep_weights;
+	std::vector<nano::account> accounts (2000);
+	for (auto & account : accounts)
+	{
+		nano::random_pool::generate_block (account.bytes.data (), account.bytes.size ());
+	}
+	std::atomic<bool> stop{ false };
+	std::atomic<bool> torn{ false };
+	// Every amount written has equal high and low halves, a read racing a write would break this
+	nano::uint128_t const unit ((nano::uint128_t (1) << 64) + 1);
+	std::thread reader ([&]() {
+		while (!stop)
+		{
+			for (auto const & account : accounts)
+			{
+				if (rep_weights.representation_get (account) % unit != 0)
+				{
+					torn = true;
+				}
+			}
+		}
+	});
+	for (auto i (0); i < 3; ++i)
+	{
+		for (auto const & account : accounts)
+		{
+			rep_weights.representation_add (account, unit);
+		}
+	}
+	stop = true;
+	reader.join ();
+	ASSERT_FALSE (torn);
+	for (auto const & account : accounts)
+	{
+		ASSERT_EQ (unit * 3, rep_weights.representation_get (account));
+	}
+	ASSERT_EQ (accounts.size (), rep_weights.get_rep_amounts ().size ());
+}
+
 TEST (ledger, representation)
 {
 	nano::logger_mt logger;
@@ -3384,3 +3426,200 @@ TEST (ledger, cache)
 		cache_check (nano::ledger (*store, stats).cache);
 	}
 }
+
+TEST (ledger, pruning_action)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::stat stats;
+	nano::ledger ledger (*store, stats);
+	ledger.pruning = true;
+	nano::genesis genesis;
+	auto transaction (store->tx_begin_write ());
+	store->initialize (transaction, genesis, ledger.cache);
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::state_block send1 (nano::genesis_account, genesis.hash (), nano::genesis_account, nano::genesis_amount - nano::Gxrb_ratio, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (genesis.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send1).code);
+	nano::state_block send2 (nano::genesis_account, send1.hash (), nano::genesis_account, nano::genesis_amount - 2 * nano::Gxrb_ratio, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (send1.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send2).code);
+	store->confirmation_height_put (transaction, nano::genesis_account, { 3, send2.hash () });
+	// Genesis is never pruned
+	ASSERT_EQ (1, ledger.pruning_action (transaction, send1.hash (), 1));
+	ASSERT_FALSE (store->block_exists (transaction, send1.hash ()));
+	ASSERT_TRUE (store->pruned_exists (transaction, send1.hash ()));
+	ASSERT_TRUE (ledger.block_or_pruned_exists (transaction, send1.hash ()));
+	ASSERT_TRUE (ledger.block_confirmed (transaction, send1.hash ()));
+	ASSERT_TRUE (store->block_exists (transaction, genesis.hash ()));
+	ASSERT_TRUE (store->block_exists (transaction, send2.hash ()));
+	ASSERT_EQ (1, ledger.cache.pruned_count);
+	ASSERT_EQ (1, stats.count (nano::stat::type::pruning, nano::stat::detail::pruned_blocks, nano::stat::dir::in));
+	// Pruned blocks are still known to the ledger
+	ASSERT_EQ (nano::process_result::old, ledger.process (transaction, send1).code);
+	// Pending entries of pruned sends can be received
+	ASSERT_TRUE (store->pending_exists (transaction, nano::pending_key (nano::genesis_account, send1.hash ())));
+	nano::state_block receive1 (nano::genesis_account, send2.hash (), nano::genesis_account, nano::genesis_amount - nano::Gxrb_ratio, send1.hash (), nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (send2.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, receive1).code);
+	ASSERT_FALSE (store->pending_exists (transaction, nano::pending_key (nano::genesis_account, send1.hash ())));
+	// Rolling back the receive restores the pending entry without a source account
+	ASSERT_FALSE (ledger.rollback (transaction, receive1.hash ()));
+	nano::pending_info info;
+	ASSERT_FALSE (store->pending_get (transaction, nano::pending_key (nano::genesis_account, send1.hash ()), info));
+	ASSERT_TRUE (info.source.is_zero ());
+	ASSERT_EQ (nano::Gxrb_ratio, info.amount.number ());
+	// Pruning stops at already pruned blocks
+	ASSERT_EQ (1, ledger.pruning_action (transaction, send2.hash (), 1));
+	ASSERT_TRUE (store->pruned_exists (transaction, send2.hash ()));
+	ASSERT_EQ (2, ledger.cache.pruned_count);
+	// Balances and amounts depending on pruned blocks are reported as errors
+	bool error (false);
+	ASSERT_EQ (0, ledger.balance_safe (transaction, send2.hash (), error));
+	ASSERT_TRUE (error);
+	error = false;
+	ASSERT_EQ (nano::genesis_amount, ledger.balance_safe (transaction, genesis.hash (), error));
+	ASSERT_FALSE (error);
+}
+
+TEST (ledger, pruning_representative)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::stat stats;
+	nano::ledger ledger (*store, stats);
+	ledger.pruning = true;
+	nano::genesis genesis;
+	auto transaction (store->tx_begin_write ());
+	store->initialize (transaction, genesis, ledger.cache);
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::keypair key1;
+	nano::send_block send1 (genesis.hash (), key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (genesis.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send1).code);
+	nano::send_block send2 (send1.hash (), key1.pub, nano::genesis_amount - 2 * nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (send1.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send2).code);
+	store->confirmation_height_put (transaction, nano::genesis_account, { 3, send2.hash () });
+	ASSERT_EQ (genesis.hash (), ledger.representative (transaction, send2.hash ()));
+	ASSERT_EQ (1, ledger.pruning_action (transaction, send1.hash (), 1));
+	// The walk to the representative block stops at the pruned block
+	ASSERT_TRUE (ledger.representative (transaction, send2.hash ()).is_zero ());
+	bool error (false);
+	ASSERT_EQ (0, ledger.amount_safe (transaction, send2.hash (), error));
+	ASSERT_TRUE (error);
+}
+
+// Runs against both backends regardless of TEST_USE_ROCKSDB
+TEST (ledger, pruning_chain_batches)
+{
+	for (auto rocksdb_backend : { false, true })
+	{
+		nano::logger_mt logger;
+		auto store = nano::make_store (logger, nano::unique_path (), false, false, nano::rocksdb_config{}, nano::txn_tracking_config{}, std::chrono::milliseconds (5000), nano::lmdb_config{}, false, rocksdb_backend);
+		ASSERT_TRUE (!store->init_error ());
+		nano::stat stats;
+		nano::ledger ledger (*store, stats);
+		ledger.pruning = true;
+		nano::genesis genesis;
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+		nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+		std::vector<nano::block_hash> hashes;
+		nano::block_hash previous (genesis.hash ());
+		size_t const count (10);
+		for (size_t i (1); i <= count; ++i)
+		{
+			nano::state_block send (nano::genesis_account, previous, nano::genesis_account, nano::genesis_amount - i, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (previous));
+			ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send).code);
+			previous = send.hash ();
+			hashes.push_back (previous);
+		}
+		store->confirmation_height_put (transaction, nano::genesis_account, { count + 1, previous });
+		// Keep the frontier, the transaction is committed and renewed every 3 blocks
+		ASSERT_EQ (count - 1, ledger.pruning_action (transaction, hashes[count - 2], 3));
+		for (size_t i (0); i < count - 1; ++i)
+		{
+			ASSERT_TRUE (store->pruned_exists (transaction, hashes[i]));
+			ASSERT_FALSE (store->block_exists (transaction, hashes[i]));
+		}
+		ASSERT_TRUE (store->block_exists (transaction, previous));
+		ASSERT_TRUE (store->block_exists (transaction, genesis.hash ()));
+		ASSERT_EQ (count - 1, ledger.cache.pruned_count);
+	}
+}
+
+TEST (ledger, rep_weights_snapshot)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	auto snapshot (nano::unique_path ());
+	nano::genesis genesis;
+	nano::keypair key;
+	{
+		nano::stat stats;
+		nano::ledger ledger (*store, stats, nano::generate_cache (), nullptr, snapshot);
+		{
+			auto transaction (store->tx_begin_write ());
+			store->initialize (transaction, genesis, ledger.cache);
+			nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+			nano::state_block change (nano::genesis_account, genesis.hash (), key.pub, nano::genesis_amount, 0, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (genesis.hash ()));
+			ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, change).code);
+		}
+		ledger.rep_weights_snapshot_write ();
+	}
+	ASSERT_TRUE (boost::filesystem::exists (snapshot));
+	{
+		nano::stat stats;
+		nano::ledger ledger (*store, stats, nano::generate_cache (), nullptr, snapshot);
+		ASSERT_EQ (1, stats.count (nano::stat::type::ledger, nano::stat::detail::snapshot_loaded));
+		ASSERT_EQ (nano::genesis_amount, ledger.weight (key.pub));
+		ASSERT_EQ (0, ledger.weight (nano::genesis_account));
+		ASSERT_EQ (2, ledger.cache.block_count);
+		ASSERT_EQ (1, ledger.cache.account_count);
+		// The snapshot only describes the ledger as it was closed
+		ASSERT_FALSE (boost::filesystem::exists (snapshot));
+		ledger.rep_weights_snapshot_write ();
+	}
+	// A damaged snapshot is discarded in favour of scanning the accounts
+	boost::filesystem::resize_file (snapshot, boost::filesystem::file_size (snapshot) - 1);
+	{
+		nano::stat stats;
+		nano::ledger ledger (*store, stats, nano::generate_cache (), nullptr, snapshot);
+		ASSERT_EQ (1, stats.count (nano::stat::type::ledger, nano::stat::detail::snapshot_rejected));
+		ASSERT_EQ (nano::genesis_amount, ledger.weight (key.pub));
+		ASSERT_EQ (2, ledger.cache.block_count);
+		ASSERT_FALSE (boost::filesystem::exists (snapshot));
+		ledger.rep_weights_snapshot_write ();
+	}
+	// A snapshot is only accepted by the ledger it was written for
+	auto other_store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!other_store->init_error ());
+	{
+		auto transaction (other_store->tx_begin_write ());
+		nano::ledger_cache cache;
+		other_store->initialize (transaction, genesis, cache);
+	}
+	auto copy (nano::unique_path ());
+	boost::filesystem::copy_file (snapshot, copy);
+	auto stale (nano::unique_path ());
+	boost::filesystem::copy_file (snapshot, stale);
+	{
+		nano::stat stats;
+		nano::ledger ledger (*other_store, stats, nano::generate_cache (), nullptr, snapshot);
+		ASSERT_EQ (1, stats.count (nano::stat::type::ledger, nano::stat::detail::snapshot_rejected));
+		ASSERT_EQ (0, ledger.weight (key.pub));
+		ASSERT_EQ (1, ledger.cache.block_count);
+	}
+	// Opening the ledger clears its marker, a copy kept from before is stale
+	{
+		nano::stat stats;
+		nano::ledger ledger (*store, stats, nano::generate_cache (), nullptr, copy);
+		ASSERT_EQ (1, stats.count (nano::stat::type::ledger, nano::stat::detail::snapshot_loaded));
+		ASSERT_TRUE (store->rep_weights_marker_get (store->tx_begin_read ()).is_zero ());
+	}
+	{
+		nano::stat stats;
+		nano::ledger ledger (*store, stats, nano::generate_cache (), nullptr, stale);
+		ASSERT_EQ (1, stats.count (nano::stat::type::ledger, nano::stat::detail::snapshot_rejected));
+		ASSERT_EQ (nano::genesis_amount, ledger.weight (key.pub));
+	}
+}
@@ -12,9 +12,10 @@ public:
 	{
 		++keepalive_count;
 	}
-	void publish (nano::publish const &) override
+	void publish (nano::publish const & message_a) override
 	{
 		++publish_count;
+		publish_block = message_a.block;
 	}
 	void confirm_req (nano::confirm_req const &) override
 	{
@@ -57,6 +58,7 @@ public:
 	uint64_t publish_count{ 0 };
 	uint64_t confirm_req_count{ 0 };
 	uint64_t confirm_ack_count{ 0 };
+	std::shared_ptr<nano::block> publish_block;
 };
 }
 
@@ -160,6 +162,39 @@ TEST (message_parser, exact_confirm_req_hash_size)
 	ASSERT_NE (parser.status, nano::message_parser::parse_status::success);
 }
 
+TEST (message_parser, duplicate_confirm_ack)
+{
+	nano::system system (1);
+	dev_visitor visitor;
+	nano::network_filter filter (1);
+	nano::network_filter vote_filter (1);
+	nano::block_uniquer block_uniquer;
+	nano::vote_uniquer vote_uniquer (block_uniquer);
+	nano::message_parser parser (filter, block_uniquer, vote_uniquer, visitor, system.work, false, &vote_filter);
+	auto vote (std::make_shared<nano::vote> (nano::dev_genesis_key.pub, nano::dev_genesis_key.prv, 0, std::vector<nano::block_hash>{ nano::genesis_hash }));
+	auto bytes (nano::confirm_ack (vote).to_bytes (false));
+	parser.deserialize_buffer (bytes->data (), bytes->size ());
+	ASSERT_EQ (parser.status, nano::message_parser::parse_status::success);
+	ASSERT_EQ (1, visitor.confirm_ack_count);
+	// A repeated vote is dropped before deserialization
+	parser.deserialize_buffer (bytes->data (), bytes->size ());
+	ASSERT_EQ (parser.status, nano::message_parser::parse_status::duplicate_confirm_ack_message);
+	ASSERT_EQ (1, visitor.confirm_ack_count);
+	// The same vote from another sender is not a duplicate
+	nano::message_parser parser2 (filter, block_uniquer, vote_uniquer, visitor, system.work, false, &vote_filter, nano::endpoint (boost::asio::ip::address_v6::loopback (), 7000));
+	parser2.deserialize_buffer (bytes->data (), bytes->size ());
+	ASSERT_EQ (parser2.status, nano::message_parser::parse_status::success);
+	ASSERT_EQ (2, visitor.confirm_ack_count);
+	parser2.deserialize_buffer (bytes->data (), bytes->size ());
+	ASSERT_EQ (parser2.status, nano::message_parser::parse_status::duplicate_confirm_ack_message);
+	ASSERT_EQ (2, visitor.confirm_ack_count);
+	// Clearing the digest allows the vote through again
+	vote_filter.clear ();
+	parser2.deserialize_buffer (bytes->data (), bytes->size ());
+	ASSERT_EQ (parser2.status, nano::message_parser::parse_status::success);
+	ASSERT_EQ (3, visitor.confirm_ack_count);
+}
+
 TEST (message_parser, exact_publish_size)
 {
 	nano::system system (1);
@@ -193,6 +228,62 @@ TEST (message_parser, exact_publish_size)
 	ASSERT_NE (parser.status, nano::message_parser::parse_status::success);
 }
 
+TEST (message_parser, publish_view)
+{
+	nano::system system (1);
+	dev_visitor visitor;
+	nano::network_filter filter (1);
+	nano::block_uniquer block_uniquer;
+	nano::vote_uniquer vote_uniquer (block_uniquer);
+	nano::message_parser parser (filter, block_uniquer, vote_uniquer, visitor, system.work, false);
+	nano::keypair key;
+	auto block (std::make_shared<nano::state_block> (key.pub, 0, key.pub, 1, 2, key.prv, key.pub, *system.work.generate (key.pub)));
+	std::vector<uint8_t> block_bytes;
+	{
+		nano::vectorstream stream (block_bytes);
+		block->serialize (stream);
+	}
+	nano::block_view view (nano::block_type::state, block_bytes.data (), block_bytes.size ());
+	ASSERT_TRUE (view.valid ());
+	ASSERT_EQ (block->root (), view.root ());
+	ASSERT_EQ (block->block_work (), view.block_work ());
+	ASSERT_EQ (block->difficulty (), view.difficulty ());
+	ASSERT_EQ (block->hash (), view.hash ());
+	ASSERT_EQ (block->full_hash (), view.full_hash ());
+	ASSERT_FALSE (nano::block_view (nano::block_type::send, block_bytes.data (), block_bytes.size ()).valid ());
+	auto send (std::make_shared<nano::send_block> (1, 1, 2, key.prv, key.pub, *system.work.generate (nano::root (1))));
+	std::vector<uint8_t> send_bytes;
+	{
+		nano::vectorstream stream (send_bytes);
+		send->serialize (stream);
+	}
+	nano::block_view send_view (nano::block_type::send, send_bytes.data (), send_bytes.size ());
+	ASSERT_TRUE (send_view.valid ());
+	ASSERT_EQ (send->root (), send_view.root ());
+	ASSERT_EQ (send->block_work (), send_view.block_work ());
+	ASSERT_EQ (send->full_hash (), send_view.full_hash ());
+
+	// A block already held by the uniquer is handed to the visitor without deserializing a copy
+	ASSERT_EQ (block, block_uniquer.unique (block));
+	auto bytes (nano::publish (block).to_bytes (false));
+	parser.deserialize_buffer (bytes->data (), bytes->size ());
+	ASSERT_EQ (parser.status, nano::message_parser::parse_status::success);
+	ASSERT_EQ (1, visitor.publish_count);
+	ASSERT_EQ (block, visitor.publish_block);
+
+	// Insufficient work is rejected before deserialization
+	uint64_t work (0);
+	while (!nano::work_validate_entry (nano::work_version::work_1, key.pub, work))
+	{
+		++work;
+	}
+	auto block2 (std::make_shared<nano::state_block> (key.pub, 0, key.pub, 2, 2, key.prv, key.pub, work));
+	auto bytes2 (nano::publish (block2).to_bytes (false));
+	parser.deserialize_buffer (bytes2->data (), bytes2->size ());
+	ASSERT_EQ (parser.status, nano::message_parser::parse_status::insufficient_work);
+	ASSERT_EQ (1, visitor.publish_count);
+}
+
 TEST (message_parser, exact_keepalive_size)
 {
 	nano::system system (1);
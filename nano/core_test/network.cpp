@@ -959,6 +959,38 @@ TEST (network, bandwidth_limiter)
 	node.stop ();
 }
 
+TEST (network, outbound_scheduler)
+{
+	nano::transport::outbound_scheduler scheduler;
+	using decision = nano::transport::outbound_scheduler::decision;
+	auto const max (nano::socket::queue_size_max);
+	auto policy (nano::buffer_drop_policy::limiter);
+	// Lower priority classes stop being admitted at shallower write queue depths
+	ASSERT_EQ (decision::drop, scheduler.admit (nano::transport::traffic_class::keepalive, max / 4, policy));
+	ASSERT_EQ (decision::drop, scheduler.admit (nano::transport::traffic_class::publish, max / 2, policy));
+	ASSERT_EQ (decision::send, scheduler.admit (nano::transport::traffic_class::publish, max / 4, policy));
+	ASSERT_EQ (decision::send, scheduler.admit (nano::transport::traffic_class::vote, max - 1, policy));
+	ASSERT_EQ (decision::drop, scheduler.admit (nano::transport::traffic_class::vote, max, policy));
+	ASSERT_EQ (decision::send, scheduler.admit (nano::transport::traffic_class::publish, max, nano::buffer_drop_policy::no_socket_drop));
+	// A keepalive waiting in the queue makes another one redundant
+	ASSERT_EQ (decision::send, scheduler.admit (nano::transport::traffic_class::keepalive, 0, policy));
+	ASSERT_EQ (decision::coalesce, scheduler.admit (nano::transport::traffic_class::keepalive, 1, policy));
+	scheduler.complete (nano::transport::traffic_class::keepalive, 100, std::chrono::milliseconds (10), true);
+	ASSERT_EQ (decision::send, scheduler.admit (nano::transport::traffic_class::keepalive, 1, policy));
+	ASSERT_FALSE (scheduler.lagging ());
+	// Slow writes mark the peer as lagging, halving the queue for everything but votes
+	for (auto i (0); i < 32; ++i)
+	{
+		ASSERT_EQ (decision::send, scheduler.admit (nano::transport::traffic_class::publish, 0, policy));
+		scheduler.complete (nano::transport::traffic_class::publish, 1000, std::chrono::seconds (1), true);
+	}
+	ASSERT_TRUE (scheduler.lagging ());
+	ASSERT_GT (scheduler.latency (), nano::transport::outbound_scheduler::lagging_latency);
+	ASSERT_GT (scheduler.throughput (), 0);
+	ASSERT_EQ (decision::drop, scheduler.admit (nano::transport::traffic_class::publish, max / 4, policy));
+	ASSERT_EQ (decision::send, scheduler.admit (nano::transport::traffic_class::vote, max - 1, policy));
+}
+
 namespace nano
 {
 TEST (peer_exclusion, validate)
@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 TEST (network_filter, unit)
 {
 	nano::genesis genesis;
@@ -109,3 +111,59 @@ TEST (network_filter, optional_digest)
 	filter.clear (digest);
 	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
 }
+
+TEST (network_filter, concurrent)
+{
+	nano::network_filter filter (1);
+	std::vector<uint8_t> bytes1{ 1, 2, 3 };
+	std::atomic<unsigned> unique{ 0 };
+	std::vector<std::thread> threads;
+	for (auto i (0); i < 8; ++i)
+	{
+		threads.emplace_back ([&filter, &bytes1, &unique]() {
+			for (auto j (0); j < 1000; ++j)
+			{
+				unique += !filter.apply (bytes1.data (), bytes1.size ());
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	// Only a single apply can observe the digest as new
+	ASSERT_EQ (1, unique);
+	filter.clear (bytes1.data (), bytes1.size ());
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
+}
+
+TEST (network_filter, batch_hash)
+{
+	nano::network_filter filter (1);
+	// Sizes straddle the 8 byte blocks and the count is not a multiple of the SIMD lane count
+	std::vector<std::vector<uint8_t>> buffers;
+	for (size_t size (0); size < 301; ++size)
+	{
+		std::vector<uint8_t> buffer (size);
+		for (size_t i (0); i < size; ++i)
+		{
+			buffer[i] = static_cast<uint8_t> (size + i);
+		}
+		buffers.push_back (buffer);
+	}
+	std::vector<uint8_t const *> bytes;
+	std::vector<size_t> sizes;
+	for (auto const & buffer : buffers)
+	{
+		bytes.push_back (buffer.data ());
+		sizes.push_back (buffer.size ());
+	}
+	std::vector<nano::uint128_t> digests (buffers.size ());
+	filter.hash (bytes.data (), sizes.data (), bytes.size (), digests.data ());
+	for (size_t i (0); i < buffers.size (); ++i)
+	{
+		ASSERT_EQ (filter.hash (buffers[i].data (), buffers[i].size ()), digests[i]);
+	}
+	ASSERT_FALSE (filter.apply (digests[42]));
+	ASSERT_TRUE (filter.apply (buffers[42].data (), buffers[42].size ()));
+}
@@ -3351,6 +3351,242 @@ TEST (node, block_processor_half_full)
 	ASSERT_FALSE (node.block_processor.full ());
 }
 
+TEST (node, block_processor_full_bootstrap)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.block_processor_full_size = 4;
+	node_flags.force_use_write_database_queue = true;
+	auto & node = *system.add_node (nano::node_config (nano::get_available_port (), system.logging), node_flags);
+	nano::genesis genesis;
+	nano::keypair key;
+	nano::send_block_builder builder;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	auto previous (genesis.hash ());
+	for (auto i (0); i < 4; ++i)
+	{
+		auto send = builder.make_block ()
+		            .previous (previous)
+		            .destination (key.pub)
+		            .balance (nano::genesis_amount - i - 1)
+		            .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+		            .work (*system.work.generate (previous))
+		            .build_shared ();
+		previous = send->hash ();
+		blocks.push_back (send);
+	}
+	// The write guard prevents block processor doing any writes
+	auto write_guard = node.write_database_queue.wait (nano::writer::testing);
+	for (auto const & block : blocks)
+	{
+		node.block_processor.add (nano::unchecked_info (block, 0, nano::seconds_since_epoch (), nano::signature_verification::unknown), nano::block_source::bootstrap);
+	}
+	// A bootstrap backlog holds back bootstrap but does not drop live blocks
+	ASSERT_EQ (4, node.block_processor.size ());
+	ASSERT_TRUE (node.block_processor.half_full ());
+	ASSERT_FALSE (node.block_processor.full ());
+	write_guard.release ();
+	node.block_processor.flush ();
+	ASSERT_TRUE (node.ledger.block_exists (blocks[3]->hash ()));
+	ASSERT_FALSE (node.block_processor.half_full ());
+	ASSERT_FALSE (node.block_processor.full ());
+}
+
+TEST (node, block_processor_wallet_local)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	system.wallet (0)->insert_adhoc (nano::dev_genesis_key.prv);
+	nano::keypair key;
+	auto send (system.wallet (0)->send_action (nano::dev_genesis_key.pub, key.pub, 1));
+	ASSERT_NE (nullptr, send);
+	// Wallet blocks are committed through the local lane before the wallet continues
+	ASSERT_TRUE (node.ledger.block_exists (send->hash ()));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::local, nano::stat::dir::in));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::local, nano::stat::dir::out));
+}
+
+namespace nano
+{
+TEST (node, block_processor_lanes)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.block_processor_priority_live = 2;
+	node_config.block_processor_priority_bootstrap = 1;
+	auto & node = *system.add_node (node_config);
+	auto & block_processor (node.block_processor);
+	// Holding the mutex keeps the validation stage from taking blocks out of the lanes
+	nano::lock_guard<std::mutex> guard (block_processor.mutex);
+	auto now (std::chrono::steady_clock::now ());
+	for (auto i (0); i < 4; ++i)
+	{
+		block_processor.queue ({ nano::unchecked_info (), nano::block_source::bootstrap, now });
+	}
+	for (auto i (0); i < 3; ++i)
+	{
+		block_processor.queue ({ nano::unchecked_info (), nano::block_source::live, now });
+	}
+	block_processor.queue ({ nano::unchecked_info (), nano::block_source::unchecked, now });
+	std::vector<nano::block_source> order;
+	while (block_processor.have_queued ())
+	{
+		order.push_back (block_processor.next ().source);
+	}
+	std::vector<nano::block_source> expected{ nano::block_source::live, nano::block_source::live, nano::block_source::bootstrap, nano::block_source::unchecked, nano::block_source::live, nano::block_source::bootstrap, nano::block_source::bootstrap, nano::block_source::bootstrap };
+	ASSERT_EQ (expected, order);
+}
+
+TEST (node, block_processor_validate)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::genesis genesis;
+	nano::keypair key;
+	nano::send_block_builder builder;
+	auto send1 = builder.make_block ()
+	             .previous (genesis.hash ())
+	             .destination (key.pub)
+	             .balance (nano::genesis_amount - 1)
+	             .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+	             .work (*system.work.generate (genesis.hash ()))
+	             .build_shared ();
+	// Previous block is only part of the same batch
+	auto send2 = builder.make_block ()
+	             .previous (send1->hash ())
+	             .destination (key.pub)
+	             .balance (nano::genesis_amount - 2)
+	             .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+	             .work (*system.work.generate (send1->hash ()))
+	             .build_shared ();
+	auto invalid = builder.make_block ()
+	               .previous (send2->hash ())
+	               .destination (key.pub)
+	               .balance (nano::genesis_amount - 3)
+	               .sign (key.prv, key.pub)
+	               .work (*system.work.generate (send2->hash ()))
+	               .build_shared ();
+	nano::state_block_builder state_builder;
+	auto state = state_builder.make_block ()
+	             .account (nano::dev_genesis_key.pub)
+	             .previous (send2->hash ())
+	             .representative (nano::dev_genesis_key.pub)
+	             .balance (nano::genesis_amount - 3)
+	             .link (key.pub)
+	             .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+	             .work (*system.work.generate (send2->hash ()))
+	             .build_shared ();
+	auto no_work = builder.make_block ()
+	               .previous (send2->hash ())
+	               .destination (key.pub)
+	               .balance (nano::genesis_amount - 4)
+	               .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+	               .work (0)
+	               .build_shared ();
+	while (!nano::work_validate_entry (*no_work))
+	{
+		no_work->block_work_set (no_work->block_work () + 1);
+	}
+	auto now (std::chrono::steady_clock::now ());
+	std::deque<nano::block_processor_item> items;
+	for (auto const & block : { genesis.open, std::static_pointer_cast<nano::block> (send1), std::static_pointer_cast<nano::block> (send2), std::static_pointer_cast<nano::block> (invalid), std::static_pointer_cast<nano::block> (state), std::static_pointer_cast<nano::block> (no_work) })
+	{
+		items.push_back ({ nano::unchecked_info (block, 0, nano::seconds_since_epoch (), nano::signature_verification::unknown), nano::block_source::bootstrap, now });
+	}
+	node.block_processor.validate (items);
+	// Blocks below the entry work threshold are dropped
+	ASSERT_EQ (5, items.size ());
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::insufficient_work, nano::stat::dir::in));
+	// Already in the ledger
+	ASSERT_EQ (nano::signature_verification::unknown, items[0].info.verified);
+	ASSERT_EQ (nano::signature_verification::valid, items[1].info.verified);
+	ASSERT_EQ (nano::signature_verification::valid, items[2].info.verified);
+	// Invalid signatures are left for the ledger to reject
+	ASSERT_EQ (nano::signature_verification::unknown, items[3].info.verified);
+	ASSERT_EQ (nano::signature_verification::valid, items[4].info.verified);
+	ASSERT_EQ (3, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::validated, nano::stat::dir::in));
+	for (auto const & item : items)
+	{
+		node.block_processor.add (item.info, item.source);
+	}
+	node.block_processor.flush ();
+	ASSERT_TRUE (node.ledger.block_exists (send2->hash ()));
+	ASSERT_FALSE (node.ledger.block_exists (invalid->hash ()));
+	ASSERT_TRUE (node.ledger.block_exists (state->hash ()));
+}
+
+TEST (node, block_processor_validation_stage)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.force_use_write_database_queue = true;
+	auto & node = *system.add_node (node_flags);
+	nano::genesis genesis;
+	nano::keypair key;
+	nano::send_block_builder builder;
+	auto send = builder.make_block ()
+	            .previous (genesis.hash ())
+	            .destination (key.pub)
+	            .balance (nano::genesis_amount - 1)
+	            .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+	            .work (*system.work.generate (genesis.hash ()))
+	            .build_shared ();
+	// The write guard holds back the commit stage, validation runs regardless
+	auto write_guard = node.write_database_queue.wait (nano::writer::testing);
+	node.block_processor.add (send);
+	ASSERT_TIMELY (5s, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::validated, nano::stat::dir::in) == 1);
+	// Validated blocks waiting for the commit stage are still counted
+	ASSERT_EQ (1, node.block_processor.size ());
+	write_guard.release ();
+	node.block_processor.flush ();
+	ASSERT_TRUE (node.ledger.block_exists (send->hash ()));
+	ASSERT_EQ (0, node.block_processor.size ());
+}
+
+TEST (node, write_database_queue_group_commit)
+{
+	nano::system system;
+	std::atomic<unsigned> syncs{ 0 };
+	nano::write_database_queue write_database_queue (false, [&syncs]() { ++syncs; }, std::chrono::seconds (5));
+	auto write_guard1 = write_database_queue.wait (nano::writer::process_batch);
+	std::thread thread ([&write_database_queue]() {
+		auto write_guard2 = write_database_queue.wait (nano::writer::confirmation_height);
+	});
+	ASSERT_TIMELY (5s, write_database_queue.contains (nano::writer::confirmation_height));
+	// Both writers wait for the same flush
+	write_guard1.release ();
+	thread.join ();
+	ASSERT_EQ (1, syncs);
+	// Without queued writers the flush is immediate
+	write_database_queue.wait (nano::writer::testing).release ();
+	ASSERT_EQ (2, syncs);
+}
+}
+
+TEST (node, block_processor_local_lane)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::genesis genesis;
+	nano::state_block_builder builder;
+	auto send1 = builder.make_block ()
+	             .account (nano::dev_genesis_key.pub)
+	             .previous (genesis.hash ())
+	             .representative (nano::dev_genesis_key.pub)
+	             .balance (nano::genesis_amount - nano::Gxrb_ratio)
+	             .link (nano::dev_genesis_key.pub)
+	             .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+	             .work (*node.work_generate_blocking (genesis.hash ()))
+	             .build_shared ();
+	node.process_local_async (send1);
+	ASSERT_TIMELY (5s, node.ledger.block_exists (send1->hash ()));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::local, nano::stat::dir::in));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::local, nano::stat::dir::out));
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::live, nano::stat::dir::in));
+	// Local blocks start an election like blocks processed with process_local
+	ASSERT_TIMELY (5s, node.active.active (*send1));
+}
+
 TEST (node, confirm_back)
 {
 	nano::system system (1);
@@ -4438,16 +4674,106 @@ TEST (node, default_difficulty)
 	ASSERT_EQ (thresholds.epoch_2_receive, node.default_receive_difficulty (nano::work_version::work_1));
 }
 
+TEST (node, pruning_depth)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.max_pruning_depth = 1;
+	auto & node1 = *system.add_node (node_config);
+	// Pruning is triggered manually, the ongoing pruning task is only started with the enable_pruning flag
+	node1.ledger.pruning = true;
+	nano::genesis genesis;
+	nano::state_block send1 (nano::genesis_account, genesis.hash (), nano::genesis_account, nano::genesis_amount - nano::Gxrb_ratio, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (genesis.hash ()));
+	nano::state_block send2 (nano::genesis_account, send1.hash (), nano::genesis_account, nano::genesis_amount - 2 * nano::Gxrb_ratio, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (send1.hash ()));
+	{
+		auto transaction (node1.store.tx_begin_write ());
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, send1).code);
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, send2).code);
+		node1.store.confirmation_height_put (transaction, nano::genesis_account, { 3, send2.hash () });
+	}
+	node1.ledger_pruning (1, true, false);
+	ASSERT_EQ (1, node1.ledger.cache.pruned_count);
+	ASSERT_EQ (1, node1.stats.count (nano::stat::type::pruning, nano::stat::detail::pruning_targets));
+	ASSERT_EQ (1, node1.stats.count (nano::stat::type::pruning, nano::stat::detail::pruned_blocks, nano::stat::dir::in));
+	auto transaction (node1.store.tx_begin_read ());
+	ASSERT_TRUE (node1.store.pruned_exists (transaction, send1.hash ()));
+	ASSERT_TRUE (node1.store.block_exists (transaction, send2.hash ()));
+	ASSERT_TRUE (node1.store.block_exists (transaction, genesis.hash ()));
+}
+
+TEST (node, pruning_age)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	auto & node1 = *system.add_node (node_config);
+	node1.ledger.pruning = true;
+	nano::genesis genesis;
+	nano::state_block send1 (nano::genesis_account, genesis.hash (), nano::genesis_account, nano::genesis_amount - nano::Gxrb_ratio, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (genesis.hash ()));
+	nano::state_block send2 (nano::genesis_account, send1.hash (), nano::genesis_account, nano::genesis_amount - 2 * nano::Gxrb_ratio, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (send1.hash ()));
+	{
+		auto transaction (node1.store.tx_begin_write ());
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, send1).code);
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, send2).code);
+		node1.store.confirmation_height_put (transaction, nano::genesis_account, { 3, send2.hash () });
+	}
+	// Blocks are too recent
+	node1.ledger_pruning (1, true, false);
+	ASSERT_EQ (0, node1.ledger.cache.pruned_count);
+	// Without the age limit everything below the cemented frontier is pruned
+	node1.config.max_pruning_age = std::chrono::seconds (0);
+	node1.ledger_pruning (1, true, false);
+	ASSERT_EQ (1, node1.ledger.cache.pruned_count);
+	auto transaction (node1.store.tx_begin_read ());
+	ASSERT_TRUE (node1.store.pruned_exists (transaction, send1.hash ()));
+	ASSERT_TRUE (node1.store.block_exists (transaction, send2.hash ()));
+}
+
+TEST (node, pruning_keeps_representative)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.max_pruning_depth = 1;
+	node_config.max_pruning_age = std::chrono::seconds (0);
+	auto & node1 = *system.add_node (node_config);
+	node1.ledger.pruning = true;
+	nano::keypair key1;
+	nano::genesis genesis;
+	nano::send_block send1 (genesis.hash (), key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (genesis.hash ()));
+	nano::change_block change1 (send1.hash (), key1.pub, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (send1.hash ()));
+	nano::send_block send2 (change1.hash (), key1.pub, nano::genesis_amount - 2 * nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (change1.hash ()));
+	nano::send_block send3 (send2.hash (), key1.pub, nano::genesis_amount - 3 * nano::Gxrb_ratio, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *system.work.generate (send2.hash ()));
+	{
+		auto transaction (node1.store.tx_begin_write ());
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, send1).code);
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, change1).code);
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, send2).code);
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, send3).code);
+		node1.store.confirmation_height_put (transaction, nano::genesis_account, { 5, send3.hash () });
+	}
+	// The depth limit would only keep send3, but blocks up to the representative block of the frontier are kept
+	node1.ledger_pruning (1, true, false);
+	ASSERT_EQ (1, node1.ledger.cache.pruned_count);
+	auto transaction (node1.store.tx_begin_read ());
+	ASSERT_TRUE (node1.store.pruned_exists (transaction, send1.hash ()));
+	ASSERT_TRUE (node1.store.block_exists (transaction, change1.hash ()));
+	ASSERT_TRUE (node1.store.block_exists (transaction, send2.hash ()));
+	ASSERT_EQ (change1.hash (), node1.ledger.representative (transaction, send3.hash ()));
+	// The lowest kept block has no previous balance
+	bool error (false);
+	ASSERT_EQ (0, node1.ledger.amount_safe (transaction, change1.hash (), error));
+	ASSERT_TRUE (error);
+	error = false;
+	ASSERT_EQ (nano::Gxrb_ratio, node1.ledger.amount_safe (transaction, send3.hash (), error));
+	ASSERT_FALSE (error);
+}
+
 TEST (rep_crawler, recently_confirmed)
 {
 	nano::system system (1);
 	auto & node1 (*system.nodes[0]);
 	ASSERT_EQ (1, node1.ledger.cache.block_count);
 	auto const block = nano::genesis ().open;
-	{
-		nano::lock_guard<std::mutex> guard (node1.active.mutex);
-		node1.active.add_recently_confirmed (block->qualified_root (), block->hash ());
-	}
+	node1.active.add_recently_confirmed (block->qualified_root (), block->hash ());
 	auto & node2 (*system.add_node ());
 	system.wallet (1)->insert_adhoc (nano::dev_genesis_key.prv);
 	auto channel = node1.network.find_channel (node2.network.endpoint ());
@@ -1,3 +1,4 @@
+#include <nano/lib/stats.hpp>
 #include <nano/node/signatures.hpp>
 #include <nano/secure/common.hpp>
 
@@ -199,3 +200,158 @@ TEST (signature_checker, boundary_checks)
 		last_size = size;
 	}
 }
+
+TEST (signature_checker, validate_message_batch)
+{
+	size_t const size (100);
+	std::vector<nano::keypair> keys (size);
+	std::vector<nano::uint256_union> hashes;
+	std::vector<nano::signature> signatures_l;
+	for (size_t i (0); i < size; ++i)
+	{
+		hashes.emplace_back (i);
+		signatures_l.push_back (nano::sign_message (keys[i].prv, keys[i].pub, hashes.back ()));
+	}
+	signatures_l[10].bytes[31] ^= 0x1;
+	signatures_l[90].bytes[0] ^= 0x1;
+	// Adding 8 * L to S keeps S mod L, a signature with a non canonical S is still rejected
+	std::array<uint8_t, 32> const order_times_8{ 0x68, 0x9f, 0xae, 0xe7, 0xd2, 0x18, 0x93, 0xc0, 0xb2, 0xe6, 0xbc, 0x17, 0xf5, 0xce, 0xf7, 0xa6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x80 };
+	unsigned carry (0);
+	for (size_t i (0); i < order_times_8.size (); ++i)
+	{
+		auto sum (signatures_l[50].bytes[32 + i] + order_times_8[i] + carry);
+		signatures_l[50].bytes[32 + i] = static_cast<uint8_t> (sum);
+		carry = sum >> 8;
+	}
+	ASSERT_EQ (0, carry);
+	std::vector<unsigned char const *> messages;
+	std::vector<size_t> lengths (size, sizeof (nano::uint256_union));
+	std::vector<unsigned char const *> pub_keys;
+	std::vector<unsigned char const *> signatures;
+	for (size_t i (0); i < size; ++i)
+	{
+		messages.push_back (hashes[i].bytes.data ());
+		pub_keys.push_back (keys[i].pub.bytes.data ());
+		signatures.push_back (signatures_l[i].bytes.data ());
+	}
+	std::vector<int> verifications (size, -1);
+	nano::validate_message_batch (messages.data (), lengths.data (), pub_keys.data (), signatures.data (), size, verifications.data ());
+	for (size_t i (0); i < size; ++i)
+	{
+		ASSERT_EQ (i == 10 || i == 50 || i == 90 ? 0 : 1, verifications[i]) << i;
+	}
+}
+
+TEST (signature_checker, adaptive_batch_size)
+{
+	nano::signature_checker checker (3);
+	// Small sets still get a full ed25519 batch
+	ASSERT_EQ (nano::signature_checker::batch_size_min, checker.batch_size_for (1));
+	// Large sets are spread over the 4 threads, in multiples of the smallest batch and never above the largest
+	ASSERT_EQ (128, checker.batch_size_for (4 * 128 + 3));
+	ASSERT_EQ (nano::signature_checker::batch_size, checker.batch_size_for (100000));
+}
+
+TEST (signature_pipeline, mixed_sources)
+{
+	nano::signature_checker checker (1);
+	nano::stat stats;
+	nano::signature_pipeline pipeline (checker, stats, 256);
+	// Signature sets from several producers, each with one invalid signature at a different position
+	std::array<size_t, 3> const sizes{ 20, 300, 1 };
+	std::array<size_t, 3> const invalid{ 3, 299, 0 };
+	std::array<std::vector<nano::keypair>, 3> keys;
+	std::array<std::vector<nano::uint256_union>, 3> hashes;
+	std::array<std::vector<nano::signature>, 3> signatures_l;
+	std::array<std::vector<unsigned char const *>, 3> messages;
+	std::array<std::vector<size_t>, 3> lengths;
+	std::array<std::vector<unsigned char const *>, 3> pub_keys;
+	std::array<std::vector<unsigned char const *>, 3> signatures;
+	std::array<std::vector<int>, 3> verifications;
+	std::vector<nano::signature_check_set> checks;
+	for (size_t i (0); i < sizes.size (); ++i)
+	{
+		keys[i].resize (sizes[i]);
+		for (size_t j (0); j < sizes[i]; ++j)
+		{
+			hashes[i].emplace_back (i * 1000 + j);
+			signatures_l[i].push_back (nano::sign_message (keys[i][j].prv, keys[i][j].pub, hashes[i].back ()));
+		}
+		signatures_l[i][invalid[i]].bytes[31] ^= 0x1;
+		for (size_t j (0); j < sizes[i]; ++j)
+		{
+			messages[i].push_back (hashes[i][j].bytes.data ());
+			lengths[i].push_back (sizeof (nano::uint256_union));
+			pub_keys[i].push_back (keys[i][j].pub.bytes.data ());
+			signatures[i].push_back (signatures_l[i][j].bytes.data ());
+		}
+		verifications[i].resize (sizes[i], -1);
+		checks.push_back ({ sizes[i], messages[i].data (), lengths[i].data (), pub_keys[i].data (), signatures[i].data (), verifications[i].data () });
+	}
+	std::promise<void> vote_done;
+	std::promise<void> block_done;
+	pipeline.add (checks[1], nano::signature_source::block, [&block_done]() { block_done.set_value (); });
+	pipeline.add (checks[0], nano::signature_source::vote, [&vote_done]() { vote_done.set_value (); });
+	pipeline.verify (checks[2], nano::signature_source::vote);
+	ASSERT_EQ (std::future_status::ready, vote_done.get_future ().wait_for (std::chrono::seconds (10)));
+	ASSERT_EQ (std::future_status::ready, block_done.get_future ().wait_for (std::chrono::seconds (10)));
+	ASSERT_EQ (0, pipeline.size ());
+	for (size_t i (0); i < sizes.size (); ++i)
+	{
+		for (size_t j (0); j < sizes[i]; ++j)
+		{
+			ASSERT_EQ (j == invalid[i] ? 0 : 1, verifications[i][j]) << i << " " << j;
+		}
+	}
+	// Sets added after stopping are verified on the caller's thread
+	pipeline.stop ();
+	std::fill (verifications[0].begin (), verifications[0].end (), -1);
+	pipeline.verify (checks[0], nano::signature_source::vote);
+	ASSERT_EQ (0, verifications[0][invalid[0]]);
+	ASSERT_EQ (1, verifications[0][invalid[0] + 1]);
+}
+
+TEST (signature_pipeline, cache)
+{
+	nano::signature_checker checker (0);
+	nano::stat stats;
+	nano::signature_pipeline pipeline (checker, stats, 256);
+	size_t const size (10);
+	std::vector<nano::keypair> keys (size);
+	std::vector<nano::uint256_union> hashes;
+	std::vector<nano::signature> signatures_l;
+	for (size_t i (0); i < size; ++i)
+	{
+		hashes.emplace_back (i);
+		signatures_l.push_back (nano::sign_message (keys[i].prv, keys[i].pub, hashes.back ()));
+	}
+	signatures_l[4].bytes[31] ^= 0x1;
+	std::vector<unsigned char const *> messages;
+	std::vector<size_t> lengths (size, sizeof (nano::uint256_union));
+	std::vector<unsigned char const *> pub_keys;
+	std::vector<unsigned char const *> signatures;
+	for (size_t i (0); i < size; ++i)
+	{
+		messages.push_back (hashes[i].bytes.data ());
+		pub_keys.push_back (keys[i].pub.bytes.data ());
+		signatures.push_back (signatures_l[i].bytes.data ());
+	}
+	std::vector<int> verifications (size, -1);
+	nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
+	pipeline.verify (check, nano::signature_source::block);
+	ASSERT_EQ (0, stats.count (nano::stat::type::signature_cache, nano::stat::detail::hit, nano::stat::dir::in));
+	ASSERT_EQ (size, stats.count (nano::stat::type::signature_cache, nano::stat::detail::miss, nano::stat::dir::in));
+	// The same entries arriving again, as a vote set this time, only the invalid signature is verified again
+	std::fill (verifications.begin (), verifications.end (), -1);
+	pipeline.verify (check, nano::signature_source::vote);
+	ASSERT_EQ (size - 1, stats.count (nano::stat::type::signature_cache, nano::stat::detail::hit, nano::stat::dir::in));
+	ASSERT_EQ (size + 1, stats.count (nano::stat::type::signature_cache, nano::stat::detail::miss, nano::stat::dir::in));
+	for (size_t i (0); i < size; ++i)
+	{
+		ASSERT_EQ (i == 4 ? 0 : 1, verifications[i]) << i;
+	}
+	// A valid signature under another key is not mistaken for a cached one
+	pub_keys[0] = keys[1].pub.bytes.data ();
+	pipeline.verify (check, nano::signature_source::vote);
+	ASSERT_EQ (0, verifications[0]);
+}
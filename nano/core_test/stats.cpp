@@ -0,0 +1,59 @@
+#include <nano/lib/stats.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST (stats, counters_concurrent)
+{
+	nano::stat stats;
+	std::vector<std::thread> threads;
+	auto constexpr thread_count = 8;
+	auto constexpr per_thread = 10000;
+	for (auto i (0); i < thread_count; ++i)
+	{
+		threads.emplace_back ([&stats] {
+			for (auto j (0); j < per_thread; ++j)
+			{
+				stats.inc (nano::stat::type::vote, nano::stat::detail::vote_valid);
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	ASSERT_EQ (thread_count * per_thread, stats.count (nano::stat::type::vote, nano::stat::detail::vote_valid));
+	ASSERT_EQ (thread_count * per_thread, stats.count (nano::stat::type::vote));
+	ASSERT_EQ (0, stats.count (nano::stat::type::vote, nano::stat::detail::vote_valid, nano::stat::dir::out));
+}
+
+TEST (stats, observer_after_fast_path)
+{
+	nano::stat stats;
+	stats.inc (nano::stat::type::ledger, nano::stat::detail::send);
+	stats.inc (nano::stat::type::ledger, nano::stat::detail::send);
+	uint64_t old_value (0);
+	uint64_t new_value (0);
+	stats.observe_count (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in, [&old_value, &new_value](uint64_t old_a, uint64_t new_a) {
+		old_value = old_a;
+		new_value = new_a;
+	});
+	stats.add (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in, 3);
+	ASSERT_EQ (2, old_value);
+	ASSERT_EQ (5, new_value);
+	ASSERT_EQ (5, stats.count (nano::stat::type::ledger, nano::stat::detail::send));
+}
+
+TEST (stats, clear)
+{
+	nano::stat stats;
+	stats.inc (nano::stat::type::block, nano::stat::detail::open);
+	stats.inc (nano::stat::type::block, nano::stat::detail::open);
+	ASSERT_EQ (2, stats.count (nano::stat::type::block, nano::stat::detail::open));
+	stats.clear ();
+	ASSERT_EQ (0, stats.count (nano::stat::type::block, nano::stat::detail::open));
+	stats.inc (nano::stat::type::block, nano::stat::detail::open);
+	ASSERT_EQ (1, stats.count (nano::stat::type::block, nano::stat::detail::open));
+}
@@ -146,11 +146,13 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.rpc.child_process.enable, defaults.rpc.child_process.enable);
 	ASSERT_EQ (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
 
+	ASSERT_EQ (conf.node.account_cache_max, defaults.node.account_cache_max);
 	ASSERT_EQ (conf.node.active_elections_size, defaults.node.active_elections_size);
 	ASSERT_EQ (conf.node.allow_local_peers, defaults.node.allow_local_peers);
 	ASSERT_EQ (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_EQ (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
 	ASSERT_EQ (conf.node.bandwidth_limit_burst_ratio, defaults.node.bandwidth_limit_burst_ratio);
+	ASSERT_EQ (conf.node.block_cache_max, defaults.node.block_cache_max);
 	ASSERT_EQ (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_EQ (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
 	ASSERT_EQ (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
@@ -166,6 +168,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_EQ (conf.node.network_threads, defaults.node.network_threads);
 	ASSERT_EQ (conf.node.secondary_work_peers, defaults.node.secondary_work_peers);
+	ASSERT_EQ (conf.node.max_pruning_age, defaults.node.max_pruning_age);
+	ASSERT_EQ (conf.node.max_pruning_depth, defaults.node.max_pruning_depth);
 	ASSERT_EQ (conf.node.work_watcher_period, defaults.node.work_watcher_period);
 	ASSERT_EQ (conf.node.online_weight_minimum, defaults.node.online_weight_minimum);
 	ASSERT_EQ (conf.node.online_weight_quorum, defaults.node.online_weight_quorum);
@@ -177,16 +181,23 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.preconfigured_representatives, defaults.node.preconfigured_representatives);
 	ASSERT_EQ (conf.node.receive_minimum, defaults.node.receive_minimum);
 	ASSERT_EQ (conf.node.signature_checker_threads, defaults.node.signature_checker_threads);
+	ASSERT_EQ (conf.node.vote_processor_threads, defaults.node.vote_processor_threads);
 	ASSERT_EQ (conf.node.tcp_incoming_connections_max, defaults.node.tcp_incoming_connections_max);
 	ASSERT_EQ (conf.node.tcp_io_timeout, defaults.node.tcp_io_timeout);
 	ASSERT_EQ (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
+	ASSERT_EQ (conf.node.unchecked_memory_max, defaults.node.unchecked_memory_max);
 	ASSERT_EQ (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_EQ (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
 	ASSERT_EQ (conf.node.vote_generator_threshold, defaults.node.vote_generator_threshold);
+	ASSERT_EQ (conf.node.vote_generator_coalesce_delay, defaults.node.vote_generator_coalesce_delay);
 	ASSERT_EQ (conf.node.vote_minimum, defaults.node.vote_minimum);
 	ASSERT_EQ (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_EQ (conf.node.work_threads, defaults.node.work_threads);
 	ASSERT_EQ (conf.node.max_queued_requests, defaults.node.max_queued_requests);
+	ASSERT_EQ (conf.node.block_processor_priority_local, defaults.node.block_processor_priority_local);
+	ASSERT_EQ (conf.node.block_processor_priority_live, defaults.node.block_processor_priority_live);
+	ASSERT_EQ (conf.node.block_processor_priority_unchecked, defaults.node.block_processor_priority_unchecked);
+	ASSERT_EQ (conf.node.block_processor_priority_bootstrap, defaults.node.block_processor_priority_bootstrap);
 
 	ASSERT_EQ (conf.node.logging.bulk_pull_logging_value, defaults.node.logging.bulk_pull_logging_value);
 	ASSERT_EQ (conf.node.logging.flush, defaults.node.logging.flush);
@@ -252,6 +263,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.stat_config.log_samples_filename, defaults.node.stat_config.log_samples_filename);
 
 	ASSERT_EQ (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
+	ASSERT_EQ (conf.node.lmdb_config.group_commit_max_latency, defaults.node.lmdb_config.group_commit_max_latency);
 	ASSERT_EQ (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_EQ (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
 
@@ -385,11 +397,13 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 
 	ss << R"toml(
 	[node]
+	account_cache_max = 999
 	active_elections_size = 999
 	allow_local_peers = false
 	backup_before_upgrade = true
 	bandwidth_limit = 999
 	bandwidth_limit_burst_ratio = 999.9
+	block_cache_max = 999
 	block_processor_batch_max_time = 999
 	bootstrap_connections = 999
 	bootstrap_connections_max = 999
@@ -413,18 +427,25 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	preconfigured_representatives = ["nano_3arg3asgtigae3xckabaaewkx3bzsh7nwz7jkmjos79ihyaxwphhm6qgjps4"]
 	receive_minimum = "999"
 	signature_checker_threads = 999
+	vote_processor_threads = 999
 	tcp_incoming_connections_max = 999
 	tcp_io_timeout = 999
 	unchecked_cutoff_time = 999
+	unchecked_memory_max = 999
 	use_memory_pools = false
 	vote_generator_delay = 999
 	vote_generator_threshold = 9
+	vote_generator_coalesce_delay = 999
 	vote_minimum = "999"
 	work_peers = ["dev.org:999"]
 	work_threads = 999
 	work_watcher_period = 999
 	max_work_generate_multiplier = 1.0
 	max_queued_requests = 999
+	block_processor_priority_local = 999
+	block_processor_priority_live = 999
+	block_processor_priority_unchecked = 999
+	block_processor_priority_bootstrap = 999
 	frontiers_confirmation = "always"
 	[node.diagnostics.txn_tracking]
 	enable = true
@@ -503,6 +524,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 
 	[node.lmdb]
 	sync = "nosync_safe"
+	group_commit_max_latency = 999
 	max_databases = 999
 	map_size = 999
 
@@ -513,6 +535,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 
 	[node.experimental]
 	secondary_work_peers = ["dev.org:998"]
+	max_pruning_age = 999
+	max_pruning_depth = 999
 
 	[opencl]
 	device = 999
@@ -546,11 +570,13 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.rpc.child_process.enable, defaults.rpc.child_process.enable);
 	ASSERT_NE (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
 
+	ASSERT_NE (conf.node.account_cache_max, defaults.node.account_cache_max);
 	ASSERT_NE (conf.node.active_elections_size, defaults.node.active_elections_size);
 	ASSERT_NE (conf.node.allow_local_peers, defaults.node.allow_local_peers);
 	ASSERT_NE (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_NE (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
 	ASSERT_NE (conf.node.bandwidth_limit_burst_ratio, defaults.node.bandwidth_limit_burst_ratio);
+	ASSERT_NE (conf.node.block_cache_max, defaults.node.block_cache_max);
 	ASSERT_NE (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_NE (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
 	ASSERT_NE (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
@@ -567,6 +593,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.frontiers_confirmation, defaults.node.frontiers_confirmation);
 	ASSERT_NE (conf.node.network_threads, defaults.node.network_threads);
 	ASSERT_NE (conf.node.secondary_work_peers, defaults.node.secondary_work_peers);
+	ASSERT_NE (conf.node.max_pruning_age, defaults.node.max_pruning_age);
+	ASSERT_NE (conf.node.max_pruning_depth, defaults.node.max_pruning_depth);
 	ASSERT_NE (conf.node.work_watcher_period, defaults.node.work_watcher_period);
 	ASSERT_NE (conf.node.online_weight_minimum, defaults.node.online_weight_minimum);
 	ASSERT_NE (conf.node.online_weight_quorum, defaults.node.online_weight_quorum);
@@ -578,16 +606,23 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.preconfigured_representatives, defaults.node.preconfigured_representatives);
 	ASSERT_NE (conf.node.receive_minimum, defaults.node.receive_minimum);
 	ASSERT_NE (conf.node.signature_checker_threads, defaults.node.signature_checker_threads);
+	ASSERT_NE (conf.node.vote_processor_threads, defaults.node.vote_processor_threads);
 	ASSERT_NE (conf.node.tcp_incoming_connections_max, defaults.node.tcp_incoming_connections_max);
 	ASSERT_NE (conf.node.tcp_io_timeout, defaults.node.tcp_io_timeout);
 	ASSERT_NE (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
+	ASSERT_NE (conf.node.unchecked_memory_max, defaults.node.unchecked_memory_max);
 	ASSERT_NE (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_NE (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
 	ASSERT_NE (conf.node.vote_generator_threshold, defaults.node.vote_generator_threshold);
+	ASSERT_NE (conf.node.vote_generator_coalesce_delay, defaults.node.vote_generator_coalesce_delay);
 	ASSERT_NE (conf.node.vote_minimum, defaults.node.vote_minimum);
 	ASSERT_NE (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_NE (conf.node.work_threads, defaults.node.work_threads);
 	ASSERT_NE (conf.node.max_queued_requests, defaults.node.max_queued_requests);
+	ASSERT_NE (conf.node.block_processor_priority_local, defaults.node.block_processor_priority_local);
+	ASSERT_NE (conf.node.block_processor_priority_live, defaults.node.block_processor_priority_live);
+	ASSERT_NE (conf.node.block_processor_priority_unchecked, defaults.node.block_processor_priority_unchecked);
+	ASSERT_NE (conf.node.block_processor_priority_bootstrap, defaults.node.block_processor_priority_bootstrap);
 
 	ASSERT_NE (conf.node.logging.bulk_pull_logging_value, defaults.node.logging.bulk_pull_logging_value);
 	ASSERT_NE (conf.node.logging.flush, defaults.node.logging.flush);
@@ -653,6 +688,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.stat_config.log_samples_filename, defaults.node.stat_config.log_samples_filename);
 
 	ASSERT_NE (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
+	ASSERT_NE (conf.node.lmdb_config.group_commit_max_latency, defaults.node.lmdb_config.group_commit_max_latency);
 	ASSERT_NE (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_NE (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
 
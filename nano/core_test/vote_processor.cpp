@@ -89,6 +89,39 @@ TEST (vote_processor, invalid_signature)
 	ASSERT_EQ (2, election.election->votes ().size ());
 }
 
+TEST (vote_processor, threads)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.vote_processor_threads = 4;
+	auto & node (*system.add_node (node_config));
+	nano::genesis genesis;
+	genesis.open->sideband_set (nano::block_sideband (nano::genesis_account, 0, nano::genesis_amount, 1, nano::seconds_since_epoch (), nano::epoch::epoch_0, false, false, false, nano::epoch::epoch_0));
+	auto election (node.active.insert (genesis.open));
+	ASSERT_TRUE (election.election && election.inserted);
+	auto channel (std::make_shared<nano::transport::channel_udp> (node.network.udp_channels, node.network.endpoint (), node.network_params.protocol.protocol_version));
+	// Representatives are spread over all shards, the votes of each must still be processed in order:
+	// the highest sequence is sent first so the other two are replays
+	std::vector<nano::keypair> keys (16);
+	for (auto const & key : keys)
+	{
+		for (uint64_t sequence (3); sequence > 0; --sequence)
+		{
+			ASSERT_FALSE (node.vote_processor.vote (std::make_shared<nano::vote> (key.pub, key.prv, sequence, std::vector<nano::block_hash>{ genesis.open->hash () }), channel));
+		}
+	}
+	node.vote_processor.flush ();
+	ASSERT_TRUE (node.vote_processor.empty ());
+	auto votes (election.election->votes ());
+	ASSERT_EQ (keys.size () + 1, votes.size ());
+	for (auto const & key : keys)
+	{
+		ASSERT_EQ (3, votes[key.pub].sequence);
+	}
+	ASSERT_EQ (keys.size (), node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_valid));
+	ASSERT_EQ (2 * keys.size (), node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_replay));
+}
+
 TEST (vote_processor, no_capacity)
 {
 	nano::system system;
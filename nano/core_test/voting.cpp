@@ -103,6 +103,26 @@ TEST (vote_generator, multiple_representatives)
 	}
 }
 
+TEST (vote_generator, coalesce)
+{
+	nano::system system;
+	nano::node_config config (nano::get_available_port (), system.logging);
+	config.vote_generator_coalesce_delay = 500ms;
+	auto & node (*system.add_node (config));
+	system.wallet (0)->insert_adhoc (nano::dev_genesis_key.prv);
+	nano::genesis genesis;
+	auto channel1 (std::make_shared<nano::transport::channel_udp> (node.network.udp_channels, node.network.endpoint (), node.network_params.protocol.protocol_version));
+	auto channel2 (std::make_shared<nano::transport::channel_udp> (node.network.udp_channels, node.network.endpoint (), node.network_params.protocol.protocol_version));
+	std::vector<std::shared_ptr<nano::block>> blocks{ genesis.open };
+	ASSERT_EQ (1, node.active.generator.generate (blocks, channel1));
+	ASSERT_EQ (1, node.active.generator.generate (blocks, channel2));
+	// Both requests are answered with a single vote
+	ASSERT_TIMELY (5s, 2 == node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes, nano::stat::dir::in));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_packed_votes, nano::stat::dir::in));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_packed_hashes, nano::stat::dir::in));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_coalesced_requests, nano::stat::dir::in));
+}
+
 TEST (vote_generator, session)
 {
 	nano::system system (1);
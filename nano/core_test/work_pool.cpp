@@ -4,6 +4,7 @@
 #include <nano/lib/logger_mt.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/lib/work.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/node/logging.hpp>
 #include <nano/node/openclconfig.hpp>
 #include <nano/node/openclwork.hpp>
@@ -41,6 +42,31 @@ TEST (work, validate)
 	ASSERT_LT (nano::work_threshold_base (send_block.work_version ()), send_block.difficulty ());
 }
 
+TEST (work, kernels)
+{
+	ASSERT_FALSE (nano::work_kernels ().empty ());
+	ASSERT_EQ ("scalar", nano::work_kernels ().front ().name);
+	for (auto const & kernel : nano::work_kernels ())
+	{
+		ASSERT_LE (kernel.lanes, nano::work_kernel::max_lanes);
+		for (auto i (0); i < 64; ++i)
+		{
+			nano::root root;
+			nano::random_pool::generate_block (root.bytes.data (), root.bytes.size ());
+			std::array<uint64_t, nano::work_kernel::max_lanes> nonces;
+			nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (nonces.data ()), nonces.size () * sizeof (uint64_t));
+			std::array<uint64_t, nano::work_kernel::max_lanes> outputs{};
+			kernel.compute (root, nonces.data (), outputs.data ());
+			for (size_t lane (0); lane < kernel.lanes; ++lane)
+			{
+				ASSERT_EQ (nano::work_v1::value (root, nonces[lane]), outputs[lane]) << kernel.name << " lane " << lane;
+			}
+		}
+	}
+	nano::work_pool pool (1);
+	ASSERT_EQ (&nano::work_kernel_best (), &pool.kernel);
+}
+
 TEST (work, cancel)
 {
 	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
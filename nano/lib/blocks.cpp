@@ -33,7 +33,37 @@ std::shared_ptr<block> deserialize_block (nano::stream & stream_a)
 
 	return result;
 }
+
+/** Writes \p value_a 7 bits at a time, least significant group first, the high bit marks that another group follows */
+void write_varint (nano::stream & stream_a, uint64_t value_a)
+{
+	while (value_a >= 0x80)
+	{
+		nano::write (stream_a, static_cast<uint8_t> (value_a | 0x80));
+		value_a >>= 7;
+	}
+	nano::write (stream_a, static_cast<uint8_t> (value_a));
+}
+
+/** Throws std::runtime_error if the stream ends early or the value does not fit in 64 bits */
+uint64_t read_varint (nano::stream & stream_a)
+{
+	uint64_t result (0);
+	uint8_t byte (0x80);
+	for (unsigned shift (0); (byte & 0x80) != 0; shift += 7)
+	{
+		if (shift >= 64)
+		{
+			throw std::runtime_error ("Variable length integer is too long");
+		}
+		nano::read (stream_a, byte);
+		result |= static_cast<uint64_t> (byte & 0x7f) << shift;
+	}
+	return result;
 }
+}
+
+uint8_t constexpr nano::block_sideband::compact_successor_flag;
 
 void nano::block_memory_pool_purge ()
 {
@@ -1834,6 +1864,75 @@ bool nano::block_sideband::deserialize (nano::stream & stream_a, nano::block_typ
 	return result;
 }
 
+void nano::block_sideband::serialize_compact (nano::stream & stream_a, nano::block_type type_a) const
+{
+	uint8_t flags (successor.is_zero () ? 0 : compact_successor_flag);
+	nano::write (stream_a, flags);
+	if (!successor.is_zero ())
+	{
+		nano::write (stream_a, successor.bytes);
+	}
+	if (type_a != nano::block_type::state && type_a != nano::block_type::open)
+	{
+		nano::write (stream_a, account.bytes);
+	}
+	if (type_a != nano::block_type::open)
+	{
+		write_varint (stream_a, height);
+	}
+	if (type_a == nano::block_type::receive || type_a == nano::block_type::change || type_a == nano::block_type::open)
+	{
+		nano::write (stream_a, balance.bytes);
+	}
+	write_varint (stream_a, timestamp);
+	if (type_a == nano::block_type::state)
+	{
+		details.serialize (stream_a);
+		nano::write (stream_a, static_cast<uint8_t> (source_epoch));
+	}
+}
+
+bool nano::block_sideband::deserialize_compact (nano::stream & stream_a, nano::block_type type_a)
+{
+	bool result (false);
+	try
+	{
+		uint8_t flags (0);
+		nano::read (stream_a, flags);
+		if ((flags & compact_successor_flag) != 0)
+		{
+			nano::read (stream_a, successor.bytes);
+		}
+		else
+		{
+			successor.clear ();
+		}
+		if (type_a != nano::block_type::state && type_a != nano::block_type::open)
+		{
+			nano::read (stream_a, account.bytes);
+		}
+		height = type_a != nano::block_type::open ? read_varint (stream_a) : 1;
+		if (type_a == nano::block_type::receive || type_a == nano::block_type::change || type_a == nano::block_type::open)
+		{
+			nano::read (stream_a, balance.bytes);
+		}
+		timestamp = read_varint (stream_a);
+		if (type_a == nano::block_type::state)
+		{
+			result = details.deserialize (stream_a);
+			uint8_t source_epoch_uint8_t{ 0 };
+			nano::read (stream_a, source_epoch_uint8_t);
+			source_epoch = static_cast<nano::epoch> (source_epoch_uint8_t);
+		}
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+
+	return result;
+}
+
 std::shared_ptr<nano::block> nano::block_uniquer::unique (std::shared_ptr<nano::block> block_a)
 {
 	auto result (block_a);
@@ -1875,12 +1974,130 @@ std::shared_ptr<nano::block> nano::block_uniquer::unique (std::shared_ptr<nano::
 	return result;
 }
 
+std::shared_ptr<nano::block> nano::block_uniquer::find (nano::uint256_union const & full_hash_a)
+{
+	std::shared_ptr<nano::block> result;
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (blocks.find (full_hash_a));
+	if (existing != blocks.end ())
+	{
+		result = existing->second.lock ();
+	}
+	return result;
+}
+
 size_t nano::block_uniquer::size ()
 {
 	nano::lock_guard<std::mutex> lock (mutex);
 	return blocks.size ();
 }
 
+nano::block_view::block_view (nano::block_type type_a, uint8_t const * data_a, size_t size_a) :
+type (type_a),
+data (data_a),
+size (size_a)
+{
+}
+
+bool nano::block_view::valid () const
+{
+	auto result (false);
+	switch (type)
+	{
+		case nano::block_type::send:
+		case nano::block_type::receive:
+		case nano::block_type::open:
+		case nano::block_type::change:
+		case nano::block_type::state:
+			result = size == nano::block::size (type);
+			break;
+		default:
+			break;
+	}
+	return result;
+}
+
+size_t nano::block_view::hashables_size () const
+{
+	debug_assert (valid ());
+	return size - sizeof (nano::signature) - sizeof (uint64_t);
+}
+
+nano::root nano::block_view::root () const
+{
+	debug_assert (valid ());
+	nano::root result;
+	switch (type)
+	{
+		case nano::block_type::open:
+			// source, representative, account
+			std::copy_n (data + 2 * sizeof (nano::uint256_union), sizeof (result.bytes), result.bytes.begin ());
+			break;
+		case nano::block_type::state:
+			// account, previous
+			std::copy_n (data + sizeof (nano::uint256_union), sizeof (result.bytes), result.bytes.begin ());
+			if (result.is_zero ())
+			{
+				std::copy_n (data, sizeof (result.bytes), result.bytes.begin ());
+			}
+			break;
+		default:
+			// Legacy send, receive and change blocks start with previous
+			std::copy_n (data, sizeof (result.bytes), result.bytes.begin ());
+			break;
+	}
+	return result;
+}
+
+uint64_t nano::block_view::block_work () const
+{
+	debug_assert (valid ());
+	uint64_t result;
+	std::copy_n (data + size - sizeof (result), sizeof (result), reinterpret_cast<uint8_t *> (&result));
+	if (type == nano::block_type::state)
+	{
+		boost::endian::big_to_native_inplace (result);
+	}
+	return result;
+}
+
+uint64_t nano::block_view::difficulty () const
+{
+	return nano::work_difficulty (nano::work_version::work_1, root (), block_work ());
+}
+
+nano::block_hash nano::block_view::hash () const
+{
+	nano::block_hash result;
+	blake2b_state hash_l;
+	auto status (blake2b_init (&hash_l, sizeof (result.bytes)));
+	debug_assert (status == 0);
+	if (type == nano::block_type::state)
+	{
+		nano::uint256_union preamble (static_cast<uint64_t> (nano::block_type::state));
+		blake2b_update (&hash_l, preamble.bytes.data (), preamble.bytes.size ());
+	}
+	// Hashables are serialized first and in hashing order for every block type
+	blake2b_update (&hash_l, data, hashables_size ());
+	status = blake2b_final (&hash_l, result.bytes.data (), sizeof (result.bytes));
+	debug_assert (status == 0);
+	return result;
+}
+
+nano::block_hash nano::block_view::full_hash () const
+{
+	nano::block_hash result;
+	blake2b_state state;
+	blake2b_init (&state, sizeof (result.bytes));
+	auto hash_l (hash ());
+	blake2b_update (&state, hash_l.bytes.data (), sizeof (hash_l));
+	blake2b_update (&state, data + hashables_size (), sizeof (nano::signature));
+	auto work (block_work ());
+	blake2b_update (&state, &work, sizeof (work));
+	blake2b_final (&state, result.bytes.data (), sizeof (result.bytes));
+	return result;
+}
+
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (block_uniquer & block_uniquer, const std::string & name)
 {
 	auto count = block_uniquer.size ();
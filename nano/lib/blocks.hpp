@@ -63,6 +63,14 @@ public:
 	void serialize (nano::stream &, nano::block_type) const;
 	bool deserialize (nano::stream &, nano::block_type);
 	static size_t size (nano::block_type);
+	/**
+	 * Block store encoding from database version 21. Starts with a flags byte, the successor is only written when set
+	 * and height and timestamp are variable length, the remaining fields follow the rules of serialize ()
+	 */
+	void serialize_compact (nano::stream &, nano::block_type) const;
+	bool deserialize_compact (nano::stream &, nano::block_type);
+	/** Set in the compact flags byte when the successor follows it */
+	static uint8_t constexpr compact_successor_flag{ 0x1 };
 	nano::block_hash successor{ 0 };
 	nano::account account{ 0 };
 	nano::amount balance{ 0 };
@@ -393,6 +401,29 @@ public:
 	virtual void state_block (nano::state_block &) = 0;
 	virtual ~mutable_block_visitor () = default;
 };
+/**
+ * Non-owning view over a serialized block, e.g. inside a network receive buffer
+ * Exposes the fields needed to reject or deduplicate a block before it is deserialized into an owned object
+ */
+class block_view final
+{
+public:
+	block_view (nano::block_type, uint8_t const *, size_t);
+	/** The buffer holds exactly one block of this type */
+	bool valid () const;
+	nano::root root () const;
+	uint64_t block_work () const;
+	uint64_t difficulty () const;
+	nano::block_hash hash () const;
+	/** Same value as nano::block::full_hash of the deserialized block */
+	nano::block_hash full_hash () const;
+	nano::block_type const type;
+	uint8_t const * const data;
+	size_t const size;
+
+private:
+	size_t hashables_size () const;
+};
 /**
  * This class serves to find and return unique variants of a block in order to minimize memory usage
  */
@@ -402,6 +433,8 @@ public:
 	using value_type = std::pair<const nano::uint256_union, std::weak_ptr<nano::block>>;
 
 	std::shared_ptr<nano::block> unique (std::shared_ptr<nano::block>);
+	/** Returns the live block with this full hash, or nullptr */
+	std::shared_ptr<nano::block> find (nano::uint256_union const &);
 	size_t size ();
 
 private:
@@ -21,9 +21,13 @@ nano::error nano::lmdb_config::serialize_toml (nano::tomlconfig & toml) const
 		case nano::lmdb_config::sync_strategy::nosync_unsafe_large_memory:
 			sync_string = "nosync_unsafe_large_memory";
 			break;
+		case nano::lmdb_config::sync_strategy::group_commit:
+			sync_string = "group_commit";
+			break;
 	}
 
-	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory}");
+	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory, group_commit}");
+	toml.put ("group_commit_max_latency", group_commit_max_latency.count (), "Maximum time a group commit waits for queued writers to commit before flushing, only used with the group_commit sync strategy.\ntype:milliseconds");
 	toml.put ("max_databases", max_databases, "Maximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large amounts of wallets are required (see https://docs.nano.org/integration-guides/key-management/).\ntype:uin32");
 	toml.put ("map_size", map_size, "Maximum ledger database map size in bytes.\ntype:uint64");
 	return toml.get_error ();
@@ -35,6 +39,9 @@ nano::error nano::lmdb_config::deserialize_toml (nano::tomlconfig & toml, bool i
 	auto default_max_databases = max_databases;
 	toml.get_optional<uint32_t> ("max_databases", max_databases);
 	toml.get_optional<size_t> ("map_size", map_size);
+	auto group_commit_max_latency_l = static_cast<unsigned long> (group_commit_max_latency.count ());
+	toml.get_optional ("group_commit_max_latency", group_commit_max_latency_l);
+	group_commit_max_latency = std::chrono::milliseconds (group_commit_max_latency_l);
 
 	// For now we accept either setting, but not both
 	if (!params.network.is_dev_network () && is_deprecated_lmdb_dbs_used && default_max_databases != max_databases)
@@ -62,6 +69,10 @@ nano::error nano::lmdb_config::deserialize_toml (nano::tomlconfig & toml, bool i
 		{
 			sync = nano::lmdb_config::sync_strategy::nosync_unsafe_large_memory;
 		}
+		else if (sync_string == "group_commit")
+		{
+			sync = nano::lmdb_config::sync_strategy::group_commit;
+		}
 		else
 		{
 			toml.get_error ().set (sync_string + " is not a valid sync option");
@@ -2,6 +2,7 @@
 
 #include <nano/lib/errors.hpp>
 
+#include <chrono>
 #include <thread>
 
 namespace nano
@@ -36,7 +37,12 @@ public:
 		 * may be slower.
 		 * @warning Do not use this option if external processes uses the database concurrently.
 		 */
-		nosync_unsafe_large_memory
+		nosync_unsafe_large_memory,
+		/**
+		 * Flush the data on commit but not the meta data, which is flushed once for the commits of several writers.
+		 * Writers wait for that flush, so commits are not lost and integrity is maintained.
+		 */
+		group_commit
 	};
 
 	nano::error serialize_toml (nano::tomlconfig & toml_a) const;
@@ -44,6 +50,8 @@ public:
 
 	/** Sync strategy for the ledger database */
 	sync_strategy sync{ always };
+	/** How long a group commit waits for queued writers to join it */
+	std::chrono::milliseconds group_commit_max_latency{ 10 };
 	uint32_t max_databases{ 128 };
 	size_t map_size{ 128ULL * 1024 * 1024 * 1024 };
 };
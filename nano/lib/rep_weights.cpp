@@ -1,6 +1,38 @@
 #include <nano/lib/rep_weights.hpp>
 #include <nano/secure/blockstore.hpp>
 
+namespace
+{
+size_t slot_index (nano::account const & account_a, size_t mask_a)
+{
+	// Accounts are public keys, any part of them is uniformly distributed
+	return static_cast<size_t> (account_a.qwords[0]) & mask_a;
+}
+
+bool slot_matches (std::array<std::atomic<uint64_t>, 4> const & slot_account_a, nano::account const & account_a)
+{
+	auto result (true);
+	for (size_t i (0); result && i < slot_account_a.size (); ++i)
+	{
+		result = slot_account_a[i].load (std::memory_order_relaxed) == account_a.qwords[i];
+	}
+	return result;
+}
+}
+
+nano::rep_weights::table::table (size_t capacity_a) :
+mask (capacity_a - 1),
+slots (std::make_unique<slot[]> (capacity_a))
+{
+	debug_assert ((capacity_a & mask) == 0);
+}
+
+nano::rep_weights::rep_weights ()
+{
+	tables.push_back (std::make_unique<table> (initial_capacity));
+	current.store (tables.back ().get ());
+}
+
 void nano::rep_weights::representation_add (nano::account const & source_rep_a, nano::uint128_t const & amount_a)
 {
 	nano::lock_guard<std::mutex> guard (mutex);
@@ -32,7 +64,6 @@ void nano::rep_weights::representation_put (nano::account const & account_a, nan
 
 nano::uint128_t nano::rep_weights::representation_get (nano::account const & account_a) const
 {
-	nano::lock_guard<std::mutex> lk (mutex);
 	return get (account_a);
 }
 
@@ -40,57 +71,160 @@ nano::uint128_t nano::rep_weights::representation_get (nano::account const & acc
 std::unordered_map<nano::account, nano::uint128_t> nano::rep_weights::get_rep_amounts () const
 {
 	nano::lock_guard<std::mutex> guard (mutex);
-	return rep_amounts;
+	std::unordered_map<nano::account, nano::uint128_t> result;
+	result.reserve (count);
+	auto const & table_l (*tables.back ());
+	for (size_t i (0); i <= table_l.mask; ++i)
+	{
+		auto const & slot_l (table_l.slots[i]);
+		if (slot_l.sequence.load (std::memory_order_relaxed) != 0)
+		{
+			nano::account account;
+			for (size_t j (0); j < slot_l.account.size (); ++j)
+			{
+				account.qwords[j] = slot_l.account[j].load (std::memory_order_relaxed);
+			}
+			result.emplace (account, (nano::uint128_t (slot_l.amount[1].load (std::memory_order_relaxed)) << 64) | slot_l.amount[0].load (std::memory_order_relaxed));
+		}
+	}
+	return result;
 }
 
 void nano::rep_weights::copy_from (nano::rep_weights & other_a)
 {
+	auto other_amounts (other_a.get_rep_amounts ());
 	nano::lock_guard<std::mutex> guard_this (mutex);
-	nano::lock_guard<std::mutex> guard_other (other_a.mutex);
-	for (auto const & entry : other_a.rep_amounts)
+	for (auto const & entry : other_amounts)
 	{
 		auto prev_amount (get (entry.first));
 		put (entry.first, prev_amount + entry.second);
 	}
 }
 
+/** Requires the mutex, publishes the new amount to concurrent readers of the slot */
 void nano::rep_weights::put (nano::account const & account_a, nano::uint128_union const & representation_a)
 {
-	auto it = rep_amounts.find (account_a);
-	auto amount = representation_a.number ();
-	if (it != rep_amounts.end ())
+	debug_assert (!mutex.try_lock ());
+	auto & table_l (*tables.back ());
+	auto index (slot_index (account_a, table_l.mask));
+	while (table_l.slots[index].sequence.load (std::memory_order_relaxed) != 0 && !slot_matches (table_l.slots[index].account, account_a))
 	{
-		it->second = amount;
+		index = (index + 1) & table_l.mask;
 	}
-	else
+	auto & slot_l (table_l.slots[index]);
+	auto sequence (slot_l.sequence.load (std::memory_order_relaxed));
+	auto inserting (sequence == 0);
+	slot_l.sequence.store (sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence (std::memory_order_release);
+	if (inserting)
 	{
-		rep_amounts.emplace (account_a, amount);
+		for (size_t i (0); i < slot_l.account.size (); ++i)
+		{
+			slot_l.account[i].store (account_a.qwords[i], std::memory_order_relaxed);
+		}
+	}
+	slot_l.amount[0].store (representation_a.qwords[0], std::memory_order_relaxed);
+	slot_l.amount[1].store (representation_a.qwords[1], std::memory_order_relaxed);
+	slot_l.sequence.store (sequence + 2, std::memory_order_release);
+	if (inserting && ++count * 2 > table_l.mask + 1)
+	{
+		grow ();
 	}
 }
 
+/*
+ * Lock free, a reader which observes an odd or changed sequence number raced with a writer and retries the slot.
+ * Readers holding a replaced table may return the amount from just before the replacement, like a reader which took the mutex earlier would.
+ */
 nano::uint128_t nano::rep_weights::get (nano::account const & account_a) const
 {
-	auto it = rep_amounts.find (account_a);
-	if (it != rep_amounts.end ())
+	nano::uint128_t result{ 0 };
+	auto const & table_l (*current.load (std::memory_order_acquire));
+	auto index (slot_index (account_a, table_l.mask));
+	auto done (false);
+	while (!done)
 	{
-		return it->second;
+		auto const & slot_l (table_l.slots[index]);
+		auto sequence (slot_l.sequence.load (std::memory_order_acquire));
+		if (sequence == 0)
+		{
+			// Empty slot ends the probe sequence, the account has no weight
+			done = true;
+		}
+		else if ((sequence & 1) == 0)
+		{
+			auto matches (slot_matches (slot_l.account, account_a));
+			auto low (slot_l.amount[0].load (std::memory_order_relaxed));
+			auto high (slot_l.amount[1].load (std::memory_order_relaxed));
+			std::atomic_thread_fence (std::memory_order_acquire);
+			if (slot_l.sequence.load (std::memory_order_relaxed) == sequence)
+			{
+				if (matches)
+				{
+					result = (nano::uint128_t (high) << 64) | low;
+					done = true;
+				}
+				else
+				{
+					index = (index + 1) & table_l.mask;
+				}
+			}
+		}
 	}
-	else
+	return result;
+}
+
+/** Requires the mutex, copies all entries into a table twice the size and makes it current */
+void nano::rep_weights::grow ()
+{
+	debug_assert (!mutex.try_lock ());
+	auto const & old_table (*tables.back ());
+	auto new_table (std::make_unique<table> ((old_table.mask + 1) * 2));
+	for (size_t i (0); i <= old_table.mask; ++i)
 	{
-		return nano::uint128_t{ 0 };
+		auto const & old_slot (old_table.slots[i]);
+		if (old_slot.sequence.load (std::memory_order_relaxed) != 0)
+		{
+			nano::account account;
+			for (size_t j (0); j < old_slot.account.size (); ++j)
+			{
+				account.qwords[j] = old_slot.account[j].load (std::memory_order_relaxed);
+			}
+			auto index (slot_index (account, new_table->mask));
+			while (new_table->slots[index].sequence.load (std::memory_order_relaxed) != 0)
+			{
+				index = (index + 1) & new_table->mask;
+			}
+			auto & new_slot (new_table->slots[index]);
+			for (size_t j (0); j < new_slot.account.size (); ++j)
+			{
+				new_slot.account[j].store (account.qwords[j], std::memory_order_relaxed);
+			}
+			new_slot.amount[0].store (old_slot.amount[0].load (std::memory_order_relaxed), std::memory_order_relaxed);
+			new_slot.amount[1].store (old_slot.amount[1].load (std::memory_order_relaxed), std::memory_order_relaxed);
+			new_slot.sequence.store (2, std::memory_order_relaxed);
+		}
 	}
+	// Release pairs with the acquire in get, readers see the fully populated table
+	current.store (new_table.get (), std::memory_order_release);
+	tables.push_back (std::move (new_table));
 }
 
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (nano::rep_weights const & rep_weights, const std::string & name)
 {
 	size_t rep_amounts_count;
+	size_t slots_count (0);
 
 	{
 		nano::lock_guard<std::mutex> guard (rep_weights.mutex);
-		rep_amounts_count = rep_weights.rep_amounts.size ();
+		rep_amounts_count = rep_weights.count;
+		for (auto const & table : rep_weights.tables)
+		{
+			slots_count += table->mask + 1;
+		}
 	}
-	auto sizeof_element = sizeof (decltype (rep_weights.rep_amounts)::value_type);
 	auto composite = std::make_unique<nano::container_info_composite> (name);
-	composite->add_component (std::make_unique<nano::container_info_leaf> (container_info{ "rep_amounts", rep_amounts_count, sizeof_element }));
+	composite->add_component (std::make_unique<nano::container_info_leaf> (container_info{ "rep_amounts", rep_amounts_count, sizeof (nano::account) + sizeof (nano::uint128_t) }));
+	composite->add_component (std::make_unique<nano::container_info_leaf> (container_info{ "slots", slots_count, sizeof (nano::rep_weights::slot) }));
 	return composite;
 }
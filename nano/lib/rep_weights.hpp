@@ -3,18 +3,28 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace nano
 {
 class block_store;
 class transaction;
 
+/**
+ * Weight per representative, queried for every vote and every election tally.
+ * Lookups are lock free: entries live in an open addressing table where each slot is guarded by a sequence counter (seqlock),
+ * readers retry whenever they observe a concurrent write to the slot. Writers are serialized by the mutex.
+ * Entries are never removed, a full table is replaced by a larger copy and kept until destruction because readers may still use it.
+ */
 class rep_weights
 {
 public:
+	rep_weights ();
 	void representation_add (nano::account const & source_rep_a, nano::uint128_t const & amount_a);
 	void representation_add_dual (nano::account const & source_rep_1, nano::uint128_t const & amount_1, nano::account const & source_rep_2, nano::uint128_t const & amount_2);
 	nano::uint128_t representation_get (nano::account const & account_a) const;
@@ -23,10 +33,30 @@ public:
 	void copy_from (rep_weights & other_a);
 
 private:
+	class slot final
+	{
+	public:
+		/** Zero while the slot is empty, odd while a writer is updating it */
+		std::atomic<uint64_t> sequence{ 0 };
+		std::array<std::atomic<uint64_t>, 4> account{};
+		std::array<std::atomic<uint64_t>, 2> amount{};
+	};
+	class table final
+	{
+	public:
+		explicit table (size_t);
+		size_t const mask;
+		std::unique_ptr<slot[]> slots;
+	};
+	static size_t constexpr initial_capacity{ 256 };
 	mutable std::mutex mutex;
-	std::unordered_map<nano::account, nano::uint128_t> rep_amounts;
+	std::atomic<table *> current;
+	/** Every table published so far, the last one is current */
+	std::vector<std::unique_ptr<table>> tables;
+	size_t count{ 0 };
 	void put (nano::account const & account_a, nano::uint128_union const & representation_a);
 	nano::uint128_t get (nano::account const & account_a) const;
+	void grow ();
 
 	friend std::unique_ptr<container_info_component> collect_container_info (rep_weights const &, const std::string &);
 };
@@ -6,9 +6,75 @@
 #include <boost/format.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <algorithm>
 #include <ctime>
 #include <fstream>
 #include <sstream>
+#include <thread>
+
+namespace
+{
+/** Upper bound on the number of counter shards, each shard holds one counter per stat key */
+size_t constexpr max_counter_shards = 16;
+
+size_t counter_shard_count ()
+{
+	return std::max<size_t> (1, std::min<size_t> (max_counter_shards, std::thread::hardware_concurrency ()));
+}
+
+/** Threads are assigned shards round-robin in the order they first update a stat */
+size_t thread_shard_index ()
+{
+	static std::atomic<size_t> next_shard{ 0 };
+	thread_local size_t shard_index = next_shard.fetch_add (1, std::memory_order_relaxed);
+	return shard_index;
+}
+}
+
+nano::stat_counter_shards::stat_counter_shards (size_t counter_count_a, size_t shard_count_a) :
+counter_count (counter_count_a)
+{
+	debug_assert (shard_count_a > 0);
+	shards.reserve (shard_count_a);
+	for (size_t i (0); i < shard_count_a; ++i)
+	{
+		// Each shard is a separate allocation so that counters in different shards never share a cache line
+		std::unique_ptr<std::atomic<uint64_t>[]> shard (new std::atomic<uint64_t>[counter_count]);
+		for (size_t j (0); j < counter_count; ++j)
+		{
+			shard[j].store (0, std::memory_order_relaxed);
+		}
+		shards.push_back (std::move (shard));
+	}
+}
+
+void nano::stat_counter_shards::add (size_t index_a, uint64_t value_a)
+{
+	debug_assert (index_a < counter_count);
+	shards[thread_shard_index () % shards.size ()][index_a].fetch_add (value_a, std::memory_order_relaxed);
+}
+
+uint64_t nano::stat_counter_shards::sum (size_t index_a) const
+{
+	debug_assert (index_a < counter_count);
+	uint64_t result (0);
+	for (auto const & shard : shards)
+	{
+		result += shard[index_a].load (std::memory_order_relaxed);
+	}
+	return result;
+}
+
+void nano::stat_counter_shards::clear ()
+{
+	for (auto & shard : shards)
+	{
+		for (size_t i (0); i < counter_count; ++i)
+		{
+			shard[i].store (0, std::memory_order_relaxed);
+		}
+	}
+}
 
 nano::error nano::stat_config::deserialize_json (nano::jsonconfig & json)
 {
@@ -191,9 +257,58 @@ public:
 	}
 };
 
+nano::stat::stat () :
+stat (nano::stat_config ())
+{
+}
+
 nano::stat::stat (nano::stat_config config) :
-config (config)
+config (config),
+counters (key_count, counter_shard_count ()),
+fast_path (new std::atomic<bool>[key_count])
 {
+	for (size_t i (0); i < key_count; ++i)
+	{
+		fast_path[i].store (false, std::memory_order_relaxed);
+	}
+}
+
+void nano::stat::configure (stat::type type, stat::detail detail, stat::dir dir, size_t interval, size_t capacity)
+{
+	get_entry (key_of (type, detail, dir), interval, capacity);
+}
+
+void nano::stat::disable_sampling (stat::type type, stat::detail detail, stat::dir dir)
+{
+	auto entry = get_entry (key_of (type, detail, dir));
+	entry->sample_interval = 0;
+}
+
+void nano::stat::observe_sample (stat::type type, stat::detail detail, stat::dir dir, std::function<void(boost::circular_buffer<stat_datapoint> &)> observer)
+{
+	auto key (key_of (type, detail, dir));
+	nano::lock_guard<std::mutex> lock (stat_mutex);
+	get_entry_impl (key, config.interval, config.capacity)->sample_observers.add (observer);
+	fast_path[index_of (key)] = false;
+}
+
+void nano::stat::observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void(uint64_t, uint64_t)> observer)
+{
+	auto key (key_of (type, detail, dir));
+	nano::lock_guard<std::mutex> lock (stat_mutex);
+	get_entry_impl (key, config.interval, config.capacity)->count_observers.add (observer);
+	fast_path[index_of (key)] = false;
+}
+
+bool nano::stat::fast_path_eligible (nano::stat_entry const & entry) const
+{
+	auto sampling (config.sampling_enabled && entry.sample_interval > 0);
+	return !sampling && config.log_interval_counters == 0 && entry.count_observers.observers.empty () && entry.sample_observers.observers.empty ();
+}
+
+uint64_t nano::stat::counter_value (uint32_t key, nano::stat_entry const & entry) const
+{
+	return entry.counter.get_value () + counters.sum (index_of (key));
 }
 
 std::shared_ptr<nano::stat_entry> nano::stat::get_entry (uint32_t key)
@@ -257,7 +372,7 @@ void nano::stat::log_counters_impl (stat_log_sink & sink)
 		std::string type = type_to_string (key);
 		std::string detail = detail_to_string (key);
 		std::string dir = dir_to_string (key);
-		sink.write_entry (local_tm, type, detail, dir, it.second->counter.get_value ());
+		sink.write_entry (local_tm, type, detail, dir, counter_value (key, *it.second));
 	}
 	sink.entries ()++;
 	sink.finalize ();
@@ -306,6 +421,16 @@ void nano::stat::update (uint32_t key_a, uint64_t value)
 	static file_writer log_count (config.log_counters_filename);
 	static file_writer log_sample (config.log_samples_filename);
 
+	auto index (index_of (key_a));
+	if (fast_path[index].load (std::memory_order_acquire))
+	{
+		if (!stopped)
+		{
+			counters.add (index, value);
+		}
+		return;
+	}
+
 	auto now (std::chrono::steady_clock::now ());
 
 	nano::unique_lock<std::mutex> lock (stat_mutex);
@@ -314,9 +439,9 @@ void nano::stat::update (uint32_t key_a, uint64_t value)
 		auto entry (get_entry_impl (key_a, config.interval, config.capacity));
 
 		// Counters
-		auto old (entry->counter.get_value ());
+		auto old (counter_value (key_a, *entry));
 		entry->counter.add (value);
-		entry->count_observers.notify (old, entry->counter.get_value ());
+		entry->count_observers.notify (old, old + value);
 
 		std::chrono::duration<double, std::milli> duration = now - log_last_count_writeout;
 		if (config.log_interval_counters > 0 && duration.count () > config.log_interval_counters)
@@ -355,6 +480,9 @@ void nano::stat::update (uint32_t key_a, uint64_t value)
 				}
 			}
 		}
+
+		// Subsequent updates can bypass the mutex if nothing but the counter needs to be maintained
+		fast_path[index].store (fast_path_eligible (*entry), std::memory_order_release);
 	}
 }
 
@@ -374,7 +502,12 @@ void nano::stat::stop ()
 void nano::stat::clear ()
 {
 	nano::unique_lock<std::mutex> lock (stat_mutex);
+	for (size_t i (0); i < key_count; ++i)
+	{
+		fast_path[i].store (false, std::memory_order_release);
+	}
 	entries.clear ();
+	counters.clear ();
 	timestamp = std::chrono::steady_clock::now ();
 }
 
@@ -453,6 +586,38 @@ std::string nano::stat::type_to_string (uint32_t key)
 		case nano::stat::type::vote_generator:
 			res = "vote_generator";
 			break;
+		case nano::stat::type::pruning:
+			res = "pruning";
+			break;
+		case nano::stat::type::block_processor:
+			res = "block_processor";
+			break;
+		case nano::stat::type::block_processor_latency:
+			res = "block_processor_latency";
+			break;
+		case nano::stat::type::outbound_drop:
+			res = "outbound_drop";
+			break;
+		case nano::stat::type::outbound_coalesce:
+			res = "outbound_coalesce";
+			break;
+		case nano::stat::type::outbound_latency:
+			res = "outbound_latency";
+			break;
+		case nano::stat::type::signature_cache:
+			res = "signature_cache";
+			break;
+		case nano::stat::type::block_cache:
+			res = "block_cache";
+			break;
+		case nano::stat::type::account_info_cache:
+			res = "account_info_cache";
+			break;
+		case nano::stat::type::confirmation_height_cache:
+			res = "confirmation_height_cache";
+			break;
+		case nano::stat::type::_last:
+			break;
 	}
 	return res;
 }
@@ -730,6 +895,9 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::duplicate_publish:
 			res = "duplicate_publish";
 			break;
+		case nano::stat::detail::duplicate_confirm_ack:
+			res = "duplicate_confirm_ack";
+			break;
 		case nano::stat::detail::different_genesis_hash:
 			res = "different_genesis_hash";
 			break;
@@ -760,6 +928,50 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::generator_replies_discarded:
 			res = "generator_replies_discarded";
 			break;
+		case nano::stat::detail::generator_coalesced_requests:
+			res = "generator_coalesced_requests";
+			break;
+		case nano::stat::detail::generator_packed_hashes:
+			res = "generator_packed_hashes";
+			break;
+		case nano::stat::detail::generator_packed_votes:
+			res = "generator_packed_votes";
+			break;
+		case nano::stat::detail::pruned_blocks:
+			res = "pruned_blocks";
+			break;
+		case nano::stat::detail::pruning_targets:
+			res = "pruning_targets";
+			break;
+		case nano::stat::detail::local:
+			res = "local";
+			break;
+		case nano::stat::detail::live:
+			res = "live";
+			break;
+		case nano::stat::detail::bootstrap:
+			res = "bootstrap";
+			break;
+		case nano::stat::detail::unchecked:
+			res = "unchecked";
+			break;
+		case nano::stat::detail::validated:
+			res = "validated";
+			break;
+		case nano::stat::detail::snapshot_loaded:
+			res = "snapshot_loaded";
+			break;
+		case nano::stat::detail::snapshot_rejected:
+			res = "snapshot_rejected";
+			break;
+		case nano::stat::detail::hit:
+			res = "hit";
+			break;
+		case nano::stat::detail::miss:
+			res = "miss";
+			break;
+		case nano::stat::detail::_last:
+			break;
 	}
 	return res;
 }
@@ -776,6 +988,8 @@ std::string nano::stat::dir_to_string (uint32_t key)
 		case nano::stat::dir::out:
 			res = "out";
 			break;
+		case nano::stat::dir::_last:
+			break;
 	}
 	return res;
 }
@@ -5,11 +5,13 @@
 
 #include <boost/circular_buffer.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace nano
 {
@@ -109,6 +111,24 @@ public:
 	nano::observer_set<uint64_t, uint64_t> count_observers;
 };
 
+/**
+ * Lock-free counters used on the fast path of stat::update. Every thread is assigned to one of a fixed number
+ * of shards on first use, so concurrent updates to the same counter from different threads rarely touch the
+ * same cache line. Reads aggregate over all shards and are therefore more expensive than updates.
+ */
+class stat_counter_shards final
+{
+public:
+	stat_counter_shards (size_t counter_count_a, size_t shard_count_a);
+	void add (size_t index_a, uint64_t value_a);
+	uint64_t sum (size_t index_a) const;
+	void clear ();
+
+private:
+	size_t const counter_count;
+	std::vector<std::unique_ptr<std::atomic<uint64_t>[]>> shards;
+};
+
 /** Log sink interface */
 class stat_log_sink
 {
@@ -202,7 +222,19 @@ public:
 		requests,
 		filter,
 		telemetry,
-		vote_generator
+		vote_generator,
+		pruning,
+		block_processor,
+		block_processor_latency,
+		outbound_drop,
+		outbound_coalesce,
+		outbound_latency,
+		signature_cache,
+		block_cache,
+		account_info_cache,
+		confirmation_height_cache,
+
+		_last // Must be the last enum
 	};
 
 	/** Optional detail type */
@@ -329,6 +361,7 @@ public:
 
 		// duplicate
 		duplicate_publish,
+		duplicate_confirm_ack,
 
 		// telemetry
 		invalid_signature,
@@ -342,18 +375,44 @@ public:
 		// vote generator
 		generator_broadcasts,
 		generator_replies,
-		generator_replies_discarded
+		generator_replies_discarded,
+		generator_coalesced_requests,
+		generator_packed_hashes,
+		generator_packed_votes,
+
+		// pruning
+		pruned_blocks,
+		pruning_targets,
+
+		// block processor lanes
+		local,
+		live,
+		bootstrap,
+		unchecked,
+		validated,
+
+		// rep weights snapshot
+		snapshot_loaded,
+		snapshot_rejected,
+
+		// signature cache
+		hit,
+		miss,
+
+		_last // Must be the last enum
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
 	enum class dir : uint8_t
 	{
 		in,
-		out
+		out,
+
+		_last // Must be the last enum
 	};
 
 	/** Constructor using the default config values */
-	stat () = default;
+	stat ();
 
 	/**
 	 * Initialize stats with a config.
@@ -365,19 +424,12 @@ public:
 	 * Call this to override the default sample interval and capacity, for a specific stat entry.
 	 * This must be called before any stat entries are added, as part of the node initialiation.
 	 */
-	void configure (stat::type type, stat::detail detail, stat::dir dir, size_t interval, size_t capacity)
-	{
-		get_entry (key_of (type, detail, dir), interval, capacity);
-	}
+	void configure (stat::type type, stat::detail detail, stat::dir dir, size_t interval, size_t capacity);
 
 	/**
 	 * Disables sampling for a given type/detail/dir combination
 	 */
-	void disable_sampling (stat::type type, stat::detail detail, stat::dir dir)
-	{
-		auto entry = get_entry (key_of (type, detail, dir));
-		entry->sample_interval = 0;
-	}
+	void disable_sampling (stat::type type, stat::detail detail, stat::dir dir);
 
 	/** Increments the given counter */
 	void inc (stat::type type, stat::dir dir = stat::dir::in)
@@ -438,10 +490,7 @@ public:
 	 * To avoid recursion, the observer callback must only use the received data point snapshop, not query the stat object.
 	 * @param observer The observer receives a snapshot of the current samples.
 	 */
-	void observe_sample (stat::type type, stat::detail detail, stat::dir dir, std::function<void(boost::circular_buffer<stat_datapoint> &)> observer)
-	{
-		get_entry (key_of (type, detail, dir))->sample_observers.add (observer);
-	}
+	void observe_sample (stat::type type, stat::detail detail, stat::dir dir, std::function<void(boost::circular_buffer<stat_datapoint> &)> observer);
 
 	void observe_sample (stat::type type, stat::dir dir, std::function<void(boost::circular_buffer<stat_datapoint> &)> observer)
 	{
@@ -453,10 +502,7 @@ public:
 	 * To avoid recursion, the observer callback must only use the received counts, not query the stat object.
 	 * @param observer The observer receives the old and the new count.
 	 */
-	void observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void(uint64_t, uint64_t)> observer)
-	{
-		get_entry (key_of (type, detail, dir))->count_observers.add (observer);
-	}
+	void observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void(uint64_t, uint64_t)> observer);
 
 	/** Returns a potentially empty list of the last N samples, where N is determined by the 'capacity' configuration */
 	boost::circular_buffer<stat_datapoint> * samples (stat::type type, stat::detail detail, stat::dir dir)
@@ -473,7 +519,8 @@ public:
 	/** Returns current value for the given counter at the detail level */
 	uint64_t count (stat::type type, stat::detail detail, stat::dir dir = stat::dir::in)
 	{
-		return get_entry (key_of (type, detail, dir))->counter.get_value ();
+		auto key (key_of (type, detail, dir));
+		return get_entry (key)->counter.get_value () + counters.sum (index_of (key));
 	}
 
 	/** Returns the number of seconds since clear() was last called, or node startup if it's never called. */
@@ -507,6 +554,24 @@ private:
 		return static_cast<uint8_t> (type) << 16 | static_cast<uint8_t> (detail) << 8 | static_cast<uint8_t> (dir);
 	}
 
+	/** Number of distinct keys, used to size the sharded counters and the fast path flags */
+	static constexpr size_t key_count = static_cast<size_t> (stat::type::_last) * static_cast<size_t> (stat::detail::_last) * static_cast<size_t> (stat::dir::_last);
+
+	/** Maps a key to a dense index in [0, key_count) */
+	static size_t index_of (uint32_t key)
+	{
+		auto type (key >> 16 & 0x000000ff);
+		auto detail (key >> 8 & 0x000000ff);
+		auto dir (key & 0x000000ff);
+		return (type * static_cast<size_t> (stat::detail::_last) + detail) * static_cast<size_t> (stat::dir::_last) + dir;
+	}
+
+	/** Returns true if updates to \p entry need neither observers, sampling nor log writeout, and can be done on the lock-free fast path */
+	bool fast_path_eligible (nano::stat_entry const & entry) const;
+
+	/** Sum of the sharded counter and the locked counter for \p key. Must be called with stat_mutex held. */
+	uint64_t counter_value (uint32_t key, nano::stat_entry const & entry) const;
+
 	/** Get entry for key, creating a new entry if necessary, using interval and sample count from config */
 	std::shared_ptr<nano::stat_entry> get_entry (uint32_t key);
 
@@ -541,7 +606,16 @@ private:
 	std::chrono::steady_clock::time_point log_last_sample_writeout{ std::chrono::steady_clock::now () };
 
 	/** Whether stats should be output */
-	bool stopped{ false };
+	std::atomic<bool> stopped{ false };
+
+	/** Counters for keys on the fast path. The value of a counter is the sum of the entry counter and its shards */
+	nano::stat_counter_shards counters;
+
+	/**
+	 * Set for keys whose entry exists and has no observers or sampling, so updates can skip stat_mutex.
+	 * Flags are only set while holding stat_mutex and are reset whenever the entry changes.
+	 */
+	std::unique_ptr<std::atomic<bool>[]> fast_path;
 
 	/** All access to stat is thread safe, including calls from observers on the same thread */
 	std::mutex stat_mutex;
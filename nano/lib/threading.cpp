@@ -43,6 +43,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::block_processing:
 			thread_role_name_string = "Blck processing";
 			break;
+		case nano::thread_role::name::block_validation:
+			thread_role_name_string = "Blck validation";
+			break;
 		case nano::thread_role::name::request_loop:
 			thread_role_name_string = "Request loop";
 			break;
@@ -82,6 +85,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::state_block_signature_verification:
 			thread_role_name_string = "State block sig";
 			break;
+		case nano::thread_role::name::signature_pipeline:
+			thread_role_name_string = "Sig pipeline";
+			break;
 		case nano::thread_role::name::epoch_upgrader:
 			thread_role_name_string = "Epoch upgrader";
 			break;
@@ -22,6 +22,7 @@ namespace thread_role
 		alarm,
 		vote_processing,
 		block_processing,
+		block_validation,
 		request_loop,
 		wallet_actions,
 		bootstrap_initiator,
@@ -35,6 +36,7 @@ namespace thread_role
 		worker,
 		request_aggregator,
 		state_block_signature_verification,
+		signature_pipeline,
 		epoch_upgrader
 	};
 	/*
@@ -3,6 +3,7 @@
 #include <nano/lib/epoch.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/lib/work.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/node/xorshift.hpp>
 
 #include <future>
@@ -202,7 +203,8 @@ nano::work_pool::work_pool (unsigned max_threads_a, std::chrono::nanoseconds pow
 ticket (0),
 done (false),
 pow_rate_limiter (pow_rate_limiter_a),
-opencl (opencl_a)
+opencl (opencl_a),
+kernel (nano::work_kernel_best ())
 {
 	static_assert (ATOMIC_INT_LOCK_FREE == 2, "Atomic int needed");
 	boost::thread::attributes attrs;
@@ -239,8 +241,8 @@ void nano::work_pool::loop (uint64_t thread)
 	nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (rng.s.data ()), rng.s.size () * sizeof (decltype (rng.s)::value_type));
 	uint64_t work;
 	uint64_t output;
-	blake2b_state hash;
-	blake2b_init (&hash, sizeof (output));
+	std::array<uint64_t, nano::work_kernel::max_lanes> nonces;
+	std::array<uint64_t, nano::work_kernel::max_lanes> outputs;
 	nano::unique_lock<std::mutex> lock (mutex);
 	auto pow_sleep = pow_rate_limiter;
 	while (!done)
@@ -275,14 +277,20 @@ void nano::work_pool::loop (uint64_t thread)
 					// Don't query main memory every iteration in order to reduce memory bus traffic
 					// All operations here operate on stack memory
 					// Count iterations down to zero since comparing to zero is easier than comparing to another number
-					unsigned iteration (256);
+					// Each iteration hashes one nonce per kernel lane, keep ~256 hashes between checks
+					unsigned iteration (256 / kernel.lanes);
 					while (iteration && output < current_l.difficulty)
 					{
-						work = rng.next ();
-						blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work), sizeof (work));
-						blake2b_update (&hash, current_l.item.bytes.data (), current_l.item.bytes.size ());
-						blake2b_final (&hash, reinterpret_cast<uint8_t *> (&output), sizeof (output));
-						blake2b_init (&hash, sizeof (output));
+						for (size_t lane (0); lane < kernel.lanes; ++lane)
+						{
+							nonces[lane] = rng.next ();
+						}
+						kernel.compute (current_l.item, nonces.data (), outputs.data ());
+						for (size_t lane (0); lane < kernel.lanes && output < current_l.difficulty; ++lane)
+						{
+							work = nonces[lane];
+							output = outputs[lane];
+						}
 						iteration -= 1;
 					}
 
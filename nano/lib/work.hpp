@@ -44,6 +44,7 @@ namespace work_v1
 double normalized_multiplier (double const, uint64_t const);
 double denormalized_multiplier (double const, uint64_t const);
 class opencl_work;
+class work_kernel;
 class work_item final
 {
 public:
@@ -80,6 +81,8 @@ public:
 	std::chrono::nanoseconds pow_rate_limiter;
 	std::function<boost::optional<uint64_t> (nano::work_version const, nano::root const &, uint64_t, std::atomic<int> &)> opencl;
 	nano::observer_set<bool> work_observers;
+	/** CPU kernel used by the work threads, see nano::work_kernel_best */
+	nano::work_kernel const & kernel;
 };
 
 std::unique_ptr<container_info_component> collect_container_info (work_pool & work_pool, const std::string & name);
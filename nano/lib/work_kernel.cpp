@@ -0,0 +1,273 @@
+#include <nano/lib/work.hpp>
+#include <nano/lib/work_kernel.hpp>
+
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NANO_WORK_KERNEL_X86
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define NANO_WORK_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+/*
+ * Blake2b specialized for work_v1: 8 byte digest, no key, and a 40 byte message (nonce || root) which fits
+ * in a single final block. Only message word 0 differs between nonces, words 1-4 hold the root and the rest are zero.
+ * See RFC 7693 for the reference algorithm, the generic implementation is used by nano::work_v1::value.
+ */
+namespace
+{
+uint64_t constexpr blake2b_iv[8] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+uint8_t constexpr blake2b_sigma[12][16] = {
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+	{ 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+	{ 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+	{ 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+	{ 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+	{ 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+	{ 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+	{ 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+	{ 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 }
+};
+
+// Parameter block word 0: digest length 8, key length 0, fanout 1, depth 1
+uint64_t constexpr blake2b_param = 0x01010000ULL | sizeof (uint64_t);
+// Message length in bytes, added to the counter word
+uint64_t constexpr work_message_size = sizeof (uint64_t) + sizeof (nano::root);
+
+// The kernels below define ADD, XOR and ROR* for their vector type before using these
+#define NANO_BLAKE2B_G(r, i, a, b, c, d)                 \
+	a = ADD (ADD (a, b), m[blake2b_sigma[r][2 * i]]);     \
+	d = ROR32 (XOR (d, a));                               \
+	c = ADD (c, d);                                       \
+	b = ROR24 (XOR (b, c));                               \
+	a = ADD (ADD (a, b), m[blake2b_sigma[r][2 * i + 1]]); \
+	d = ROR16 (XOR (d, a));                               \
+	c = ADD (c, d);                                       \
+	b = ROR63 (XOR (b, c));
+
+#define NANO_BLAKE2B_ROUND(r)                        \
+	NANO_BLAKE2B_G (r, 0, v[0], v[4], v[8], v[12])  \
+	NANO_BLAKE2B_G (r, 1, v[1], v[5], v[9], v[13])  \
+	NANO_BLAKE2B_G (r, 2, v[2], v[6], v[10], v[14]) \
+	NANO_BLAKE2B_G (r, 3, v[3], v[7], v[11], v[15]) \
+	NANO_BLAKE2B_G (r, 4, v[0], v[5], v[10], v[15]) \
+	NANO_BLAKE2B_G (r, 5, v[1], v[6], v[11], v[12]) \
+	NANO_BLAKE2B_G (r, 6, v[2], v[7], v[8], v[13])  \
+	NANO_BLAKE2B_G (r, 7, v[3], v[4], v[9], v[14])
+
+#define NANO_BLAKE2B_ROUNDS  \
+	NANO_BLAKE2B_ROUND (0)  \
+	NANO_BLAKE2B_ROUND (1)  \
+	NANO_BLAKE2B_ROUND (2)  \
+	NANO_BLAKE2B_ROUND (3)  \
+	NANO_BLAKE2B_ROUND (4)  \
+	NANO_BLAKE2B_ROUND (5)  \
+	NANO_BLAKE2B_ROUND (6)  \
+	NANO_BLAKE2B_ROUND (7)  \
+	NANO_BLAKE2B_ROUND (8)  \
+	NANO_BLAKE2B_ROUND (9)  \
+	NANO_BLAKE2B_ROUND (10) \
+	NANO_BLAKE2B_ROUND (11)
+
+bool always_supported ()
+{
+	return true;
+}
+
+#ifndef NANO_FUZZER_TEST
+#define ADD(a, b) ((a) + (b))
+#define XOR(a, b) ((a) ^ (b))
+#define ROR32(x) (((x) >> 32) | ((x) << 32))
+#define ROR24(x) (((x) >> 24) | ((x) << 40))
+#define ROR16(x) (((x) >> 16) | ((x) << 48))
+#define ROR63(x) (((x) >> 63) | ((x) << 1))
+void compute_scalar (nano::root const & root_a, uint64_t const * nonces_a, uint64_t * outputs_a)
+{
+	uint64_t m[16] = { nonces_a[0], root_a.raw.qwords[0], root_a.raw.qwords[1], root_a.raw.qwords[2], root_a.raw.qwords[3] };
+	uint64_t v[16] = {
+		blake2b_iv[0] ^ blake2b_param, blake2b_iv[1], blake2b_iv[2], blake2b_iv[3], blake2b_iv[4], blake2b_iv[5], blake2b_iv[6], blake2b_iv[7],
+		blake2b_iv[0], blake2b_iv[1], blake2b_iv[2], blake2b_iv[3], blake2b_iv[4] ^ work_message_size, blake2b_iv[5], ~blake2b_iv[6], blake2b_iv[7]
+	};
+	NANO_BLAKE2B_ROUNDS
+	outputs_a[0] = blake2b_iv[0] ^ blake2b_param ^ v[0] ^ v[8];
+}
+#undef ADD
+#undef XOR
+#undef ROR32
+#undef ROR24
+#undef ROR16
+#undef ROR63
+#endif
+
+#ifdef NANO_WORK_KERNEL_X86
+#define ADD(a, b) _mm256_add_epi64 (a, b)
+#define XOR(a, b) _mm256_xor_si256 (a, b)
+#define ROR32(x) _mm256_shuffle_epi32 (x, _MM_SHUFFLE (2, 3, 0, 1))
+#define ROR24(x) _mm256_shuffle_epi8 (x, rotate24)
+#define ROR16(x) _mm256_shuffle_epi8 (x, rotate16)
+#define ROR63(x) _mm256_xor_si256 (_mm256_srli_epi64 (x, 63), _mm256_add_epi64 (x, x))
+__attribute__ ((target ("avx2"))) void compute_avx2 (nano::root const & root_a, uint64_t const * nonces_a, uint64_t * outputs_a)
+{
+	auto const rotate24 (_mm256_setr_epi8 (3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10));
+	auto const rotate16 (_mm256_setr_epi8 (2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9));
+	auto const zero (_mm256_setzero_si256 ());
+	__m256i const m[16] = {
+		_mm256_loadu_si256 (reinterpret_cast<__m256i const *> (nonces_a)),
+		_mm256_set1_epi64x (root_a.raw.qwords[0]), _mm256_set1_epi64x (root_a.raw.qwords[1]), _mm256_set1_epi64x (root_a.raw.qwords[2]), _mm256_set1_epi64x (root_a.raw.qwords[3]),
+		zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero
+	};
+	__m256i v[16];
+	for (auto i (0); i < 8; ++i)
+	{
+		v[i] = _mm256_set1_epi64x (blake2b_iv[i] ^ (i == 0 ? blake2b_param : 0));
+		v[i + 8] = _mm256_set1_epi64x (blake2b_iv[i] ^ (i == 4 ? work_message_size : 0) ^ (i == 6 ? ~0ULL : 0));
+	}
+	NANO_BLAKE2B_ROUNDS
+	auto result (XOR (_mm256_set1_epi64x (blake2b_iv[0] ^ blake2b_param), XOR (v[0], v[8])));
+	_mm256_storeu_si256 (reinterpret_cast<__m256i *> (outputs_a), result);
+}
+#undef ADD
+#undef XOR
+#undef ROR32
+#undef ROR24
+#undef ROR16
+#undef ROR63
+
+bool avx2_supported ()
+{
+	return __builtin_cpu_supports ("avx2");
+}
+
+#define ADD(a, b) _mm512_add_epi64 (a, b)
+#define XOR(a, b) _mm512_xor_si512 (a, b)
+#define ROR32(x) _mm512_ror_epi64 (x, 32)
+#define ROR24(x) _mm512_ror_epi64 (x, 24)
+#define ROR16(x) _mm512_ror_epi64 (x, 16)
+#define ROR63(x) _mm512_ror_epi64 (x, 63)
+// Some GCC versions warn about the undefined pass-through operand inside their AVX-512 intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+__attribute__ ((target ("avx512f"))) void compute_avx512 (nano::root const & root_a, uint64_t const * nonces_a, uint64_t * outputs_a)
+{
+	auto const zero (_mm512_setzero_si512 ());
+	__m512i const m[16] = {
+		_mm512_loadu_si512 (nonces_a),
+		_mm512_set1_epi64 (root_a.raw.qwords[0]), _mm512_set1_epi64 (root_a.raw.qwords[1]), _mm512_set1_epi64 (root_a.raw.qwords[2]), _mm512_set1_epi64 (root_a.raw.qwords[3]),
+		zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero
+	};
+	__m512i v[16];
+	for (auto i (0); i < 8; ++i)
+	{
+		v[i] = _mm512_set1_epi64 (blake2b_iv[i] ^ (i == 0 ? blake2b_param : 0));
+		v[i + 8] = _mm512_set1_epi64 (blake2b_iv[i] ^ (i == 4 ? work_message_size : 0) ^ (i == 6 ? ~0ULL : 0));
+	}
+	NANO_BLAKE2B_ROUNDS
+	auto result (XOR (_mm512_set1_epi64 (blake2b_iv[0] ^ blake2b_param), XOR (v[0], v[8])));
+	_mm512_storeu_si512 (outputs_a, result);
+}
+#pragma GCC diagnostic pop
+#undef ADD
+#undef XOR
+#undef ROR32
+#undef ROR24
+#undef ROR16
+#undef ROR63
+
+bool avx512_supported ()
+{
+	return __builtin_cpu_supports ("avx512f");
+}
+#endif
+
+#ifdef NANO_WORK_KERNEL_NEON
+#define ADD(a, b) vaddq_u64 (a, b)
+#define XOR(a, b) veorq_u64 (a, b)
+#define ROR32(x) vreinterpretq_u64_u32 (vrev64q_u32 (vreinterpretq_u32_u64 (x)))
+#define ROR24(x) vorrq_u64 (vshrq_n_u64 (x, 24), vshlq_n_u64 (x, 40))
+#define ROR16(x) vorrq_u64 (vshrq_n_u64 (x, 16), vshlq_n_u64 (x, 48))
+#define ROR63(x) vorrq_u64 (vshrq_n_u64 (x, 63), vshlq_n_u64 (x, 1))
+void compute_neon (nano::root const & root_a, uint64_t const * nonces_a, uint64_t * outputs_a)
+{
+	auto const zero (vdupq_n_u64 (0));
+	uint64x2_t const m[16] = {
+		vld1q_u64 (nonces_a),
+		vdupq_n_u64 (root_a.raw.qwords[0]), vdupq_n_u64 (root_a.raw.qwords[1]), vdupq_n_u64 (root_a.raw.qwords[2]), vdupq_n_u64 (root_a.raw.qwords[3]),
+		zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero
+	};
+	uint64x2_t v[16];
+	for (auto i (0); i < 8; ++i)
+	{
+		v[i] = vdupq_n_u64 (blake2b_iv[i] ^ (i == 0 ? blake2b_param : 0));
+		v[i + 8] = vdupq_n_u64 (blake2b_iv[i] ^ (i == 4 ? work_message_size : 0) ^ (i == 6 ? ~0ULL : 0));
+	}
+	NANO_BLAKE2B_ROUNDS
+	vst1q_u64 (outputs_a, XOR (vdupq_n_u64 (blake2b_iv[0] ^ blake2b_param), XOR (v[0], v[8])));
+}
+#undef ADD
+#undef XOR
+#undef ROR32
+#undef ROR24
+#undef ROR16
+#undef ROR63
+#endif
+
+#undef NANO_BLAKE2B_ROUNDS
+#undef NANO_BLAKE2B_ROUND
+#undef NANO_BLAKE2B_G
+
+#ifdef NANO_FUZZER_TEST
+// Fuzzer builds replace the work value function, kernels must agree with it
+void compute_reference (nano::root const & root_a, uint64_t const * nonces_a, uint64_t * outputs_a)
+{
+	outputs_a[0] = nano::work_v1::value (root_a, nonces_a[0]);
+}
+#endif
+
+std::vector<nano::work_kernel> available_kernels ()
+{
+	std::vector<nano::work_kernel> all;
+#ifndef NANO_FUZZER_TEST
+	all.push_back ({ "scalar", 1, compute_scalar, always_supported });
+#ifdef NANO_WORK_KERNEL_X86
+	all.push_back ({ "avx2", 4, compute_avx2, avx2_supported });
+	all.push_back ({ "avx512", 8, compute_avx512, avx512_supported });
+#endif
+#ifdef NANO_WORK_KERNEL_NEON
+	all.push_back ({ "neon", 2, compute_neon, always_supported });
+#endif
+#else
+	all.push_back ({ "reference", 1, compute_reference, always_supported });
+#endif
+	std::vector<nano::work_kernel> result;
+	std::copy_if (all.begin (), all.end (), std::back_inserter (result), [](nano::work_kernel const & kernel_a) {
+		debug_assert (kernel_a.lanes <= nano::work_kernel::max_lanes);
+		return kernel_a.supported ();
+	});
+	return result;
+}
+}
+
+std::vector<nano::work_kernel> const & nano::work_kernels ()
+{
+	static std::vector<nano::work_kernel> const kernels (available_kernels ());
+	return kernels;
+}
+
+nano::work_kernel const & nano::work_kernel_best ()
+{
+	auto const & kernels (nano::work_kernels ());
+	debug_assert (!kernels.empty ());
+	return *std::max_element (kernels.begin (), kernels.end (), [](nano::work_kernel const & a, nano::work_kernel const & b) {
+		return a.lanes < b.lanes;
+	});
+}
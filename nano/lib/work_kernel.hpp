@@ -0,0 +1,35 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+/**
+ * A CPU kernel computing work_v1 values (8 byte Blake2b of nonce || root) for several nonces at once.
+ * The input is always a single 40 byte Blake2b block, so kernels skip the generic init/update/final
+ * path and run one compression per nonce, vectorized across nonces where the CPU allows it.
+ */
+class work_kernel final
+{
+public:
+	/** Largest number of lanes of any kernel, callers can size buffers with this */
+	static size_t constexpr max_lanes = 8;
+	using function = void (*) (nano::root const &, uint64_t const *, uint64_t *);
+	std::string name;
+	/** Number of nonces consumed and values produced by each call */
+	size_t lanes;
+	function compute;
+	/** Runtime check whether the CPU supports the instructions used by this kernel */
+	bool (*supported) ();
+};
+
+/** All kernels compiled into this binary which are supported by the current CPU, scalar first */
+std::vector<nano::work_kernel> const & work_kernels ();
+/** The kernel with the most lanes from work_kernels () */
+nano::work_kernel const & work_kernel_best ();
+}
@@ -1,6 +1,7 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/cli.hpp>
 #include <nano/lib/utility.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/nano_node/daemon.hpp>
 #include <nano/node/cli.hpp>
 #include <nano/node/daemonconfig.hpp>
@@ -78,7 +79,7 @@ int main (int argc, char * const * argv)
 		("debug_dump_online_weight", "Dump online_weights table")
 		("debug_dump_representatives", "List representatives and weights")
 		("debug_account_count", "Display the number of accounts")
-		("debug_profile_generate", "Profile work generation")
+		("debug_profile_generate", "Profile work generation, after comparing the hash rate of each CPU work kernel")
 		("debug_profile_validate", "Profile work validation")
 		("debug_opencl", "OpenCL work generation")
 		("debug_profile_kdf", "Profile kdf function")
@@ -99,6 +100,7 @@ int main (int argc, char * const * argv)
 		("debug_stacktrace", "Display an example stacktrace")
 		("debug_account_versions", "Display the total counts of each version for all accounts (including unpocketed)")
 		("debug_unconfirmed_frontiers", "Displays the account, height (sorted), frontier and cemented frontier for all accounts which are not fully confirmed")
+		("debug_prune", "Prune accounts up to last confirmed blocks (EXPERIMENTAL)")
 		("validate_blocks,debug_validate_blocks", "Check all blocks for correct hash, signature, work value")
 		("platform", boost::program_options::value<std::string> (), "Defines the <platform> for OpenCL commands")
 		("device", boost::program_options::value<std::string> (), "Defines <device> for OpenCL command")
@@ -499,10 +501,34 @@ int main (int argc, char * const * argv)
 				pow_rate_limiter = std::chrono::nanoseconds (boost::lexical_cast<uint64_t> (pow_sleep_interval_it->second.as<std::string> ()));
 			}
 
+			// Compare single core hash rates of the CPU work kernels available on this machine
+			for (auto const & kernel : nano::work_kernels ())
+			{
+				std::array<uint64_t, nano::work_kernel::max_lanes> nonces{};
+				std::array<uint64_t, nano::work_kernel::max_lanes> outputs{};
+				nano::root root (1);
+				uint64_t hashes (0);
+				auto begin1 (std::chrono::steady_clock::now ());
+				auto end1 (begin1);
+				while (end1 - begin1 < std::chrono::seconds (1))
+				{
+					for (auto i (0); i < 1024; ++i)
+					{
+						nonces[0] += outputs[0] | 1;
+						kernel.compute (root, nonces.data (), outputs.data ());
+					}
+					hashes += 1024 * kernel.lanes;
+					end1 = std::chrono::steady_clock::now ();
+				}
+				auto seconds (std::chrono::duration_cast<std::chrono::duration<double>> (end1 - begin1).count ());
+				std::cerr << boost::str (boost::format ("Kernel %1% (%2% lanes): %3% Mhash/s per core\n") % kernel.name % kernel.lanes % nano::to_string (hashes / seconds / 1e6, 2));
+			}
+
 			nano::work_pool work (std::numeric_limits<unsigned>::max (), pow_rate_limiter);
 			nano::change_block block (0, 0, nano::keypair ().prv, 0, 0);
 			if (!result)
 			{
+				std::cerr << boost::str (boost::format ("Using kernel %1%\n") % work.kernel.name);
 				std::cerr << boost::str (boost::format ("Starting generation profiling. Difficulty: %1$#x (%2%x from base difficulty %3$#x)\n") % difficulty % nano::to_string (nano::difficulty::to_multiplier (difficulty, network_constants.publish_full.base), 4) % network_constants.publish_full.base);
 				while (!result)
 				{
@@ -875,7 +901,8 @@ int main (int argc, char * const * argv)
 			auto begin (std::chrono::high_resolution_clock::now ());
 			nano::validate_message_batch (messages.data (), lengths.data (), pub_keys.data (), signatures.data (), batch_count, verifications.data ());
 			auto end (std::chrono::high_resolution_clock::now ());
-			std::cerr << "Batch signature verifications " << std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count () << std::endl;
+			auto time (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
+			std::cerr << boost::str (boost::format ("Batch signature verifications %1% us, %2% signatures/s\n") % time % (batch_count * 1000000 / std::max<decltype (time)> (time, 1)));
 		}
 		else if (vm.count ("debug_profile_sign"))
 		{
@@ -1004,7 +1031,7 @@ int main (int argc, char * const * argv)
 				if (timer_l.after_deadline (std::chrono::seconds (15)))
 				{
 					timer_l.restart ();
-					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed (unchecked), %3% remaining") % node->ledger.cache.block_count % node->store.unchecked_count (node->store.tx_begin_read ()) % node->block_processor.size ()) << std::endl;
+					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed (unchecked), %3% remaining") % node->ledger.cache.block_count % node->unchecked.count (node->store.tx_begin_read ()) % node->block_processor.size ()) << std::endl;
 				}
 			}
 
@@ -1774,7 +1801,7 @@ int main (int argc, char * const * argv)
 								std::cout << boost::str (boost::format ("%1% blocks retrieved") % count) << std::endl;
 							}
 							nano::unchecked_info unchecked_info (block, account, 0, nano::signature_verification::unknown);
-							node.node->block_processor.add (unchecked_info);
+							node.node->block_processor.add (unchecked_info, nano::block_source::bootstrap);
 							if (block->type () == nano::block_type::state && block->previous ().is_zero () && source_node->ledger.is_epoch_link (block->link ()))
 							{
 								// Epoch open blocks can be rejected without processed pending blocks to account, push it later again
@@ -1795,14 +1822,14 @@ int main (int argc, char * const * argv)
 				{
 					for (auto & unchecked_info : epoch_open_blocks)
 					{
-						node.node->block_processor.add (unchecked_info);
+						node.node->block_processor.add (unchecked_info, nano::block_source::bootstrap);
 					}
 				}
 				// Message each 60 seconds
 				if (timer_l.after_deadline (std::chrono::seconds (60)))
 				{
 					timer_l.restart ();
-					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed (unchecked)") % node.node->ledger.cache.block_count % node.node->store.unchecked_count (node.node->store.tx_begin_read ())) << std::endl;
+					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed (unchecked)") % node.node->ledger.cache.block_count % node.node->unchecked.count (node.node->store.tx_begin_read ())) << std::endl;
 				}
 			}
 
@@ -1835,6 +1862,16 @@ int main (int argc, char * const * argv)
 			nano::inactive_node node (data_path, node_flags);
 			std::cout << "Total cemented block count: " << node.node->ledger.cache.cemented_count << std::endl;
 		}
+		else if (vm.count ("debug_prune"))
+		{
+			auto node_flags = nano::inactive_node_flag_defaults ();
+			node_flags.read_only = false;
+			nano::update_flags (node_flags, vm);
+			node_flags.enable_pruning = true;
+			nano::inactive_node inactive_node (data_path, node_flags);
+			auto node = inactive_node.node;
+			node->ledger_pruning (node_flags.block_processor_batch_size != 0 ? node_flags.block_processor_batch_size : 16 * 1024, true, true);
+		}
 		else if (vm.count ("debug_stacktrace"))
 		{
 			std::cout << boost::stacktrace::stacktrace ();
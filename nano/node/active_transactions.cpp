@@ -124,14 +124,14 @@ void nano::active_transactions::set_next_frontier_check (bool agressive_mode_a)
 
 void nano::active_transactions::confirm_prioritized_frontiers (nano::transaction const & transaction_a, uint64_t max_elections_a, uint64_t & elections_count_a)
 {
-	nano::unique_lock<std::mutex> lk (mutex);
+	nano::unique_lock<std::mutex> lk (frontiers_mutex);
 	auto start_elections_for_prioritized_frontiers = [&transaction_a, &elections_count_a, max_elections_a, &lk, this](prioritize_num_uncemented & cementable_frontiers) {
 		while (!cementable_frontiers.empty () && !this->stopped && elections_count_a < max_elections_a && optimistic_elections_count < max_optimistic ())
 		{
 			auto cementable_account_front_it = cementable_frontiers.get<tag_uncemented> ().begin ();
 			auto cementable_account = *cementable_account_front_it;
 			cementable_frontiers.get<tag_uncemented> ().erase (cementable_account_front_it);
-			if (expired_optimistic_election_infos.get<tag_account> ().count (cementable_account.account) == 0)
+			if (!this->expired_optimistic_election_exists (cementable_account.account))
 			{
 				lk.unlock ();
 				nano::account_info info;
@@ -387,6 +387,7 @@ void nano::active_transactions::add_expired_optimistic_election (nano::election
 		account = election_a.status.winner->sideband ().account;
 	}
 
+	nano::lock_guard<std::mutex> guard (expired_optimistic_election_infos_mutex);
 	auto it = expired_optimistic_election_infos.get<tag_account> ().find (account);
 	if (it != expired_optimistic_election_infos.get<tag_account> ().end ())
 	{
@@ -414,6 +415,12 @@ unsigned nano::active_transactions::max_optimistic ()
 	return node.ledger.cache.cemented_count < node.ledger.bootstrap_weight_max_blocks ? std::numeric_limits<unsigned>::max () : 50u;
 }
 
+bool nano::active_transactions::expired_optimistic_election_exists (nano::account const & account_a)
+{
+	nano::lock_guard<std::mutex> guard (expired_optimistic_election_infos_mutex);
+	return expired_optimistic_election_infos.get<tag_account> ().count (account_a) != 0;
+}
+
 void nano::active_transactions::frontiers_confirmation (nano::unique_lock<std::mutex> & lock_a)
 {
 	// Spend some time prioritizing accounts with the most uncemented blocks to reduce voting traffic
@@ -450,15 +457,25 @@ void nano::active_transactions::confirm_expired_frontiers_pessimistically (nano:
 	nano::confirmation_height_info confirmation_height_info;
 
 	// Loop through any expired optimistic elections which have not been started yet. This tag stores already started ones first
+	// The accounts are copied out so that elections are started without holding expired_optimistic_election_infos_mutex
+	std::vector<nano::account> not_started_accounts;
+	{
+		nano::lock_guard<std::mutex> guard (expired_optimistic_election_infos_mutex);
+		auto & by_election_started (expired_optimistic_election_infos.get<tag_election_started> ());
+		for (auto i = by_election_started.lower_bound (false), n = by_election_started.end (); i != n; ++i)
+		{
+			not_started_accounts.push_back (i->account);
+		}
+	}
 	std::vector<nano::account> elections_started_for_account;
-	for (auto i = expired_optimistic_election_infos.get<tag_election_started> ().lower_bound (false); i != expired_optimistic_election_infos.get<tag_election_started> ().end ();)
+	std::vector<nano::account> accounts_to_delete;
+	for (auto const & account : not_started_accounts)
 	{
 		if (stopped || elections_count_a >= max_elections_a)
 		{
 			break;
 		}
 
-		auto const & account{ i->account };
 		nano::account_info account_info;
 		bool should_delete{ true };
 		if (!node.store.account_get (transaction_a, account, account_info) && !node.store.confirmation_height_get (transaction_a, account, confirmation_height_info))
@@ -491,7 +508,7 @@ void nano::active_transactions::confirm_expired_frontiers_pessimistically (nano:
 					{
 						++elections_count_a;
 					}
-					elections_started_for_account.push_back (i->account);
+					elections_started_for_account.push_back (account);
 				}
 			}
 		}
@@ -499,23 +516,27 @@ void nano::active_transactions::confirm_expired_frontiers_pessimistically (nano:
 		if (should_delete)
 		{
 			// This account is confirmed already or doesn't exist.
-			i = expired_optimistic_election_infos.get<tag_election_started> ().erase (i);
-			expired_optimistic_election_infos_size = expired_optimistic_election_infos.size ();
-		}
-		else
-		{
-			++i;
+			accounts_to_delete.push_back (account);
 		}
 	}
 
+	nano::lock_guard<std::mutex> guard (expired_optimistic_election_infos_mutex);
+	auto & by_account (expired_optimistic_election_infos.get<tag_account> ());
+	for (auto const & account : accounts_to_delete)
+	{
+		by_account.erase (account);
+	}
 	for (auto const & account : elections_started_for_account)
 	{
-		auto it = expired_optimistic_election_infos.get<tag_account> ().find (account);
-		debug_assert (it != expired_optimistic_election_infos.get<tag_account> ().end ());
-		expired_optimistic_election_infos.get<tag_account> ().modify (it, [](auto & expired_optimistic_election_info_a) {
-			expired_optimistic_election_info_a.election_started = true;
-		});
+		auto it = by_account.find (account);
+		if (it != by_account.end ())
+		{
+			by_account.modify (it, [](auto & expired_optimistic_election_info_a) {
+				expired_optimistic_election_info_a.election_started = true;
+			});
+		}
 	}
+	expired_optimistic_election_infos_size = expired_optimistic_election_infos.size ();
 }
 
 bool nano::active_transactions::should_do_frontiers_confirmation () const
@@ -579,7 +600,7 @@ bool nano::active_transactions::prioritize_account_for_confirmation (nano::activ
 	if (info_a.block_count > confirmation_height_a && !confirmation_height_processor.is_processing_block (info_a.head))
 	{
 		auto num_uncemented = info_a.block_count - confirmation_height_a;
-		nano::lock_guard<std::mutex> guard (mutex);
+		nano::lock_guard<std::mutex> guard (frontiers_mutex);
 		auto it = cementable_frontiers_a.get<tag_account> ().find (account_a);
 		if (it != cementable_frontiers_a.get<tag_account> ().end ())
 		{
@@ -625,16 +646,19 @@ void nano::active_transactions::prioritize_frontiers_for_confirmation (nano::tra
 		size_t priority_cementable_frontiers_size;
 		size_t priority_wallet_cementable_frontiers_size;
 		{
-			nano::lock_guard<std::mutex> guard (mutex);
+			nano::lock_guard<std::mutex> guard (frontiers_mutex);
 			priority_cementable_frontiers_size = priority_cementable_frontiers.size ();
 			priority_wallet_cementable_frontiers_size = priority_wallet_cementable_frontiers.size ();
 		}
 
 		nano::timer<std::chrono::milliseconds> wallet_account_timer (nano::timer_state::started);
 		// Remove any old expired optimistic elections so they are no longer excluded in subsequent checks
-		auto expired_cutoff_it (expired_optimistic_election_infos.get<tag_expired_time> ().lower_bound (std::chrono::steady_clock::now () - expired_optimistic_election_info_cutoff));
-		expired_optimistic_election_infos.get<tag_expired_time> ().erase (expired_optimistic_election_infos.get<tag_expired_time> ().begin (), expired_cutoff_it);
-		expired_optimistic_election_infos_size = expired_optimistic_election_infos.size ();
+		{
+			nano::lock_guard<std::mutex> guard (expired_optimistic_election_infos_mutex);
+			auto expired_cutoff_it (expired_optimistic_election_infos.get<tag_expired_time> ().lower_bound (std::chrono::steady_clock::now () - expired_optimistic_election_info_cutoff));
+			expired_optimistic_election_infos.get<tag_expired_time> ().erase (expired_optimistic_election_infos.get<tag_expired_time> ().begin (), expired_cutoff_it);
+			expired_optimistic_election_infos_size = expired_optimistic_election_infos.size ();
+		}
 
 		auto num_new_inserted{ 0u };
 		auto should_iterate = [this, &num_new_inserted]() {
@@ -673,13 +697,13 @@ void nano::active_transactions::prioritize_frontiers_for_confirmation (nano::tra
 					for (; i != n && should_iterate (); ++i)
 					{
 						auto const & account (i->first);
-						if (expired_optimistic_election_infos.get<tag_account> ().count (account) == 0 && !node.store.account_get (transaction_a, account, info) && !node.store.confirmation_height_get (transaction_a, account, confirmation_height_info))
+						if (!expired_optimistic_election_exists (account) && !node.store.account_get (transaction_a, account, info) && !node.store.confirmation_height_get (transaction_a, account, confirmation_height_info))
 						{
 							// If it exists in normal priority collection delete from there.
 							auto it = priority_cementable_frontiers.find (account);
 							if (it != priority_cementable_frontiers.end ())
 							{
-								nano::lock_guard<std::mutex> guard (mutex);
+								nano::lock_guard<std::mutex> guard (frontiers_mutex);
 								priority_cementable_frontiers.erase (it);
 								priority_cementable_frontiers_size = priority_cementable_frontiers.size ();
 							}
@@ -724,7 +748,7 @@ void nano::active_transactions::prioritize_frontiers_for_confirmation (nano::tra
 			auto const & info (i->second);
 			if (priority_wallet_cementable_frontiers.find (account) == priority_wallet_cementable_frontiers.end ())
 			{
-				if (expired_optimistic_election_infos.get<tag_account> ().count (account) == 0 && !node.store.confirmation_height_get (transaction_a, account, confirmation_height_info))
+				if (!expired_optimistic_election_exists (account) && !node.store.confirmation_height_get (transaction_a, account, confirmation_height_info))
 				{
 					auto insert_newed = prioritize_account_for_confirmation (priority_cementable_frontiers, priority_cementable_frontiers_size, account, info, confirmation_height_info.height);
 					if (insert_newed)
@@ -778,7 +802,12 @@ nano::election_insertion_result nano::active_transactions::insert_impl (std::sha
 		auto existing (roots.get<tag_root> ().find (root));
 		if (existing == roots.get<tag_root> ().end ())
 		{
-			if (recently_confirmed.get<tag_root> ().find (root) == recently_confirmed.get<tag_root> ().end ())
+			bool recently_confirmed_l;
+			{
+				nano::lock_guard<std::mutex> guard (recently_confirmed_mutex);
+				recently_confirmed_l = recently_confirmed.get<tag_root> ().find (root) != recently_confirmed.get<tag_root> ().end ();
+			}
+			if (!recently_confirmed_l)
 			{
 				result.inserted = true;
 				auto hash (block_a->hash ());
@@ -832,12 +861,13 @@ nano::vote_code nano::active_transactions::vote (std::shared_ptr<nano::vote> vot
 	unsigned recently_confirmed_counter (0);
 	bool replay (false);
 	bool processed (false);
+	// Hashes without an active election, resolved against recently_confirmed and the inactive votes cache after releasing mutex
+	std::vector<nano::block_hash> inactive;
 	{
 		nano::lock_guard<std::mutex> lock (mutex);
 		for (auto vote_block : vote_a->blocks)
 		{
 			nano::election_vote_result result;
-			auto & recently_confirmed_by_hash (recently_confirmed.get<tag_hash> ());
 			if (vote_block.which ())
 			{
 				auto block_hash (boost::get<nano::block_hash> (vote_block));
@@ -847,13 +877,9 @@ nano::vote_code nano::active_transactions::vote (std::shared_ptr<nano::vote> vot
 					at_least_one = true;
 					result = existing->second->vote (vote_a->account, vote_a->sequence, block_hash);
 				}
-				else if (recently_confirmed_by_hash.count (block_hash) == 0)
-				{
-					add_inactive_votes_cache (block_hash, vote_a->account);
-				}
 				else
 				{
-					++recently_confirmed_counter;
+					inactive.push_back (block_hash);
 				}
 			}
 			else
@@ -865,19 +891,55 @@ nano::vote_code nano::active_transactions::vote (std::shared_ptr<nano::vote> vot
 					at_least_one = true;
 					result = existing->election->vote (vote_a->account, vote_a->sequence, block->hash ());
 				}
-				else if (recently_confirmed_by_hash.count (block->hash ()) == 0)
-				{
-					add_inactive_votes_cache (block->hash (), vote_a->account);
-				}
 				else
 				{
-					++recently_confirmed_counter;
+					inactive.push_back (block->hash ());
 				}
 			}
 			processed = processed || result.processed;
 			replay = replay || result.replay;
 		}
 	}
+	if (!inactive.empty ())
+	{
+		{
+			nano::lock_guard<std::mutex> guard (recently_confirmed_mutex);
+			auto & recently_confirmed_by_hash (recently_confirmed.get<tag_hash> ());
+			inactive.erase (std::remove_if (inactive.begin (), inactive.end (), [&recently_confirmed_by_hash, &recently_confirmed_counter](nano::block_hash const & hash_a) {
+				auto confirmed (recently_confirmed_by_hash.count (hash_a) != 0);
+				recently_confirmed_counter += confirmed;
+				return confirmed;
+			}),
+			inactive.end ());
+		}
+		// Elections inserted after mutex was released take the vote directly. Hashes still inactive are cached and checked once more,
+		// an election inserted before the cache entry existed would otherwise never see the vote
+		auto apply_to_active = [this, &vote_a, &at_least_one, &processed, &replay](std::vector<nano::block_hash> & hashes_a) {
+			nano::lock_guard<std::mutex> lock (mutex);
+			hashes_a.erase (std::remove_if (hashes_a.begin (), hashes_a.end (), [this, &vote_a, &at_least_one, &processed, &replay](nano::block_hash const & hash_a) {
+				auto existing (blocks.find (hash_a));
+				auto active (existing != blocks.end ());
+				if (active)
+				{
+					at_least_one = true;
+					auto result (existing->second->vote (vote_a->account, vote_a->sequence, hash_a));
+					processed = processed || result.processed;
+					replay = replay || result.replay;
+				}
+				return active;
+			}),
+			hashes_a.end ());
+		};
+		apply_to_active (inactive);
+		if (!inactive.empty ())
+		{
+			for (auto const & hash : inactive)
+			{
+				add_inactive_votes_cache (hash, vote_a->account);
+			}
+			apply_to_active (inactive);
+		}
+	}
 
 	if (at_least_one)
 	{
@@ -1008,7 +1070,18 @@ bool nano::active_transactions::restart (std::shared_ptr<nano::block> const & bl
 			{
 				// Re-writing the block is necessary to avoid the same work being received later to force restarting the election
 				// The existing block is re-written, not the arriving block, as that one might not have gone through a full signature check
-				ledger_block->block_work_set (block_a->block_work ());
+				// Blocks from the store can be shared with its block cache, so the work is set on a copy
+				std::vector<uint8_t> bytes;
+				{
+					nano::vectorstream stream (bytes);
+					nano::serialize_block (stream, *ledger_block);
+				}
+				nano::bufferstream stream (bytes.data (), bytes.size ());
+				auto upgraded_block (nano::deserialize_block (stream));
+				debug_assert (upgraded_block != nullptr);
+				upgraded_block->sideband_set (ledger_block->sideband ());
+				upgraded_block->block_work_set (block_a->block_work ());
+				ledger_block = upgraded_block;
 
 				auto block_count = node.ledger.cache.block_count.load ();
 				node.store.block_put (transaction_a, hash, *ledger_block);
@@ -1146,12 +1219,13 @@ double nano::active_transactions::active_multiplier ()
 
 std::deque<nano::election_status> nano::active_transactions::list_recently_cemented ()
 {
-	nano::lock_guard<std::mutex> lock (mutex);
+	nano::lock_guard<std::mutex> lock (recently_confirmed_mutex);
 	return recently_cemented;
 }
 
 void nano::active_transactions::add_recently_cemented (nano::election_status const & status_a)
 {
+	nano::lock_guard<std::mutex> guard (recently_confirmed_mutex);
 	recently_cemented.push_back (status_a);
 	if (recently_cemented.size () > node.config.confirmation_history_size)
 	{
@@ -1161,6 +1235,7 @@ void nano::active_transactions::add_recently_cemented (nano::election_status con
 
 void nano::active_transactions::add_recently_confirmed (nano::qualified_root const & root_a, nano::block_hash const & hash_a)
 {
+	nano::lock_guard<std::mutex> guard (recently_confirmed_mutex);
 	recently_confirmed.get<tag_sequence> ().emplace_back (root_a, hash_a);
 	if (recently_confirmed.size () > recently_confirmed_size)
 	{
@@ -1170,7 +1245,7 @@ void nano::active_transactions::add_recently_confirmed (nano::qualified_root con
 
 void nano::active_transactions::erase_recently_confirmed (nano::block_hash const & hash_a)
 {
-	nano::lock_guard<std::mutex> guard (mutex);
+	nano::lock_guard<std::mutex> guard (recently_confirmed_mutex);
 	recently_confirmed.get<tag_hash> ().erase (hash_a);
 }
 
@@ -1258,13 +1333,13 @@ boost::optional<nano::election_status_type> nano::active_transactions::confirm_b
 
 size_t nano::active_transactions::priority_cementable_frontiers_size ()
 {
-	nano::lock_guard<std::mutex> guard (mutex);
+	nano::lock_guard<std::mutex> guard (frontiers_mutex);
 	return priority_cementable_frontiers.size ();
 }
 
 size_t nano::active_transactions::priority_wallet_cementable_frontiers_size ()
 {
-	nano::lock_guard<std::mutex> guard (mutex);
+	nano::lock_guard<std::mutex> guard (frontiers_mutex);
 	return priority_wallet_cementable_frontiers.size ();
 }
 
@@ -1276,7 +1351,7 @@ boost::circular_buffer<double> nano::active_transactions::difficulty_trend ()
 
 size_t nano::active_transactions::inactive_votes_cache_size ()
 {
-	nano::lock_guard<std::mutex> guard (mutex);
+	nano::lock_guard<std::mutex> guard (inactive_votes_cache_mutex);
 	return inactive_votes_cache.size ();
 }
 
@@ -1285,48 +1360,53 @@ void nano::active_transactions::add_inactive_votes_cache (nano::block_hash const
 	// Check principal representative status
 	if (node.ledger.weight (representative_a) > node.minimum_principal_weight ())
 	{
-		auto & inactive_by_hash (inactive_votes_cache.get<tag_hash> ());
-		auto existing (inactive_by_hash.find (hash_a));
-		if (existing != inactive_by_hash.end ())
+		nano::inactive_cache_status previously;
+		nano::inactive_cache_status status;
 		{
-			if (existing->needs_eval ())
+			nano::lock_guard<std::mutex> guard (inactive_votes_cache_mutex);
+			auto & inactive_by_hash (inactive_votes_cache.get<tag_hash> ());
+			auto existing (inactive_by_hash.find (hash_a));
+			if (existing != inactive_by_hash.end ())
 			{
-				auto is_new (false);
-				inactive_by_hash.modify (existing, [representative_a, &is_new](nano::inactive_cache_information & info) {
-					auto it = std::find (info.voters.begin (), info.voters.end (), representative_a);
-					is_new = (it == info.voters.end ());
-					if (is_new)
-					{
-						info.arrival = std::chrono::steady_clock::now ();
-						info.voters.push_back (representative_a);
-					}
-				});
-
-				if (is_new)
+				previously = status = existing->status;
+				if (existing->needs_eval ())
 				{
-					auto const status = inactive_votes_bootstrap_check (existing->voters, hash_a, existing->status);
-					if (status != existing->status)
+					auto is_new (false);
+					inactive_by_hash.modify (existing, [representative_a, &is_new](nano::inactive_cache_information & info) {
+						auto it = std::find (info.voters.begin (), info.voters.end (), representative_a);
+						is_new = (it == info.voters.end ());
+						if (is_new)
+						{
+							info.arrival = std::chrono::steady_clock::now ();
+							info.voters.push_back (representative_a);
+						}
+					});
+
+					if (is_new)
 					{
-						// The iterator is only valid if the container was unchanged, e.g., by erasing this item after inserting an election
-						debug_assert (inactive_by_hash.count (hash_a));
-						inactive_by_hash.modify (existing, [status](nano::inactive_cache_information & info) {
-							info.status = status;
-						});
+						status = inactive_votes_bootstrap_check (existing->voters, previously);
+						if (status != previously)
+						{
+							inactive_by_hash.modify (existing, [status](nano::inactive_cache_information & info) {
+								info.status = status;
+							});
+						}
 					}
 				}
 			}
-		}
-		else
-		{
-			std::vector<nano::account> representative_vector{ representative_a };
-			auto const status (inactive_votes_bootstrap_check (representative_vector, hash_a, {}));
-			auto & inactive_by_arrival (inactive_votes_cache.get<tag_arrival> ());
-			inactive_by_arrival.emplace (nano::inactive_cache_information{ std::chrono::steady_clock::now (), hash_a, representative_vector, status });
-			if (inactive_votes_cache.size () > node.flags.inactive_votes_cache_size)
+			else
 			{
-				inactive_by_arrival.erase (inactive_by_arrival.begin ());
+				std::vector<nano::account> representative_vector{ representative_a };
+				status = inactive_votes_bootstrap_check (representative_vector, previously);
+				auto & inactive_by_arrival (inactive_votes_cache.get<tag_arrival> ());
+				inactive_by_arrival.emplace (nano::inactive_cache_information{ std::chrono::steady_clock::now (), hash_a, representative_vector, status });
+				if (inactive_votes_cache.size () > node.flags.inactive_votes_cache_size)
+				{
+					inactive_by_arrival.erase (inactive_by_arrival.begin ());
+				}
 			}
 		}
+		inactive_votes_bootstrap_start (hash_a, previously, status);
 	}
 }
 
@@ -1342,6 +1422,7 @@ void nano::active_transactions::trigger_inactive_votes_cache_election (std::shar
 
 nano::inactive_cache_information nano::active_transactions::find_inactive_votes_cache (nano::block_hash const & hash_a)
 {
+	nano::lock_guard<std::mutex> guard (inactive_votes_cache_mutex);
 	auto & inactive_by_hash (inactive_votes_cache.get<tag_hash> ());
 	auto existing (inactive_by_hash.find (hash_a));
 	if (existing != inactive_by_hash.end ())
@@ -1356,10 +1437,11 @@ nano::inactive_cache_information nano::active_transactions::find_inactive_votes_
 
 void nano::active_transactions::erase_inactive_votes_cache (nano::block_hash const & hash_a)
 {
+	nano::lock_guard<std::mutex> guard (inactive_votes_cache_mutex);
 	inactive_votes_cache.get<tag_hash> ().erase (hash_a);
 }
 
-nano::inactive_cache_status nano::active_transactions::inactive_votes_bootstrap_check (std::vector<nano::account> const & voters_a, nano::block_hash const & hash_a, nano::inactive_cache_status const & previously_a)
+nano::inactive_cache_status nano::active_transactions::inactive_votes_bootstrap_check (std::vector<nano::account> const & voters_a, nano::inactive_cache_status const & previously_a)
 {
 	/** Perform checks on accumulated tally from inactive votes
 	 * These votes are generally either for unconfirmed blocks or old confirmed blocks
@@ -1386,24 +1468,27 @@ nano::inactive_cache_status nano::active_transactions::inactive_votes_bootstrap_
 	{
 		status.election_started = true;
 	}
+	return status;
+}
 
-	if ((status.election_started && !previously_a.election_started) || (status.bootstrap_started && !previously_a.bootstrap_started))
+void nano::active_transactions::inactive_votes_bootstrap_start (nano::block_hash const & hash_a, nano::inactive_cache_status const & previously_a, nano::inactive_cache_status const & status_a)
+{
+	if ((status_a.election_started && !previously_a.election_started) || (status_a.bootstrap_started && !previously_a.bootstrap_started))
 	{
 		auto transaction (node.store.tx_begin_read ());
 		auto block = node.store.block_get (transaction, hash_a);
-		if (block && status.election_started && !previously_a.election_started && !node.block_confirmed_or_being_confirmed (transaction, hash_a))
+		if (block && status_a.election_started && !previously_a.election_started && !node.block_confirmed_or_being_confirmed (transaction, hash_a))
 		{
 			if (node.ledger.cache.cemented_count >= node.ledger.bootstrap_weight_max_blocks)
 			{
-				insert_impl (block);
+				insert (block);
 			}
 		}
-		else if (!block && status.bootstrap_started && !previously_a.bootstrap_started)
+		else if (!block && status_a.bootstrap_started && !previously_a.bootstrap_started)
 		{
 			node.gap_cache.bootstrap_start (hash_a);
 		}
 	}
-	return status;
 }
 
 size_t nano::active_transactions::election_winner_details_size ()
@@ -1439,6 +1524,9 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (ac
 		nano::lock_guard<std::mutex> guard (active_transactions.mutex);
 		roots_count = active_transactions.roots.size ();
 		blocks_count = active_transactions.blocks.size ();
+	}
+	{
+		nano::lock_guard<std::mutex> guard (active_transactions.recently_confirmed_mutex);
 		recently_confirmed_count = active_transactions.recently_confirmed.size ();
 		recently_cemented_count = active_transactions.recently_cemented.size ();
 	}
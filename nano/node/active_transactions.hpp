@@ -130,6 +130,9 @@ public:
 
 // Core class for determining consensus
 // Holds all active blocks i.e. recently added blocks that need confirmation
+// Elections are guarded by mutex, while the recently confirmed set, the inactive votes cache and frontier prioritization have their own locks
+// Lock order is mutex before any of recently_confirmed_mutex, inactive_votes_cache_mutex or election_winner_details_mutex,
+// frontiers_mutex before expired_optimistic_election_infos_mutex, which is taken last
 class active_transactions final
 {
 	class conflict_info final
@@ -212,6 +215,7 @@ public:
 	void add_recently_cemented (nano::election_status const &);
 	void add_recently_confirmed (nano::qualified_root const &, nano::block_hash const &);
 	void erase_recently_confirmed (nano::block_hash const &);
+	// May start an election, must be called without holding mutex
 	void add_inactive_votes_cache (nano::block_hash const &, nano::account const &);
 	// Inserts an election if conditions are met
 	void trigger_inactive_votes_cache_election (std::shared_ptr<nano::block> const &);
@@ -219,6 +223,7 @@ public:
 	void erase_inactive_votes_cache (nano::block_hash const &);
 	nano::confirmation_height_processor & confirmation_height_processor;
 	nano::node & node;
+	// Protects roots, blocks and the state of the elections they hold
 	mutable std::mutex mutex;
 	boost::circular_buffer<double> multipliers_cb;
 	std::atomic<double> trended_active_multiplier;
@@ -261,6 +266,8 @@ private:
 	size_t const prioritized_cutoff;
 
 	static size_t constexpr recently_confirmed_size{ 65536 };
+	// Protects recently_confirmed and recently_cemented
+	mutable std::mutex recently_confirmed_mutex;
 	using recent_confirmation = std::pair<nano::qualified_root, nano::block_hash>;
 	// clang-format off
 	boost::multi_index_container<recent_confirmation,
@@ -289,7 +296,10 @@ private:
 			mi::member<expired_optimistic_election_info, bool, &expired_optimistic_election_info::election_started>, std::greater<bool>>>>
 	expired_optimistic_election_infos;
 	// clang-format on
+	// Protects expired_optimistic_election_infos, never held while starting elections
+	std::mutex expired_optimistic_election_infos_mutex;
 	std::atomic<uint64_t> expired_optimistic_election_infos_size{ 0 };
+	bool expired_optimistic_election_exists (nano::account const &);
 
 	// Frontiers confirmation
 	nano::frontiers_confirmation_info get_frontiers_confirmation_info ();
@@ -300,6 +310,8 @@ private:
 	nano::account next_frontier_account{ 0 };
 	std::chrono::steady_clock::time_point next_frontier_check{ std::chrono::steady_clock::now () };
 	constexpr static size_t max_active_elections_frontier_insertion{ 1000 };
+	// Protects priority_wallet_cementable_frontiers and priority_cementable_frontiers, not expired_optimistic_election_infos
+	std::mutex frontiers_mutex;
 	prioritize_num_uncemented priority_wallet_cementable_frontiers;
 	prioritize_num_uncemented priority_cementable_frontiers;
 	std::unordered_set<nano::wallet_id> wallet_ids_already_iterated;
@@ -324,7 +336,10 @@ private:
 			mi::member<nano::inactive_cache_information, nano::block_hash, &nano::inactive_cache_information::hash>>>>;
 	ordered_cache inactive_votes_cache;
 	// clang-format on
-	nano::inactive_cache_status inactive_votes_bootstrap_check (std::vector<nano::account> const &, nano::block_hash const &, nano::inactive_cache_status const &);
+	std::mutex inactive_votes_cache_mutex;
+	nano::inactive_cache_status inactive_votes_bootstrap_check (std::vector<nano::account> const &, nano::inactive_cache_status const &);
+	// Starts an election or a bootstrap attempt for \p hash_a when the inactive votes cache status newly requires it, must be called without holding any active_transactions lock
+	void inactive_votes_bootstrap_start (nano::block_hash const &, nano::inactive_cache_status const &, nano::inactive_cache_status const &);
 	boost::thread thread;
 
 	friend class election;
@@ -8,7 +8,38 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <unordered_map>
+
 std::chrono::milliseconds constexpr nano::block_processor::confirmation_request_delay;
+size_t constexpr nano::block_processor::lane_count;
+size_t constexpr nano::block_processor::validation_batch_size;
+
+namespace
+{
+nano::stat::detail to_stat_detail (nano::block_source const source_a)
+{
+	nano::stat::detail result (nano::stat::detail::all);
+	switch (source_a)
+	{
+		case nano::block_source::local:
+			result = nano::stat::detail::local;
+			break;
+		case nano::block_source::live:
+			result = nano::stat::detail::live;
+			break;
+		case nano::block_source::bootstrap:
+			result = nano::stat::detail::bootstrap;
+			break;
+		case nano::block_source::unchecked:
+			result = nano::stat::detail::unchecked;
+			break;
+	}
+	return result;
+}
+}
 
 nano::block_post_events::~block_post_events ()
 {
@@ -20,11 +51,16 @@ nano::block_post_events::~block_post_events ()
 
 nano::block_processor::block_processor (nano::node & node_a, nano::write_database_queue & write_database_queue_a) :
 next_log (std::chrono::steady_clock::now ()),
+priorities{ { node_a.config.block_processor_priority_local, node_a.config.block_processor_priority_live, node_a.config.block_processor_priority_bootstrap, node_a.config.block_processor_priority_unchecked } },
 node (node_a),
 write_database_queue (write_database_queue_a),
-state_block_signature_verification (node.checker, node.ledger.network_params.ledger.epochs, node.config, node.logger, node.flags.block_processor_verification_size)
+state_block_signature_verification (node.signature_pipeline, node.ledger.network_params.ledger.epochs, node.config, node.logger, node.flags.block_processor_verification_size),
+validation_thread ([this]() {
+	nano::thread_role::set (nano::thread_role::name::block_validation);
+	this->process_validation ();
+})
 {
-	state_block_signature_verification.blocks_verified_callback = [this](std::deque<nano::unchecked_info> & items, std::vector<int> const & verifications, std::vector<nano::block_hash> const & hashes, std::vector<nano::signature> const & blocks_signatures) {
+	state_block_signature_verification.blocks_verified_callback = [this](std::deque<nano::block_processor_item> & items, std::vector<int> const & verifications, std::vector<nano::block_hash> const & hashes, std::vector<nano::signature> const & blocks_signatures) {
 		this->process_verified_state_blocks (items, verifications, hashes, blocks_signatures);
 	};
 	state_block_signature_verification.transition_inactive_callback = [this]() {
@@ -52,6 +88,19 @@ void nano::block_processor::stop ()
 	}
 	condition.notify_all ();
 	state_block_signature_verification.stop ();
+	if (validation_thread.joinable ())
+	{
+		validation_thread.join ();
+	}
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		// Nothing queued is processed once stopped, dropping it releases callers waiting in add_blocking
+		for (auto & lane : lanes)
+		{
+			lane.clear ();
+		}
+		validated.clear ();
+	}
 }
 
 void nano::block_processor::flush ()
@@ -69,14 +118,27 @@ void nano::block_processor::flush ()
 size_t nano::block_processor::size ()
 {
 	nano::unique_lock<std::mutex> lock (mutex);
-	return (blocks.size () + state_block_signature_verification.size () + forced.size ());
+	size_t result (state_block_signature_verification.size () + validating + validated.size () + forced.size ());
+	for (auto const & lane : lanes)
+	{
+		result += lane.size ();
+	}
+	return result;
 }
 
+/*
+ * Admission check for live blocks. Bootstrap blocks are left out, a bootstrap backlog must not cause live blocks to be dropped,
+ * the bootstrap lanes are throttled separately through half_full.
+ */
 bool nano::block_processor::full ()
 {
-	return size () >= node.flags.block_processor_full_size;
+	auto size_l (size ());
+	return size_l - std::min<size_t> (bootstrap_count, size_l) >= node.flags.block_processor_full_size;
 }
 
+/*
+ * Admission check for bootstrap, which backs off as soon as blocks from any source fill half the queue.
+ */
 bool nano::block_processor::half_full ()
 {
 	return size () >= node.flags.block_processor_full_size / 2;
@@ -88,33 +150,89 @@ void nano::block_processor::add (std::shared_ptr<nano::block> block_a, uint64_t
 	add (info);
 }
 
-void nano::block_processor::add (nano::unchecked_info const & info_a, const bool push_front_preference_a)
+void nano::block_processor::add (nano::unchecked_info const & info_a, nano::block_source const source_a)
 {
 	debug_assert (!nano::work_validate_entry (*info_a.block));
-	bool quarter_full (size () > node.flags.block_processor_full_size / 4);
+	node.stats.inc (nano::stat::type::block_processor, to_stat_detail (source_a), nano::stat::dir::in);
+	if (source_a == nano::block_source::bootstrap)
+	{
+		++bootstrap_count;
+	}
+	nano::block_processor_item item{ info_a, source_a, std::chrono::steady_clock::now () };
 	if (info_a.verified == nano::signature_verification::unknown && (info_a.block->type () == nano::block_type::state || info_a.block->type () == nano::block_type::open || !info_a.account.is_zero ()))
 	{
-		state_block_signature_verification.add (info_a);
+		state_block_signature_verification.add (item);
 	}
-	else if (push_front_preference_a && !quarter_full)
+	else
 	{
-		/* Push blocks from unchecked to front of processing deque to keep more operations with unchecked inside of single write transaction.
-		It's designed to help with realtime blocks traffic if block processor is not performing large task like bootstrap.
-		If deque is a quarter full then push back to allow other blocks processing. */
 		{
 			nano::lock_guard<std::mutex> guard (mutex);
-			blocks.push_front (info_a);
+			queue (item);
 		}
 		condition.notify_all ();
 	}
-	else
+}
+
+/*
+ * Queues the block on the local lane and waits until the batch holding it is committed, so the caller can build on it.
+ * The signature is checked by the validation stage. Returns no result if the block processor stopped before processing it.
+ */
+boost::optional<nano::process_return> nano::block_processor::add_blocking (nano::unchecked_info const & info_a, bool const watch_work_a)
+{
+	debug_assert (!nano::work_validate_entry (*info_a.block));
+	node.stats.inc (nano::stat::type::block_processor, nano::stat::detail::local, nano::stat::dir::in);
+	boost::optional<nano::process_return> result;
+	std::future<nano::process_return> future;
 	{
+		// Only the queued item keeps the promise, dropping the item unprocessed breaks it
+		auto promise (std::make_shared<std::promise<nano::process_return>> ());
+		future = promise->get_future ();
+		nano::lock_guard<std::mutex> guard (mutex);
+		if (!stopped)
 		{
-			nano::lock_guard<std::mutex> guard (mutex);
-			blocks.push_back (info_a);
+			queue ({ info_a, nano::block_source::local, std::chrono::steady_clock::now (), [promise](nano::process_return const & result_a) { promise->set_value (result_a); }, watch_work_a });
 		}
-		condition.notify_all ();
 	}
+	condition.notify_all ();
+	try
+	{
+		result = future.get ();
+	}
+	catch (std::future_error const &)
+	{
+	}
+	return result;
+}
+
+void nano::block_processor::queue (nano::block_processor_item const & item_a)
+{
+	debug_assert (!mutex.try_lock ());
+	lanes[static_cast<size_t> (item_a.source)].push_back (item_a);
+}
+
+bool nano::block_processor::have_queued () const
+{
+	return std::any_of (lanes.begin (), lanes.end (), [](auto const & lane_a) { return !lane_a.empty (); });
+}
+
+/*
+ * Weighted round robin over the lanes: up to priorities[lane] blocks are taken from a lane before moving on,
+ * empty lanes are skipped. A bootstrap backlog therefore delays live blocks by at most a few blocks.
+ */
+nano::block_processor_item nano::block_processor::next ()
+{
+	debug_assert (!mutex.try_lock ());
+	debug_assert (have_queued ());
+	while (lanes[current_lane].empty () || lane_credit == 0)
+	{
+		current_lane = (current_lane + 1) % lane_count;
+		lane_credit = priorities[current_lane];
+	}
+	--lane_credit;
+	auto & lane (lanes[current_lane]);
+	auto result (std::move (lane.front ()));
+	lane.pop_front ();
+	return result;
 }
 
 void nano::block_processor::force (std::shared_ptr<nano::block> block_a)
@@ -137,7 +255,7 @@ void nano::block_processor::process_blocks ()
 	nano::unique_lock<std::mutex> lock (mutex);
 	while (!stopped)
 	{
-		if (!blocks.empty () || !forced.empty ())
+		if (!validated.empty () || !forced.empty ())
 		{
 			active = true;
 			lock.unlock ();
@@ -147,7 +265,7 @@ void nano::block_processor::process_blocks ()
 		}
 		else
 		{
-			condition.notify_one ();
+			condition.notify_all ();
 			condition.wait (lock);
 		}
 	}
@@ -168,10 +286,10 @@ bool nano::block_processor::should_log ()
 bool nano::block_processor::have_blocks ()
 {
 	debug_assert (!mutex.try_lock ());
-	return !blocks.empty () || !forced.empty () || state_block_signature_verification.size () != 0;
+	return have_queued () || validating != 0 || !validated.empty () || !forced.empty () || state_block_signature_verification.size () != 0;
 }
 
-void nano::block_processor::process_verified_state_blocks (std::deque<nano::unchecked_info> & items, std::vector<int> const & verifications, std::vector<nano::block_hash> const & hashes, std::vector<nano::signature> const & blocks_signatures)
+void nano::block_processor::process_verified_state_blocks (std::deque<nano::block_processor_item> & items, std::vector<int> const & verifications, std::vector<nano::block_hash> const & hashes, std::vector<nano::signature> const & blocks_signatures)
 {
 	{
 		nano::unique_lock<std::mutex> lk (mutex);
@@ -179,30 +297,35 @@ void nano::block_processor::process_verified_state_blocks (std::deque<nano::unch
 		{
 			debug_assert (verifications[i] == 1 || verifications[i] == 0);
 			auto & item (items.front ());
-			if (!item.block->link ().is_zero () && node.ledger.is_epoch_link (item.block->link ()))
+			auto & info (item.info);
+			if (!info.block->link ().is_zero () && node.ledger.is_epoch_link (info.block->link ()))
 			{
 				// Epoch blocks
 				if (verifications[i] == 1)
 				{
-					item.verified = nano::signature_verification::valid_epoch;
-					blocks.push_back (std::move (item));
+					info.verified = nano::signature_verification::valid_epoch;
+					queue (item);
 				}
 				else
 				{
 					// Possible regular state blocks with epoch link (send subtype)
-					item.verified = nano::signature_verification::unknown;
-					blocks.push_back (std::move (item));
+					info.verified = nano::signature_verification::unknown;
+					queue (item);
 				}
 			}
 			else if (verifications[i] == 1)
 			{
 				// Non epoch blocks
-				item.verified = nano::signature_verification::valid;
-				blocks.push_back (std::move (item));
+				info.verified = nano::signature_verification::valid;
+				queue (item);
 			}
 			else
 			{
-				requeue_invalid (hashes[i], item);
+				if (item.source == nano::block_source::bootstrap)
+				{
+					--bootstrap_count;
+				}
+				requeue_invalid (hashes[i], info);
 			}
 			items.pop_front ();
 		}
@@ -210,30 +333,206 @@ void nano::block_processor::process_verified_state_blocks (std::deque<nano::unch
 	condition.notify_all ();
 }
 
+/*
+ * Validation stage, runs on its own thread ahead of process_batch. Blocks are taken out of the lanes in batches while
+ * the commit stage applies the previous batch, and at most validation_batch_size validated blocks wait to be committed.
+ */
+void nano::block_processor::process_validation ()
+{
+	nano::unique_lock<std::mutex> lock (mutex);
+	while (!stopped)
+	{
+		auto batch_size (std::min<size_t> (validation_batch_size, node.store.max_block_write_batch_num ()));
+		if (have_queued () && validated.size () < batch_size)
+		{
+			std::deque<nano::block_processor_item> items;
+			while (have_queued () && items.size () < batch_size)
+			{
+				items.push_back (next ());
+			}
+			validating = items.size ();
+			lock.unlock ();
+			auto is_bootstrap ([](nano::block_processor_item const & item_a) { return item_a.source == nano::block_source::bootstrap; });
+			auto bootstrap_taken (std::count_if (items.begin (), items.end (), is_bootstrap));
+			validate (items);
+			// Blocks dropped by the validation stage
+			bootstrap_count -= bootstrap_taken - std::count_if (items.begin (), items.end (), is_bootstrap);
+			lock.lock ();
+			validating = 0;
+			std::move (items.begin (), items.end (), std::back_inserter (validated));
+			condition.notify_all ();
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+}
+
+/*
+ * Read-only validation of a batch, run without the write transaction or the block processor mutex.
+ * Blocks below the entry work threshold are dropped, they would never pass the ledger's work check.
+ * Previous blocks and the accounts of state blocks are read in batches through the store caches, where the
+ * ledger checks of the commit stage find them again. Blocks still lacking a signature check are then verified
+ * by the signature pipeline, state blocks against their account and legacy blocks against the account owning
+ * their previous block. Both signers are immutable, so a positive result stays valid even if the ledger
+ * changes before the block is committed.
+ */
+void nano::block_processor::validate (std::deque<nano::block_processor_item> & items_a)
+{
+	auto insufficient_work (std::stable_partition (items_a.begin (), items_a.end (), [](nano::block_processor_item const & item_a) {
+		return !nano::work_validate_entry (*item_a.info.block);
+	}));
+	node.stats.add (nano::stat::type::block_processor, nano::stat::detail::insufficient_work, nano::stat::dir::in, std::distance (insufficient_work, items_a.end ()));
+	for (auto i (insufficient_work), n (items_a.end ()); i != n; ++i)
+	{
+		if (i->processed)
+		{
+			i->processed ({ nano::process_result::insufficient_work, nano::signature_verification::unknown });
+		}
+	}
+	items_a.erase (insufficient_work, items_a.end ());
+	auto transaction (node.store.tx_begin_read ());
+	std::vector<nano::block_hash> previous_hashes;
+	std::vector<nano::account> state_accounts;
+	for (auto const & item : items_a)
+	{
+		auto const & block (*item.info.block);
+		if (!block.previous ().is_zero ())
+		{
+			previous_hashes.push_back (block.previous ());
+		}
+		if (block.type () == nano::block_type::state)
+		{
+			state_accounts.push_back (block.account ());
+		}
+	}
+	auto previous_blocks (node.store.block_get_batch (transaction, previous_hashes));
+	node.store.account_get_batch (transaction, state_accounts);
+	// Accounts of blocks in the ledger or earlier in this batch, bootstrap delivers whole chains which are not in the ledger yet
+	std::unordered_map<nano::block_hash, nano::account> block_accounts;
+	for (auto const & previous : previous_blocks)
+	{
+		if (previous != nullptr)
+		{
+			block_accounts.emplace (previous->hash (), node.store.block_account_calculated (*previous));
+		}
+	}
+	std::vector<nano::unchecked_info *> infos;
+	std::vector<nano::account> accounts;
+	for (auto & item : items_a)
+	{
+		auto & info (item.info);
+		auto const & block (*info.block);
+		auto const & hash (block.hash ());
+		nano::account account (block.account ());
+		if (account.is_zero ())
+		{
+			auto existing (block_accounts.find (block.previous ()));
+			if (existing != block_accounts.end ())
+			{
+				account = existing->second;
+			}
+		}
+		if (!account.is_zero ())
+		{
+			block_accounts.emplace (hash, account);
+			// Blocks already in the ledger are rejected as old before their signature is looked at
+			if (info.verified == nano::signature_verification::unknown && !node.ledger.block_or_pruned_exists (transaction, hash))
+			{
+				infos.push_back (&info);
+				accounts.push_back (account);
+			}
+		}
+	}
+	if (!infos.empty ())
+	{
+		auto size (infos.size ());
+		std::vector<unsigned char const *> messages;
+		messages.reserve (size);
+		std::vector<size_t> lengths (size, sizeof (nano::block_hash));
+		std::vector<unsigned char const *> pub_keys;
+		pub_keys.reserve (size);
+		std::vector<nano::signature> blocks_signatures;
+		blocks_signatures.reserve (size);
+		std::vector<unsigned char const *> signatures;
+		signatures.reserve (size);
+		std::vector<int> verifications (size, 0);
+		for (size_t i (0); i < size; ++i)
+		{
+			messages.push_back (infos[i]->block->hash ().bytes.data ());
+			pub_keys.push_back (accounts[i].bytes.data ());
+			blocks_signatures.push_back (infos[i]->block->block_signature ());
+			signatures.push_back (blocks_signatures.back ().bytes.data ());
+		}
+		nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
+		node.signature_pipeline.verify (check, nano::signature_source::block);
+		for (size_t i (0); i < size; ++i)
+		{
+			debug_assert (verifications[i] == 1 || verifications[i] == 0);
+			// Invalid signatures are left for the ledger, which reports them in the context of the other checks
+			if (verifications[i] == 1)
+			{
+				infos[i]->verified = nano::signature_verification::valid;
+			}
+		}
+		node.stats.add (nano::stat::type::block_processor, nano::stat::detail::validated, nano::stat::dir::in, std::count (verifications.begin (), verifications.end (), 1));
+	}
+}
+
 void nano::block_processor::process_batch (nano::unique_lock<std::mutex> & lock_a)
 {
-	auto scoped_write_guard = write_database_queue.wait (nano::writer::process_batch);
+	// Declared first so events run after the write guard is released, which with group commit is once the batch is durable
 	block_post_events post_events;
+	auto scoped_write_guard = write_database_queue.wait (nano::writer::process_batch);
 	auto transaction (node.store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending, tables::unchecked }, { tables::confirmation_height }));
 	nano::timer<std::chrono::milliseconds> timer_l;
 	lock_a.lock ();
 	timer_l.start ();
 	// Processing blocks
 	unsigned number_of_blocks_processed (0), number_of_forced_processed (0);
-	while ((!blocks.empty () || !forced.empty ()) && (timer_l.before_deadline (node.config.block_processor_batch_max_time) || (number_of_blocks_processed < node.flags.block_processor_batch_size)) && !awaiting_write && number_of_blocks_processed < node.store.max_block_write_batch_num ())
+	auto batch_size (std::min<size_t> (validation_batch_size, node.store.max_block_write_batch_num ()));
+	while ((!validated.empty () || !forced.empty ()) && (timer_l.before_deadline (node.config.block_processor_batch_max_time) || (number_of_blocks_processed < node.flags.block_processor_batch_size)) && !awaiting_write && number_of_blocks_processed < node.store.max_block_write_batch_num ())
 	{
-		if ((blocks.size () + state_block_signature_verification.size () + forced.size () > 64) && should_log ())
+		size_t queued (validating + validated.size ());
+		for (auto const & lane : lanes)
 		{
-			node.logger.always_log (boost::str (boost::format ("%1% blocks (+ %2% state blocks) (+ %3% forced) in processing queue") % blocks.size () % state_block_signature_verification.size () % forced.size ()));
+			queued += lane.size ();
+		}
+		if ((queued + state_block_signature_verification.size () + forced.size () > 64) && should_log ())
+		{
+			node.logger.always_log (boost::str (boost::format ("%1% blocks (%2% validated, %3% local, %4% live, %5% bootstrap, %6% unchecked) (+ %7% state blocks) (+ %8% forced) in processing queue") % queued % validated.size () % lanes[static_cast<size_t> (nano::block_source::local)].size () % lanes[static_cast<size_t> (nano::block_source::live)].size () % lanes[static_cast<size_t> (nano::block_source::bootstrap)].size () % lanes[static_cast<size_t> (nano::block_source::unchecked)].size () % state_block_signature_verification.size () % forced.size ()));
 		}
 		nano::unchecked_info info;
 		nano::block_hash hash (0);
 		bool force (false);
+		bool watch_work (false);
+		std::function<void(nano::process_return const &)> processed;
+		auto origin (nano::block_origin::remote);
 		if (forced.empty ())
 		{
-			info = blocks.front ();
-			blocks.pop_front ();
+			auto item (std::move (validated.front ()));
+			validated.pop_front ();
+			if (item.source == nano::block_source::bootstrap)
+			{
+				--bootstrap_count;
+			}
+			if (validated.size () + 1 == batch_size)
+			{
+				// Room for another batch, wakes the validation stage
+				condition.notify_all ();
+			}
+			info = std::move (item.info);
 			hash = info.block->hash ();
+			watch_work = item.watch_work;
+			processed = std::move (item.processed);
+			if (item.source == nano::block_source::local)
+			{
+				origin = nano::block_origin::local;
+			}
+			auto detail (to_stat_detail (item.source));
+			node.stats.inc (nano::stat::type::block_processor, detail, nano::stat::dir::out);
+			node.stats.add (nano::stat::type::block_processor_latency, detail, nano::stat::dir::in, std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - item.arrival).count ());
 		}
 		else
 		{
@@ -274,7 +573,13 @@ void nano::block_processor::process_batch (nano::unique_lock<std::mutex> & lock_
 			}
 		}
 		number_of_blocks_processed++;
-		process_one (transaction, post_events, info);
+		auto result (process_one (transaction, post_events, info, watch_work, origin));
+		if (processed)
+		{
+			post_events.events.push_back ([processed, result]() {
+				processed (result);
+			});
+		}
 		lock_a.lock ();
 	}
 	awaiting_write = false;
@@ -357,7 +662,7 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 			}
 
 			nano::unchecked_key unchecked_key (block->previous (), hash);
-			node.store.unchecked_put (transaction_a, unchecked_key, info_a);
+			node.unchecked.put (transaction_a, unchecked_key, info_a);
 			node.gap_cache.add (hash);
 			node.stats.inc (nano::stat::type::ledger, nano::stat::detail::gap_previous);
 			break;
@@ -375,7 +680,7 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 			}
 
 			nano::unchecked_key unchecked_key (node.ledger.block_source (transaction_a, *(block)), hash);
-			node.store.unchecked_put (transaction_a, unchecked_key, info_a);
+			node.unchecked.put (transaction_a, unchecked_key, info_a);
 			node.gap_cache.add (hash);
 			node.stats.inc (nano::stat::type::ledger, nano::stat::detail::gap_source);
 			break;
@@ -488,14 +793,14 @@ void nano::block_processor::process_old (nano::write_transaction const & transac
 
 void nano::block_processor::queue_unchecked (nano::write_transaction const & transaction_a, nano::block_hash const & hash_a)
 {
-	auto unchecked_blocks (node.store.unchecked_get (transaction_a, hash_a));
+	auto unchecked_blocks (node.unchecked.get (transaction_a, hash_a));
 	for (auto & info : unchecked_blocks)
 	{
 		if (!node.flags.disable_block_processor_unchecked_deletion)
 		{
-			node.store.unchecked_del (transaction_a, nano::unchecked_key (hash_a, info.block->hash ()));
+			node.unchecked.del (transaction_a, nano::unchecked_key (hash_a, info.block->hash ()));
 		}
-		add (info, true);
+		add (info, nano::block_source::unchecked);
 	}
 	node.gap_cache.erase (hash_a);
 }
@@ -508,18 +813,34 @@ void nano::block_processor::requeue_invalid (nano::block_hash const & hash_a, na
 
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (block_processor & block_processor, const std::string & name)
 {
-	size_t blocks_count;
+	std::array<size_t, nano::block_processor::lane_count> lane_counts;
+	// Age of the oldest queued block per lane, the latency a block queued now will at least see
+	std::array<size_t, nano::block_processor::lane_count> lane_ages_ms{};
 	size_t forced_count;
 
 	{
 		nano::lock_guard<std::mutex> guard (block_processor.mutex);
-		blocks_count = block_processor.blocks.size ();
+		auto now (std::chrono::steady_clock::now ());
+		for (size_t i (0); i < nano::block_processor::lane_count; ++i)
+		{
+			auto const & lane (block_processor.lanes[i]);
+			lane_counts[i] = lane.size ();
+			if (!lane.empty ())
+			{
+				lane_ages_ms[i] = std::chrono::duration_cast<std::chrono::milliseconds> (now - lane.front ().arrival).count ();
+			}
+		}
 		forced_count = block_processor.forced.size ();
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (collect_container_info (block_processor.state_block_signature_verification, "state_block_signature_verification"));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (block_processor.blocks)::value_type) }));
+	for (size_t i (0); i < nano::block_processor::lane_count; ++i)
+	{
+		auto lane_name (nano::to_string (static_cast<nano::block_source> (i)));
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ lane_name, lane_counts[i], sizeof (nano::block_processor_item) }));
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ lane_name + "_oldest_ms", lane_ages_ms[i], 0 }));
+	}
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "forced", forced_count, sizeof (decltype (block_processor.forced)::value_type) }));
 	return composite;
 }
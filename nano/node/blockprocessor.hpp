@@ -10,8 +10,11 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <thread>
 #include <unordered_set>
 
 namespace nano
@@ -48,8 +51,9 @@ public:
 	size_t size ();
 	bool full ();
 	bool half_full ();
-	void add (nano::unchecked_info const &, const bool = false);
+	void add (nano::unchecked_info const &, nano::block_source const = nano::block_source::live);
 	void add (std::shared_ptr<nano::block>, uint64_t = 0);
+	boost::optional<nano::process_return> add_blocking (nano::unchecked_info const &, bool const = false);
 	void force (std::shared_ptr<nano::block>);
 	void wait_write ();
 	bool should_log ();
@@ -63,24 +67,45 @@ public:
 
 private:
 	void queue_unchecked (nano::write_transaction const &, nano::block_hash const &);
+	void queue (nano::block_processor_item const &);
+	nano::block_processor_item next ();
+	bool have_queued () const;
+	void process_validation ();
+	void validate (std::deque<nano::block_processor_item> &);
 	void process_batch (nano::unique_lock<std::mutex> &);
 	void process_live (nano::block_hash const &, std::shared_ptr<nano::block>, nano::process_return const &, const bool = false, nano::block_origin const = nano::block_origin::remote);
 	void process_old (nano::write_transaction const &, std::shared_ptr<nano::block> const &, nano::block_origin const);
 	void requeue_invalid (nano::block_hash const &, nano::unchecked_info const &);
-	void process_verified_state_blocks (std::deque<nano::unchecked_info> &, std::vector<int> const &, std::vector<nano::block_hash> const &, std::vector<nano::signature> const &);
+	void process_verified_state_blocks (std::deque<nano::block_processor_item> &, std::vector<int> const &, std::vector<nano::block_hash> const &, std::vector<nano::signature> const &);
 	bool stopped{ false };
 	bool active{ false };
 	bool awaiting_write{ false };
 	std::chrono::steady_clock::time_point next_log;
-	std::deque<nano::unchecked_info> blocks;
+	/** Maximum number of blocks taken out of the lanes for a single validation batch, and of validated blocks waiting for the commit stage */
+	static size_t constexpr validation_batch_size{ 4096 };
+	static size_t constexpr lane_count{ static_cast<size_t> (nano::block_source::unchecked) + 1 };
+	/** One queue per nano::block_source, served by weighted round robin with the configured block_processor_priority_* */
+	std::array<std::deque<nano::block_processor_item>, lane_count> lanes;
+	std::array<uint32_t, lane_count> priorities;
+	size_t current_lane{ 0 };
+	uint32_t lane_credit{ 0 };
 	std::deque<std::shared_ptr<nano::block>> forced;
+	/** Blocks from the bootstrap source anywhere in the block processor, left out of the live admission check in full () */
+	std::atomic<size_t> bootstrap_count{ 0 };
+	/** Output of the validation stage, applied in this order by process_batch */
+	std::deque<nano::block_processor_item> validated;
+	/** Blocks taken out of the lanes by the validation stage and not yet in validated */
+	size_t validating{ 0 };
 	nano::condition_variable condition;
 	nano::node & node;
 	nano::write_database_queue & write_database_queue;
 	std::mutex mutex;
 	nano::state_block_signature_verification state_block_signature_verification;
+	std::thread validation_thread;
 
 	friend std::unique_ptr<container_info_component> collect_container_info (block_processor & block_processor, const std::string & name);
+	friend class node_block_processor_lanes_Test;
+	friend class node_block_processor_validate_Test;
 };
 std::unique_ptr<nano::container_info_component> collect_container_info (block_processor & block_processor, const std::string & name);
 }
@@ -145,7 +145,7 @@ void nano::bootstrap_attempt::add_recent_pull (nano::block_hash const &)
 bool nano::bootstrap_attempt::process_block (std::shared_ptr<nano::block> block_a, nano::account const & known_account_a, uint64_t pull_blocks, nano::bulk_pull::count_t max_blocks, bool block_expected, unsigned retry_limit)
 {
 	nano::unchecked_info info (block_a, known_account_a, 0, nano::signature_verification::unknown);
-	node->block_processor.add (info);
+	node->block_processor.add (info, nano::block_source::bootstrap);
 	return false;
 }
 
@@ -442,9 +442,7 @@ bool nano::bootstrap_attempt_legacy::confirm_frontiers (nano::unique_lock<std::m
 				}
 				else
 				{
-					nano::unique_lock<std::mutex> active_lock (node->active.mutex);
 					auto existing (node->active.find_inactive_votes_cache (*ii));
-					active_lock.unlock ();
 					nano::uint128_t tally;
 					for (auto & voter : existing.voters)
 					{
@@ -544,7 +544,7 @@ std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
 
 	if (send_current)
 	{
-		result = connection->node->block (current);
+		result = read_ahead_next ();
 		if (result != nullptr && set_current_to_end == false)
 		{
 			auto previous (result->previous ());
@@ -574,6 +574,44 @@ std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
 	return result;
 }
 
+/**
+ * Returns the block for "current", reading a run of its predecessors
+ * in the same read transaction so that the following calls don't need
+ * to open a transaction per block
+ */
+std::shared_ptr<nano::block> nano::bulk_pull_server::read_ahead_next ()
+{
+	if (read_ahead.empty () || read_ahead.front ().first != current)
+	{
+		read_ahead.clear ();
+		auto remaining (max_count != 0 ? max_count - sent_count : std::numeric_limits<nano::bulk_pull::count_t>::max ());
+		auto transaction (connection->node->store.tx_begin_read ());
+		auto hash (current);
+		while (read_ahead.size () < read_ahead_max && read_ahead.size () < remaining)
+		{
+			auto block (connection->node->store.block_get (transaction, hash));
+			if (block == nullptr)
+			{
+				break;
+			}
+			auto previous (block->previous ());
+			read_ahead.emplace_back (hash, std::move (block));
+			if (hash == request->end || previous.is_zero ())
+			{
+				break;
+			}
+			hash = previous;
+		}
+	}
+	std::shared_ptr<nano::block> result;
+	if (!read_ahead.empty ())
+	{
+		result = std::move (read_ahead.front ().second);
+		read_ahead.pop_front ();
+	}
+	return result;
+}
+
 void nano::bulk_pull_server::sent_action (boost::system::error_code const & ec, size_t size_a)
 {
 	if (!ec)
@@ -3,6 +3,7 @@
 #include <nano/node/common.hpp>
 #include <nano/node/socket.hpp>
 
+#include <deque>
 #include <unordered_set>
 
 namespace nano
@@ -65,6 +66,7 @@ public:
 	bulk_pull_server (std::shared_ptr<nano::bootstrap_server> const &, std::unique_ptr<nano::bulk_pull>);
 	void set_current_end ();
 	std::shared_ptr<nano::block> get_next ();
+	std::shared_ptr<nano::block> read_ahead_next ();
 	void send_next ();
 	void sent_action (boost::system::error_code const &, size_t);
 	void send_finished ();
@@ -75,6 +77,9 @@ public:
 	bool include_start;
 	nano::bulk_pull::count_t max_count;
 	nano::bulk_pull::count_t sent_count;
+	/** Blocks following "current" in the chain, read ahead of sending them */
+	std::deque<std::pair<nano::block_hash, std::shared_ptr<nano::block>>> read_ahead;
+	static size_t constexpr read_ahead_max = 128;
 };
 class bulk_pull_account;
 class bulk_pull_account_server final : public std::enable_shared_from_this<nano::bulk_pull_account_server>
@@ -281,7 +281,7 @@ bool nano::bootstrap_attempt_lazy::process_block_lazy (std::shared_ptr<nano::blo
 		lazy_block_state_backlog_check (block_a, hash);
 		lock.unlock ();
 		nano::unchecked_info info (block_a, known_account_a, 0, nano::signature_verification::unknown, retry_limit == std::numeric_limits<unsigned>::max ());
-		node->block_processor.add (info);
+		node->block_processor.add (info, nano::block_source::bootstrap);
 	}
 	// Force drop lazy bootstrap connection for long bulk_pull
 	if (pull_blocks > max_blocks)
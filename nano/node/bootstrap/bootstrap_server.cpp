@@ -485,34 +485,48 @@ void nano::bootstrap_server::receive_confirm_ack_action (boost::system::error_co
 {
 	if (!ec)
 	{
-		auto error (false);
-		nano::bufferstream stream (receive_buffer->data (), size_a);
-		auto request (std::make_unique<nano::confirm_ack> (error, stream, header_a));
-		if (!error)
+		nano::uint128_t digest{ 0 };
+		if (is_realtime_connection ())
 		{
-			if (is_realtime_connection ())
+			digest = nano::vote_filter_digest (node->network.vote_filter, node->network.vote_filter.hash (receive_buffer->data (), size_a), remote_endpoint.address (), remote_endpoint.port ());
+		}
+		if (!is_realtime_connection () || !node->network.vote_filter.apply (digest))
+		{
+			auto error (false);
+			nano::bufferstream stream (receive_buffer->data (), size_a);
+			auto request (std::make_unique<nano::confirm_ack> (error, stream, header_a));
+			request->digest = digest;
+			if (!error)
 			{
-				bool process_vote (true);
-				if (header_a.block_type () != nano::block_type::not_a_block)
+				if (is_realtime_connection ())
 				{
-					for (auto & vote_block : request->vote->blocks)
+					bool process_vote (true);
+					if (header_a.block_type () != nano::block_type::not_a_block)
 					{
-						if (!vote_block.which ())
+						for (auto & vote_block : request->vote->blocks)
 						{
-							auto block (boost::get<std::shared_ptr<nano::block>> (vote_block));
-							if (nano::work_validate_entry (*block))
+							if (!vote_block.which ())
 							{
-								process_vote = false;
-								node->stats.inc_detail_only (nano::stat::type::error, nano::stat::detail::insufficient_work);
+								auto block (boost::get<std::shared_ptr<nano::block>> (vote_block));
+								if (nano::work_validate_entry (*block))
+								{
+									process_vote = false;
+									node->stats.inc_detail_only (nano::stat::type::error, nano::stat::detail::insufficient_work);
+								}
 							}
 						}
 					}
+					if (process_vote)
+					{
+						add_request (std::unique_ptr<nano::message> (request.release ()));
+					}
 				}
-				if (process_vote)
-				{
-					add_request (std::unique_ptr<nano::message> (request.release ()));
-				}
+				receive ();
 			}
+		}
+		else
+		{
+			node->stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_confirm_ack);
 			receive ();
 		}
 	}
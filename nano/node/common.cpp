@@ -314,6 +314,10 @@ std::string nano::message_parser::status_string ()
 		{
 			return "duplicate_publish_message";
 		}
+		case nano::message_parser::parse_status::duplicate_confirm_ack_message:
+		{
+			return "duplicate_confirm_ack_message";
+		}
 	}
 
 	debug_assert (false);
@@ -321,8 +325,23 @@ std::string nano::message_parser::status_string ()
 	return "[unknown parse_status]";
 }
 
-nano::message_parser::message_parser (nano::network_filter & publish_filter_a, nano::block_uniquer & block_uniquer_a, nano::vote_uniquer & vote_uniquer_a, nano::message_visitor & visitor_a, nano::work_pool & pool_a, bool use_epoch_2_min_version_a) :
+nano::uint128_t nano::vote_filter_digest (nano::network_filter const & filter_a, nano::uint128_t const & digest_a, boost::asio::ip::address const & address_a, uint16_t port_a)
+{
+	std::array<uint8_t, 16 + 16 + sizeof (uint16_t)> bytes;
+	nano::uint128_union digest (digest_a);
+	auto address (address_a.is_v4 () ? boost::asio::ip::address_v6::v4_mapped (address_a.to_v4 ()) : address_a.to_v6 ());
+	auto address_bytes (address.to_bytes ());
+	auto port (boost::endian::native_to_big (port_a));
+	auto it (std::copy (digest.bytes.begin (), digest.bytes.end (), bytes.begin ()));
+	it = std::copy (address_bytes.begin (), address_bytes.end (), it);
+	std::memcpy (&*it, &port, sizeof (port));
+	return filter_a.hash (bytes.data (), bytes.size ());
+}
+
+nano::message_parser::message_parser (nano::network_filter & publish_filter_a, nano::block_uniquer & block_uniquer_a, nano::vote_uniquer & vote_uniquer_a, nano::message_visitor & visitor_a, nano::work_pool & pool_a, bool use_epoch_2_min_version_a, nano::network_filter * vote_filter_a, nano::endpoint const & endpoint_a) :
 publish_filter (publish_filter_a),
+vote_filter (vote_filter_a),
+endpoint (endpoint_a),
 block_uniquer (block_uniquer_a),
 vote_uniquer (vote_uniquer_a),
 visitor (visitor_a),
@@ -332,7 +351,7 @@ use_epoch_2_min_version (use_epoch_2_min_version_a)
 {
 }
 
-void nano::message_parser::deserialize_buffer (uint8_t const * buffer_a, size_t size_a)
+void nano::message_parser::deserialize_buffer (uint8_t const * buffer_a, size_t size_a, nano::uint128_t const * digest_a)
 {
 	static nano::network_constants network_constants;
 	status = parse_status::success;
@@ -359,10 +378,14 @@ void nano::message_parser::deserialize_buffer (uint8_t const * buffer_a, size_t
 					}
 					case nano::message_type::publish:
 					{
-						nano::uint128_t digest;
-						if (!publish_filter.apply (buffer_a + header.size, size_a - header.size, &digest))
+						nano::uint128_t digest (digest_a != nullptr ? *digest_a : publish_filter.hash (buffer_a + header.size, size_a - header.size));
+						if (!publish_filter.apply (digest))
 						{
-							deserialize_publish (stream, header, digest);
+							nano::block_view view (header.block_type (), buffer_a + header.size, size_a - header.size);
+							if (deserialize_publish_view (view, header, digest))
+							{
+								deserialize_publish (stream, header, digest);
+							}
 						}
 						else
 						{
@@ -377,7 +400,20 @@ void nano::message_parser::deserialize_buffer (uint8_t const * buffer_a, size_t
 					}
 					case nano::message_type::confirm_ack:
 					{
-						deserialize_confirm_ack (stream, header);
+						nano::uint128_t digest{ 0 };
+						if (vote_filter != nullptr)
+						{
+							digest = digest_a != nullptr ? *digest_a : vote_filter->hash (buffer_a + header.size, size_a - header.size);
+							digest = nano::vote_filter_digest (*vote_filter, digest, endpoint.address (), endpoint.port ());
+						}
+						if (vote_filter == nullptr || !vote_filter->apply (digest))
+						{
+							deserialize_confirm_ack (stream, header, digest);
+						}
+						else
+						{
+							status = parse_status::duplicate_confirm_ack_message;
+						}
 						break;
 					}
 					case nano::message_type::node_id_handshake:
@@ -445,6 +481,29 @@ void nano::message_parser::deserialize_publish (nano::stream & stream_a, nano::m
 	}
 }
 
+bool nano::message_parser::deserialize_publish_view (nano::block_view const & view_a, nano::message_header const & header_a, nano::uint128_t const & digest_a)
+{
+	auto result (true);
+	if (view_a.valid ())
+	{
+		if (view_a.difficulty () < nano::work_threshold_entry (nano::work_version::work_1, view_a.type))
+		{
+			result = false;
+			status = parse_status::insufficient_work;
+		}
+		else if (auto block_l = block_uniquer.find (view_a.full_hash ()))
+		{
+			// The block is already held in memory, reuse it instead of allocating a copy
+			result = false;
+			nano::publish incoming (block_l);
+			incoming.header = header_a;
+			incoming.digest = digest_a;
+			visitor.publish (incoming);
+		}
+	}
+	return result;
+}
+
 void nano::message_parser::deserialize_confirm_req (nano::stream & stream_a, nano::message_header const & header_a)
 {
 	auto error (false);
@@ -466,10 +525,11 @@ void nano::message_parser::deserialize_confirm_req (nano::stream & stream_a, nan
 	}
 }
 
-void nano::message_parser::deserialize_confirm_ack (nano::stream & stream_a, nano::message_header const & header_a)
+void nano::message_parser::deserialize_confirm_ack (nano::stream & stream_a, nano::message_header const & header_a, nano::uint128_t const & digest_a)
 {
 	auto error (false);
 	nano::confirm_ack incoming (error, stream_a, header_a, &vote_uniquer);
+	incoming.digest = digest_a;
 	if (!error && at_end (stream_a))
 	{
 		for (auto & vote_block : incoming.vote->blocks)
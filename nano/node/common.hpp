@@ -236,6 +236,11 @@ public:
 	nano::message_header header;
 };
 class work_pool;
+/**
+ * Key of a confirm_ack body digest in the vote filter, combining it with the sender address and port.
+ * Votes are filtered per sender, the same vote relayed by several peers still reaches the rep crawler from each of them.
+ */
+nano::uint128_t vote_filter_digest (nano::network_filter const &, nano::uint128_t const &, boost::asio::ip::address const &, uint16_t);
 class message_parser final
 {
 public:
@@ -253,19 +258,27 @@ public:
 		invalid_telemetry_req_message,
 		invalid_telemetry_ack_message,
 		outdated_version,
-		duplicate_publish_message
+		duplicate_publish_message,
+		duplicate_confirm_ack_message
 	};
-	message_parser (nano::network_filter &, nano::block_uniquer &, nano::vote_uniquer &, nano::message_visitor &, nano::work_pool &, bool);
-	void deserialize_buffer (uint8_t const *, size_t);
+	message_parser (nano::network_filter &, nano::block_uniquer &, nano::vote_uniquer &, nano::message_visitor &, nano::work_pool &, bool, nano::network_filter * = nullptr, nano::endpoint const & = nano::endpoint ());
+	/** \p digest_a is an optional precomputed digest of the message body, see nano::network_filter::hash */
+	void deserialize_buffer (uint8_t const *, size_t, nano::uint128_t const * = nullptr);
 	void deserialize_keepalive (nano::stream &, nano::message_header const &);
 	void deserialize_publish (nano::stream &, nano::message_header const &, nano::uint128_t const & = 0);
+	/** Handles a publish straight from the receive buffer, returns false if the block did not need to be deserialized */
+	bool deserialize_publish_view (nano::block_view const &, nano::message_header const &, nano::uint128_t const &);
 	void deserialize_confirm_req (nano::stream &, nano::message_header const &);
-	void deserialize_confirm_ack (nano::stream &, nano::message_header const &);
+	void deserialize_confirm_ack (nano::stream &, nano::message_header const &, nano::uint128_t const & = 0);
 	void deserialize_node_id_handshake (nano::stream &, nano::message_header const &);
 	void deserialize_telemetry_req (nano::stream &, nano::message_header const &);
 	void deserialize_telemetry_ack (nano::stream &, nano::message_header const &);
 	bool at_end (nano::stream &);
 	nano::network_filter & publish_filter;
+	/** Drops confirm_ack messages repeated by the same sender before deserialization and signature checking, if set */
+	nano::network_filter * vote_filter;
+	/** Sender of the parsed messages, part of the vote_filter key */
+	nano::endpoint endpoint;
 	nano::block_uniquer & block_uniquer;
 	nano::vote_uniquer & vote_uniquer;
 	nano::message_visitor & visitor;
@@ -324,6 +337,7 @@ public:
 	void visit (nano::message_visitor &) const override;
 	bool operator== (nano::confirm_ack const &) const;
 	std::shared_ptr<nano::vote> vote;
+	nano::uint128_t digest{ 0 };
 	static size_t size (nano::block_type, size_t = 0);
 };
 class frontier_req final : public message
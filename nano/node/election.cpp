@@ -27,7 +27,9 @@ status ({ block_a, 0, std::chrono::duration_cast<std::chrono::milliseconds> (std
 height (block_a->sideband ().height),
 root (block_a->root ())
 {
-	last_votes.emplace (node.network_params.random.not_an_account, nano::vote_info{ std::chrono::steady_clock::now (), 0, block_a->hash () });
+	nano::vote_info info{ std::chrono::steady_clock::now (), 0, block_a->hash () };
+	last_votes.emplace (node.network_params.random.not_an_account, info);
+	tally_add (info);
 	last_blocks.emplace (block_a->hash (), block_a);
 }
 
@@ -182,6 +184,15 @@ void nano::election::broadcast_block (nano::confirmation_solicitor & solicitor_a
 bool nano::election::transition_time (nano::confirmation_solicitor & solicitor_a)
 {
 	debug_assert (!node.active.mutex.try_lock ());
+	// Votes are counted with the weight their representative had when they arrived, recount them from time to time
+	if (!confirmed () && base_latency () * passive_duration_factor < std::chrono::steady_clock::now () - last_weights_refresh)
+	{
+		last_weights_refresh = std::chrono::steady_clock::now ();
+		if (refresh_weights ())
+		{
+			confirm_if_quorum ();
+		}
+	}
 	nano::lock_guard<std::mutex> guard (timepoints_mutex);
 	bool result = false;
 	switch (state_m)
@@ -230,35 +241,64 @@ bool nano::election::transition_time (nano::confirmation_solicitor & solicitor_a
 	return result;
 }
 
-bool nano::election::have_quorum (nano::tally_t const & tally_a, nano::uint128_t tally_sum) const
+bool nano::election::have_quorum (nano::uint128_t const & winner_a, nano::uint128_t const & second_a, nano::uint128_t const & sum_a) const
 {
 	bool result = false;
-	if (tally_sum >= node.config.online_weight_minimum.number ())
+	if (sum_a >= node.config.online_weight_minimum.number ())
 	{
-		auto i (tally_a.begin ());
-		++i;
-		auto second (i != tally_a.end () ? i->first : 0);
 		auto delta_l (node.delta ());
-		result = tally_a.begin ()->first > (second + delta_l);
+		result = winner_a > (second_a + delta_l);
 	}
 	return result;
 }
 
-nano::tally_t nano::election::tally ()
+nano::tally_t nano::election::tally () const
 {
-	std::unordered_map<nano::block_hash, nano::uint128_t> block_weights;
-	for (auto const & [account, info] : last_votes)
-	{
-		block_weights[info.hash] += node.ledger.weight (account);
-	}
-	last_tally = block_weights;
 	nano::tally_t result;
-	for (auto item : block_weights)
+	for (auto const & [hash, tally_l] : last_tally)
 	{
-		auto block (last_blocks.find (item.first));
+		auto block (last_blocks.find (hash));
 		if (block != last_blocks.end ())
 		{
-			result.emplace (item.second, block->second);
+			result.emplace (tally_l.weight, block->second);
+		}
+	}
+	return result;
+}
+
+void nano::election::tally_add (nano::vote_info const & info_a)
+{
+	auto & tally_l (last_tally[info_a.hash]);
+	tally_l.weight += info_a.weight;
+	++tally_l.voters;
+}
+
+void nano::election::tally_remove (nano::vote_info const & info_a)
+{
+	auto existing (last_tally.find (info_a.hash));
+	debug_assert (existing != last_tally.end () && existing->second.voters > 0);
+	if (existing != last_tally.end ())
+	{
+		existing->second.weight -= info_a.weight;
+		if (--existing->second.voters == 0)
+		{
+			last_tally.erase (existing);
+		}
+	}
+}
+
+bool nano::election::refresh_weights ()
+{
+	auto result (false);
+	for (auto & [account, info] : last_votes)
+	{
+		auto weight (node.ledger.weight (account));
+		if (weight != info.weight)
+		{
+			auto & tally_l (last_tally[info.hash]);
+			tally_l.weight = tally_l.weight - info.weight + weight;
+			info.weight = weight;
+			result = true;
 		}
 	}
 	return result;
@@ -266,29 +306,46 @@ nano::tally_t nano::election::tally ()
 
 void nano::election::confirm_if_quorum ()
 {
-	auto tally_l (tally ());
-	debug_assert (!tally_l.empty ());
-	auto winner (tally_l.begin ());
-	auto block_l (winner->second);
-	auto const & winner_hash_l (block_l->hash ());
-	status.tally = winner->first;
-	auto const & status_winner_hash_l (status.winner->hash ());
+	// The running tally keeps the weight of every block, so this only looks at the blocks of the election, at most a handful,
+	// however many representatives voted
+	std::shared_ptr<nano::block> block_l;
+	nano::uint128_t winner_weight (0);
+	nano::uint128_t second_weight (0);
 	nano::uint128_t sum (0);
-	for (auto & i : tally_l)
+	for (auto const & [hash, block] : last_blocks)
 	{
-		sum += i.first;
+		auto existing (last_tally.find (hash));
+		if (existing != last_tally.end ())
+		{
+			auto const & tally_l (existing->second);
+			sum += tally_l.weight;
+			if (block_l == nullptr || tally_l.weight > winner_weight)
+			{
+				second_weight = winner_weight;
+				winner_weight = tally_l.weight;
+				block_l = block;
+			}
+			else if (tally_l.weight > second_weight)
+			{
+				second_weight = tally_l.weight;
+			}
+		}
 	}
+	debug_assert (block_l != nullptr);
+	auto const & winner_hash_l (block_l->hash ());
+	status.tally = winner_weight;
+	auto const & status_winner_hash_l (status.winner->hash ());
 	if (sum >= node.config.online_weight_minimum.number () && winner_hash_l != status_winner_hash_l)
 	{
 		status.winner = block_l;
 		remove_votes (status_winner_hash_l);
 		node.block_processor.force (block_l);
 	}
-	if (have_quorum (tally_l, sum))
+	if (have_quorum (winner_weight, second_weight, sum))
 	{
 		if (node.config.logging.vote_logging () || (node.config.logging.election_fork_tally_logging () && last_blocks.size () > 1))
 		{
-			log_votes (tally_l);
+			log_votes (tally ());
 		}
 		confirm_once (nano::election_status_type::active_confirmed_quorum);
 	}
@@ -358,7 +415,17 @@ nano::election_vote_result nano::election::vote (nano::account rep, uint64_t seq
 		if (should_process)
 		{
 			node.stats.inc (nano::stat::type::election, nano::stat::detail::vote_new);
-			last_votes[rep] = { std::chrono::steady_clock::now (), sequence, block_hash };
+			nano::vote_info info{ std::chrono::steady_clock::now (), sequence, block_hash, weight };
+			if (last_vote_it != last_votes.end ())
+			{
+				tally_remove (last_vote_it->second);
+				last_vote_it->second = info;
+			}
+			else
+			{
+				last_votes.emplace (rep, info);
+			}
+			tally_add (info);
 			if (!confirmed ())
 			{
 				confirm_if_quorum ();
@@ -374,7 +441,8 @@ bool nano::election::publish (std::shared_ptr<nano::block> block_a)
 	auto result (confirmed ());
 	if (!result && last_blocks.size () >= 10)
 	{
-		if (last_tally[block_a->hash ()] < node.online_reps.online_stake () / 10)
+		auto existing_tally (last_tally.find (block_a->hash ()));
+		if ((existing_tally != last_tally.end () ? existing_tally->second.weight : 0) < node.online_reps.online_stake () / 10)
 		{
 			result = true;
 		}
@@ -412,7 +480,7 @@ nano::election_cleanup_info nano::election::cleanup_info () const
 		confirmed (),
 		status.winner->qualified_root (),
 		status.winner->hash (),
-		last_blocks
+		{ last_blocks.begin (), last_blocks.end () }
 	};
 }
 
@@ -421,9 +489,10 @@ size_t nano::election::insert_inactive_votes_cache (nano::block_hash const & has
 	auto cache (node.active.find_inactive_votes_cache (hash_a));
 	for (auto const & rep : cache.voters)
 	{
-		auto inserted (last_votes.emplace (rep, nano::vote_info{ std::chrono::steady_clock::time_point::min (), 0, hash_a }));
+		auto inserted (last_votes.emplace (rep, nano::vote_info{ std::chrono::steady_clock::time_point::min (), 0, hash_a, node.ledger.weight (rep) }));
 		if (inserted.second)
 		{
+			tally_add (inserted.first->second);
 			node.stats.inc (nano::stat::type::election, nano::stat::detail::vote_cached);
 		}
 	}
@@ -481,7 +550,12 @@ void nano::election::remove_votes (nano::block_hash const & hash_a)
 		auto list_generated_votes (node.history.votes (root, hash_a));
 		for (auto const & vote : list_generated_votes)
 		{
-			last_votes.erase (vote->account);
+			auto existing (last_votes.find (vote->account));
+			if (existing != last_votes.end ())
+			{
+				tally_remove (existing->second);
+				last_votes.erase (existing);
+			}
 		}
 		// Clear votes cache
 		node.history.erase (root);
@@ -499,12 +573,12 @@ std::unordered_map<nano::block_hash, std::shared_ptr<nano::block>> nano::electio
 {
 	debug_assert (node.network_params.network.is_dev_network ());
 	nano::lock_guard<std::mutex> guard (node.active.mutex);
-	return last_blocks;
+	return { last_blocks.begin (), last_blocks.end () };
 }
 
 std::unordered_map<nano::account, nano::vote_info> nano::election::votes ()
 {
 	debug_assert (node.network_params.network.is_dev_network ());
 	nano::lock_guard<std::mutex> guard (node.active.mutex);
-	return last_votes;
+	return { last_votes.begin (), last_votes.end () };
 }
@@ -4,6 +4,9 @@
 #include <nano/secure/common.hpp>
 #include <nano/secure/ledger.hpp>
 
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
+
 #include <atomic>
 #include <chrono>
 #include <memory>
@@ -22,6 +25,15 @@ public:
 	std::chrono::steady_clock::time_point time;
 	uint64_t sequence;
 	nano::block_hash hash;
+	/** Weight this vote contributes to the election tally */
+	nano::uint128_t weight{ 0 };
+};
+/** Running sum of the votes for one block of an election */
+class vote_tally final
+{
+public:
+	nano::uint128_t weight{ 0 };
+	uint32_t voters{ 0 };
 };
 class election_vote_result final
 {
@@ -87,8 +99,9 @@ public: // Status
 	std::shared_ptr<nano::block> winner ();
 
 	void log_votes (nano::tally_t const &, std::string const & = "") const;
-	nano::tally_t tally ();
-	bool have_quorum (nano::tally_t const &, nano::uint128_t) const;
+	/** Weights of the blocks of this election with at least one vote, from the running tally */
+	nano::tally_t tally () const;
+	bool have_quorum (nano::uint128_t const & winner_a, nano::uint128_t const & second_a, nano::uint128_t const & sum_a) const;
 
 	nano::election_status status;
 	unsigned confirmation_request_count{ 0 };
@@ -115,14 +128,24 @@ private:
 	// Calculate votes for local representatives
 	void generate_votes ();
 	void remove_votes (nano::block_hash const &);
+	// Keep last_tally in step with a vote being added to or removed from last_votes
+	void tally_add (nano::vote_info const &);
+	void tally_remove (nano::vote_info const &);
+	// Recount votes whose representative weight changed since they were counted, returns true if the tally changed
+	bool refresh_weights ();
 
 private:
-	std::unordered_map<nano::block_hash, std::shared_ptr<nano::block>> last_blocks;
-	std::unordered_map<nano::account, nano::vote_info> last_votes;
-	std::unordered_map<nano::block_hash, nano::uint128_t> last_tally;
+	/** Sorted vector map keeping its first N elements inline, elections rarely see more than one block */
+	template <typename Key, typename Value, size_t N>
+	using small_flat_map = boost::container::flat_map<Key, Value, std::less<Key>, boost::container::small_vector<std::pair<Key, Value>, N>>;
+
+	small_flat_map<nano::block_hash, std::shared_ptr<nano::block>, 1> last_blocks;
+	boost::container::flat_map<nano::account, nano::vote_info> last_votes;
+	small_flat_map<nano::block_hash, nano::vote_tally, 2> last_tally;
 
 	nano::election_behavior const behavior{ nano::election_behavior::normal };
 	std::chrono::steady_clock::time_point const election_start = { std::chrono::steady_clock::now () };
+	std::chrono::steady_clock::time_point last_weights_refresh = { std::chrono::steady_clock::now () };
 
 	nano::node & node;
 
@@ -141,5 +164,7 @@ public: // Only used in tests
 	friend class confirmation_solicitor_bypass_max_requests_cap_Test;
 	friend class votes_add_existing_Test;
 	friend class votes_add_old_Test;
+	friend class election_vote_replacement_Test;
+	friend class election_weight_refresh_Test;
 };
 }
@@ -823,20 +823,31 @@ void nano::json_handler::account_weight ()
 
 void nano::json_handler::accounts_balances ()
 {
-	boost::property_tree::ptree balances;
+	std::vector<nano::account> accounts_l;
 	for (auto & accounts : request.get_child ("accounts"))
 	{
-		auto account (account_impl (accounts.second.data ()));
 		if (!ec)
 		{
+			accounts_l.push_back (account_impl (accounts.second.data ()));
+		}
+	}
+	if (!ec)
+	{
+		boost::property_tree::ptree balances;
+		auto transaction (node.store.tx_begin_read ());
+		auto infos (node.store.account_get_batch (transaction, accounts_l));
+		for (size_t i (0), n (accounts_l.size ()); i < n; ++i)
+		{
+			auto const & account (accounts_l[i]);
 			boost::property_tree::ptree entry;
-			auto balance (node.balance_pending (account));
-			entry.put ("balance", balance.first.convert_to<std::string> ());
-			entry.put ("pending", balance.second.convert_to<std::string> ());
+			nano::uint128_t balance (infos[i] ? infos[i]->balance.number () : 0);
+			auto pending (node.ledger.account_pending (transaction, account));
+			entry.put ("balance", balance.convert_to<std::string> ());
+			entry.put ("pending", pending.convert_to<std::string> ());
 			balances.push_back (std::make_pair (account.to_account (), entry));
 		}
+		response_l.add_child ("balances", balances);
 	}
-	response_l.add_child ("balances", balances);
 	response_errors ();
 }
 
@@ -1004,8 +1015,12 @@ void nano::json_handler::block_info ()
 		{
 			nano::account account (block->account ().is_zero () ? block->sideband ().account : block->account ());
 			response_l.put ("block_account", account.to_account ());
-			auto amount (node.ledger.amount (transaction, hash));
-			response_l.put ("amount", amount.convert_to<std::string> ());
+			bool error_or_pruned (false);
+			auto amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
+			if (!error_or_pruned)
+			{
+				response_l.put ("amount", amount.convert_to<std::string> ());
+			}
 			auto balance (node.ledger.balance (transaction, hash));
 			response_l.put ("balance", balance.convert_to<std::string> ());
 			response_l.put ("height", std::to_string (block->sideband ().height));
@@ -1061,14 +1076,12 @@ void nano::json_handler::block_confirm ()
 			{
 				// Add record in confirmation history for confirmed block
 				nano::election_status status{ block_l, 0, std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::system_clock::now ().time_since_epoch ()), std::chrono::duration_values<std::chrono::milliseconds>::zero (), 0, 1, 0, nano::election_status_type::active_confirmation_height };
-				{
-					nano::lock_guard<std::mutex> lock (node.active.mutex);
-					node.active.add_recently_cemented (status);
-				}
+				node.active.add_recently_cemented (status);
 				// Trigger callback for confirmed block
 				node.block_arrival.add (hash);
 				auto account (node.ledger.account (transaction, hash));
-				auto amount (node.ledger.amount (transaction, hash));
+				bool error_or_pruned (false);
+				auto amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
 				bool is_state_send (false);
 				if (auto state = dynamic_cast<nano::state_block *> (block_l.get ()))
 				{
@@ -1139,7 +1152,8 @@ void nano::json_handler::blocks_info ()
 
 	boost::property_tree::ptree blocks;
 	boost::property_tree::ptree blocks_not_found;
-	auto transaction (node.store.tx_begin_read ());
+	std::vector<std::string> hashes_text;
+	std::vector<nano::block_hash> hashes_l;
 	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
 	{
 		if (!ec)
@@ -1148,78 +1162,115 @@ void nano::json_handler::blocks_info ()
 			nano::block_hash hash;
 			if (!hash.decode_hex (hash_text))
 			{
-				auto block (node.store.block_get (transaction, hash));
-				if (block != nullptr)
+				hashes_text.push_back (hash_text);
+				hashes_l.push_back (hash);
+			}
+			else
+			{
+				ec = nano::error_blocks::bad_hash_number;
+			}
+		}
+	}
+	auto transaction (node.store.tx_begin_read ());
+	std::vector<std::shared_ptr<nano::block>> blocks_l;
+	std::vector<bool> pending_exists (hashes_l.size (), false);
+	if (!ec)
+	{
+		blocks_l = node.store.block_get_batch (transaction, hashes_l);
+		if (pending)
+		{
+			std::vector<nano::pending_key> pending_keys;
+			std::vector<size_t> pending_indices;
+			for (size_t i (0), n (blocks_l.size ()); i < n; ++i)
+			{
+				if (blocks_l[i] != nullptr)
 				{
-					boost::property_tree::ptree entry;
-					nano::account account (block->account ().is_zero () ? block->sideband ().account : block->account ());
-					entry.put ("block_account", account.to_account ());
-					auto amount (node.ledger.amount (transaction, hash));
-					entry.put ("amount", amount.convert_to<std::string> ());
-					auto balance (node.ledger.balance (transaction, hash));
-					entry.put ("balance", balance.convert_to<std::string> ());
-					entry.put ("height", std::to_string (block->sideband ().height));
-					entry.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
-					auto confirmed (node.ledger.block_confirmed (transaction, hash));
-					entry.put ("confirmed", confirmed);
-
-					if (json_block_l)
-					{
-						boost::property_tree::ptree block_node_l;
-						block->serialize_json (block_node_l);
-						entry.add_child ("contents", block_node_l);
-					}
-					else
-					{
-						std::string contents;
-						block->serialize_json (contents);
-						entry.put ("contents", contents);
-					}
-					if (block->type () == nano::block_type::state)
-					{
-						auto subtype (nano::state_subtype (block->sideband ().details));
-						entry.put ("subtype", subtype);
-					}
-					if (pending)
-					{
-						bool exists (false);
-						auto destination (node.ledger.block_destination (transaction, *block));
-						if (!destination.is_zero ())
-						{
-							exists = node.store.pending_exists (transaction, nano::pending_key (destination, hash));
-						}
-						entry.put ("pending", exists ? "1" : "0");
-					}
-					if (source)
+					auto destination (node.ledger.block_destination (transaction, *blocks_l[i]));
+					if (!destination.is_zero ())
 					{
-						nano::block_hash source_hash (node.ledger.block_source (transaction, *block));
-						auto block_a (node.store.block_get (transaction, source_hash));
-						if (block_a != nullptr)
-						{
-							auto source_account (node.ledger.account (transaction, source_hash));
-							entry.put ("source_account", source_account.to_account ());
-						}
-						else
-						{
-							entry.put ("source_account", "0");
-						}
+						pending_keys.emplace_back (destination, hashes_l[i]);
+						pending_indices.push_back (i);
 					}
-					blocks.push_back (std::make_pair (hash_text, entry));
 				}
-				else if (include_not_found)
+			}
+			auto pending_infos (node.store.pending_get_batch (transaction, pending_keys));
+			for (size_t i (0), n (pending_infos.size ()); i < n; ++i)
+			{
+				pending_exists[pending_indices[i]] = pending_infos[i].is_initialized ();
+			}
+		}
+	}
+	for (size_t i (0), n (blocks_l.size ()); i < n; ++i)
+	{
+		if (!ec)
+		{
+			auto const & hash_text (hashes_text[i]);
+			auto const & hash (hashes_l[i]);
+			auto const & block (blocks_l[i]);
+			if (block != nullptr)
+			{
+				boost::property_tree::ptree entry;
+				nano::account account (block->account ().is_zero () ? block->sideband ().account : block->account ());
+				entry.put ("block_account", account.to_account ());
+				bool error_or_pruned (false);
+				auto amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
+				if (!error_or_pruned)
+				{
+					entry.put ("amount", amount.convert_to<std::string> ());
+				}
+				auto balance (node.ledger.balance (transaction, hash));
+				entry.put ("balance", balance.convert_to<std::string> ());
+				entry.put ("height", std::to_string (block->sideband ().height));
+				entry.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
+				auto confirmed (node.ledger.block_confirmed (transaction, hash));
+				entry.put ("confirmed", confirmed);
+
+				if (json_block_l)
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("", hash_text);
-					blocks_not_found.push_back (std::make_pair ("", entry));
+					boost::property_tree::ptree block_node_l;
+					block->serialize_json (block_node_l);
+					entry.add_child ("contents", block_node_l);
 				}
 				else
 				{
-					ec = nano::error_blocks::not_found;
+					std::string contents;
+					block->serialize_json (contents);
+					entry.put ("contents", contents);
 				}
+				if (block->type () == nano::block_type::state)
+				{
+					auto subtype (nano::state_subtype (block->sideband ().details));
+					entry.put ("subtype", subtype);
+				}
+				if (pending)
+				{
+					entry.put ("pending", pending_exists[i] ? "1" : "0");
+				}
+				if (source)
+				{
+					nano::block_hash source_hash (node.ledger.block_source (transaction, *block));
+					auto block_a (node.store.block_get (transaction, source_hash));
+					if (block_a != nullptr)
+					{
+						auto source_account (node.ledger.account (transaction, source_hash));
+						entry.put ("source_account", source_account.to_account ());
+					}
+					else
+					{
+						entry.put ("source_account", "0");
+					}
+				}
+				blocks.push_back (std::make_pair (hash_text, entry));
+			}
+			else if (include_not_found)
+			{
+				boost::property_tree::ptree entry;
+				entry.put ("", hash_text);
+				blocks_not_found.push_back (std::make_pair ("", entry));
 			}
 			else
 			{
-				ec = nano::error_blocks::bad_hash_number;
+				ec = nano::error_blocks::not_found;
 			}
 		}
 	}
@@ -1256,7 +1307,7 @@ void nano::json_handler::block_account ()
 void nano::json_handler::block_count ()
 {
 	response_l.put ("count", std::to_string (node.ledger.cache.block_count));
-	response_l.put ("unchecked", std::to_string (node.store.unchecked_count (node.store.tx_begin_read ())));
+	response_l.put ("unchecked", std::to_string (node.unchecked.count (node.store.tx_begin_read ())));
 	response_l.put ("cemented", std::to_string (node.ledger.cache.cemented_count));
 	response_errors ();
 }
@@ -2181,8 +2232,7 @@ public:
 		tree.put ("type", "send");
 		auto account (block_a.hashables.destination.to_account ());
 		tree.put ("account", account);
-		auto amount (handler.node.ledger.amount (transaction, hash).convert_to<std::string> ());
-		tree.put ("amount", amount);
+		put_amount ();
 		if (raw)
 		{
 			tree.put ("destination", account);
@@ -2193,10 +2243,8 @@ public:
 	void receive_block (nano::receive_block const & block_a)
 	{
 		tree.put ("type", "receive");
-		auto account (handler.node.ledger.account (transaction, block_a.hashables.source).to_account ());
-		tree.put ("account", account);
-		auto amount (handler.node.ledger.amount (transaction, hash).convert_to<std::string> ());
-		tree.put ("amount", amount);
+		put_source_account (block_a.hashables.source);
+		put_amount ();
 		if (raw)
 		{
 			tree.put ("source", block_a.hashables.source.to_string ());
@@ -2219,8 +2267,8 @@ public:
 		}
 		if (block_a.hashables.source != network_params.ledger.genesis_account)
 		{
-			tree.put ("account", handler.node.ledger.account (transaction, block_a.hashables.source).to_account ());
-			tree.put ("amount", handler.node.ledger.amount (transaction, hash).convert_to<std::string> ());
+			put_source_account (block_a.hashables.source);
+			put_amount ();
 		}
 		else
 		{
@@ -2248,8 +2296,12 @@ public:
 			tree.put ("previous", block_a.hashables.previous.to_string ());
 		}
 		auto balance (block_a.hashables.balance.number ());
-		auto previous_balance (handler.node.ledger.balance (transaction, block_a.hashables.previous));
-		if (balance < previous_balance)
+		bool error_or_pruned (false);
+		auto previous_balance (handler.node.ledger.balance_safe (transaction, block_a.hashables.previous, error_or_pruned));
+		// Without the previous balance the subtype is taken from the sideband and the amount is left out
+		auto is_send (error_or_pruned ? block_a.sideband ().details.is_send : balance < previous_balance);
+		auto is_epoch (error_or_pruned ? block_a.sideband ().details.is_epoch : balance == previous_balance && handler.node.ledger.is_epoch_link (block_a.hashables.link));
+		if (is_send)
 		{
 			if (should_ignore_account (block_a.hashables.link.as_account ()))
 			{
@@ -2265,7 +2317,10 @@ public:
 				tree.put ("type", "send");
 			}
 			tree.put ("account", block_a.hashables.link.to_account ());
-			tree.put ("amount", (previous_balance - balance).convert_to<std::string> ());
+			if (!error_or_pruned)
+			{
+				tree.put ("amount", (previous_balance - balance).convert_to<std::string> ());
+			}
 		}
 		else
 		{
@@ -2276,7 +2331,7 @@ public:
 					tree.put ("subtype", "change");
 				}
 			}
-			else if (balance == previous_balance && handler.node.ledger.is_epoch_link (block_a.hashables.link))
+			else if (is_epoch)
 			{
 				if (raw && accounts_filter.empty ())
 				{
@@ -2286,7 +2341,8 @@ public:
 			}
 			else
 			{
-				auto account (handler.node.ledger.account (transaction, block_a.hashables.link.as_block_hash ()));
+				// The source block may have been pruned, its account is then unknown
+				auto account (handler.node.ledger.account_safe (transaction, block_a.hashables.link.as_block_hash ()));
 				if (should_ignore_account (account))
 				{
 					tree.clear ();
@@ -2300,11 +2356,35 @@ public:
 				{
 					tree.put ("type", "receive");
 				}
-				tree.put ("account", account.to_account ());
-				tree.put ("amount", (balance - previous_balance).convert_to<std::string> ());
+				if (!account.is_zero ())
+				{
+					tree.put ("account", account.to_account ());
+				}
+				if (!error_or_pruned)
+				{
+					tree.put ("amount", (balance - previous_balance).convert_to<std::string> ());
+				}
 			}
 		}
 	}
+	void put_amount ()
+	{
+		// The amount is unknown if the previous block has been pruned
+		bool error_or_pruned (false);
+		auto amount (handler.node.ledger.amount_safe (transaction, hash, error_or_pruned));
+		if (!error_or_pruned)
+		{
+			tree.put ("amount", amount.convert_to<std::string> ());
+		}
+	}
+	void put_source_account (nano::block_hash const & source_a)
+	{
+		auto account (handler.node.ledger.account_safe (transaction, source_a));
+		if (!account.is_zero ())
+		{
+			tree.put ("account", account.to_account ());
+		}
+	}
 	bool should_ignore_account (nano::public_key const & account)
 	{
 		bool ignore (false);
@@ -3003,6 +3083,7 @@ void nano::json_handler::process ()
 {
 	node.worker.push_task (create_worker_task ([](std::shared_ptr<nano::json_handler> const & rpc_l) {
 		const bool watch_work_l = rpc_l->request.get<bool> ("watch_work", true);
+		const bool is_async = rpc_l->request.get<bool> ("async", false);
 		auto block (rpc_l->block_impl (true));
 
 		// State blocks subtype check
@@ -3076,81 +3157,90 @@ void nano::json_handler::process ()
 		{
 			if (!nano::work_validate_entry (*block))
 			{
-				auto result (rpc_l->node.process_local (block, watch_work_l));
-				switch (result.code)
+				if (!is_async)
 				{
-					case nano::process_result::progress:
-					{
-						rpc_l->response_l.put ("hash", block->hash ().to_string ());
-						break;
-					}
-					case nano::process_result::gap_previous:
+					auto result (rpc_l->node.process_local (block, watch_work_l));
+					switch (result.code)
 					{
-						rpc_l->ec = nano::error_process::gap_previous;
-						break;
-					}
-					case nano::process_result::gap_source:
-					{
-						rpc_l->ec = nano::error_process::gap_source;
-						break;
-					}
-					case nano::process_result::old:
-					{
-						rpc_l->ec = nano::error_process::old;
-						break;
-					}
-					case nano::process_result::bad_signature:
-					{
-						rpc_l->ec = nano::error_process::bad_signature;
-						break;
-					}
-					case nano::process_result::negative_spend:
-					{
-						// TODO once we get RPC versioning, this should be changed to "negative spend"
-						rpc_l->ec = nano::error_process::negative_spend;
-						break;
-					}
-					case nano::process_result::balance_mismatch:
-					{
-						rpc_l->ec = nano::error_process::balance_mismatch;
-						break;
-					}
-					case nano::process_result::unreceivable:
-					{
-						rpc_l->ec = nano::error_process::unreceivable;
-						break;
-					}
-					case nano::process_result::block_position:
-					{
-						rpc_l->ec = nano::error_process::block_position;
-						break;
-					}
-					case nano::process_result::fork:
-					{
-						const bool force = rpc_l->request.get<bool> ("force", false);
-						if (force)
+						case nano::process_result::progress:
 						{
-							rpc_l->node.active.erase (*block);
-							rpc_l->node.block_processor.force (block);
 							rpc_l->response_l.put ("hash", block->hash ().to_string ());
+							break;
 						}
-						else
+						case nano::process_result::gap_previous:
 						{
-							rpc_l->ec = nano::error_process::fork;
+							rpc_l->ec = nano::error_process::gap_previous;
+							break;
+						}
+						case nano::process_result::gap_source:
+						{
+							rpc_l->ec = nano::error_process::gap_source;
+							break;
+						}
+						case nano::process_result::old:
+						{
+							rpc_l->ec = nano::error_process::old;
+							break;
+						}
+						case nano::process_result::bad_signature:
+						{
+							rpc_l->ec = nano::error_process::bad_signature;
+							break;
+						}
+						case nano::process_result::negative_spend:
+						{
+							// TODO once we get RPC versioning, this should be changed to "negative spend"
+							rpc_l->ec = nano::error_process::negative_spend;
+							break;
+						}
+						case nano::process_result::balance_mismatch:
+						{
+							rpc_l->ec = nano::error_process::balance_mismatch;
+							break;
+						}
+						case nano::process_result::unreceivable:
+						{
+							rpc_l->ec = nano::error_process::unreceivable;
+							break;
+						}
+						case nano::process_result::block_position:
+						{
+							rpc_l->ec = nano::error_process::block_position;
+							break;
+						}
+						case nano::process_result::fork:
+						{
+							const bool force = rpc_l->request.get<bool> ("force", false);
+							if (force)
+							{
+								rpc_l->node.active.erase (*block);
+								rpc_l->node.block_processor.force (block);
+								rpc_l->response_l.put ("hash", block->hash ().to_string ());
+							}
+							else
+							{
+								rpc_l->ec = nano::error_process::fork;
+							}
+							break;
+						}
+						case nano::process_result::insufficient_work:
+						{
+							rpc_l->ec = nano::error_process::insufficient_work;
+							break;
+						}
+						default:
+						{
+							rpc_l->ec = nano::error_process::other;
+							break;
 						}
-						break;
-					}
-					case nano::process_result::insufficient_work:
-					{
-						rpc_l->ec = nano::error_process::insufficient_work;
-						break;
-					}
-					default:
-					{
-						rpc_l->ec = nano::error_process::other;
-						break;
 					}
 				}
+				else
+				{
+					// Queued on the local lane of the block processor, the result is not waited for
+					rpc_l->node.process_local_async (block);
+					rpc_l->response_l.put ("started", "1");
+				}
 			}
 			else
 			{
@@ -3765,7 +3855,7 @@ void nano::json_handler::telemetry ()
 					if (address.is_loopback () && port == rpc_l->node.network.endpoint ().port ())
 					{
 						// Requesting telemetry metrics locally
-						auto telemetry_data = nano::local_telemetry_data (rpc_l->node.store, rpc_l->node.ledger.cache, rpc_l->node.network, rpc_l->node.config.bandwidth_limit, rpc_l->node.network_params, rpc_l->node.startup_time, rpc_l->node.active.active_difficulty (), rpc_l->node.node_id);
+						auto telemetry_data = nano::local_telemetry_data (rpc_l->node.store, rpc_l->node.unchecked, rpc_l->node.ledger.cache, rpc_l->node.network, rpc_l->node.config.bandwidth_limit, rpc_l->node.network_params, rpc_l->node.startup_time, rpc_l->node.active.active_difficulty (), rpc_l->node.node_id);
 
 						nano::jsonconfig config_l;
 						auto const should_ignore_identification_metrics = false;
@@ -3913,9 +4003,8 @@ void nano::json_handler::unchecked ()
 	{
 		boost::property_tree::ptree unchecked;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction)), n (node.store.unchecked_end ()); i != n && unchecked.size () < count; ++i)
-		{
-			nano::unchecked_info const & info (i->second);
+		node.unchecked.for_each (
+		transaction, [&unchecked, json_block_l](nano::unchecked_key const &, nano::unchecked_info const & info) {
 			if (json_block_l)
 			{
 				boost::property_tree::ptree block_node_l;
@@ -3928,7 +4017,8 @@ void nano::json_handler::unchecked ()
 				info.block->serialize_json (contents);
 				unchecked.put (info.block->hash ().to_string (), contents);
 			}
-		}
+		},
+		[&unchecked, count]() { return unchecked.size () < count; });
 		response_l.add_child ("blocks", unchecked);
 	}
 	response_errors ();
@@ -3938,7 +4028,7 @@ void nano::json_handler::unchecked_clear ()
 {
 	node.worker.push_task (create_worker_task ([](std::shared_ptr<nano::json_handler> const & rpc_l) {
 		auto transaction (rpc_l->node.store.tx_begin_write ({ tables::unchecked }));
-		rpc_l->node.store.unchecked_clear (transaction);
+		rpc_l->node.unchecked.clear (transaction);
 		rpc_l->response_l.put ("success", "");
 		rpc_l->response_errors ();
 	}));
@@ -3951,12 +4041,11 @@ void nano::json_handler::unchecked_get ()
 	if (!ec)
 	{
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction)), n (node.store.unchecked_end ()); i != n; ++i)
-		{
-			nano::unchecked_key const & key (i->first);
+		auto done (false);
+		node.unchecked.for_each (
+		transaction, [this, &done, hash, json_block_l](nano::unchecked_key const & key, nano::unchecked_info const & info) {
 			if (key.hash == hash)
 			{
-				nano::unchecked_info const & info (i->second);
 				response_l.put ("modified_timestamp", std::to_string (info.modified));
 
 				if (json_block_l)
@@ -3971,9 +4060,10 @@ void nano::json_handler::unchecked_get ()
 					info.block->serialize_json (contents);
 					response_l.put ("contents", contents);
 				}
-				break;
+				done = true;
 			}
-		}
+		},
+		[&done]() { return !done; });
 		if (response_l.empty ())
 		{
 			ec = nano::error_blocks::not_found;
@@ -3999,11 +4089,10 @@ void nano::json_handler::unchecked_keys ()
 	{
 		boost::property_tree::ptree unchecked;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction, nano::unchecked_key (key, 0))), n (node.store.unchecked_end ()); i != n && unchecked.size () < count; ++i)
-		{
+		node.unchecked.for_each (
+		transaction, nano::unchecked_key (key, 0), [&unchecked, json_block_l](nano::unchecked_key const & unchecked_key, nano::unchecked_info const & info) {
 			boost::property_tree::ptree entry;
-			nano::unchecked_info const & info (i->second);
-			entry.put ("key", i->first.key ().to_string ());
+			entry.put ("key", unchecked_key.key ().to_string ());
 			entry.put ("hash", info.block->hash ().to_string ());
 			entry.put ("modified_timestamp", std::to_string (info.modified));
 			if (json_block_l)
@@ -4019,7 +4108,8 @@ void nano::json_handler::unchecked_keys ()
 				entry.put ("contents", contents);
 			}
 			unchecked.push_back (std::make_pair ("", entry));
-		}
+		},
+		[&unchecked, count]() { return unchecked.size () < count; });
 		response_l.add_child ("unchecked", unchecked);
 	}
 	response_errors ();
@@ -11,6 +11,8 @@
 #include <boost/format.hpp>
 #include <boost/polymorphic_cast.hpp>
 
+#include <algorithm>
+#include <numeric>
 #include <queue>
 
 namespace nano
@@ -156,14 +158,20 @@ void nano::mdb_store::serialize_memory_stats (boost::property_tree::ptree & json
 	json.put ("page_size", stats.ms_psize);
 }
 
+void nano::mdb_store::sync ()
+{
+	auto status (mdb_env_sync (env.environment, true));
+	release_assert (status == 0);
+}
+
 nano::write_transaction nano::mdb_store::tx_begin_write (std::vector<nano::tables> const &, std::vector<nano::tables> const &)
 {
-	return env.tx_begin_write (create_txn_callbacks ());
+	return env.tx_begin_write (create_txn_callbacks (), &cache_order);
 }
 
 nano::read_transaction nano::mdb_store::tx_begin_read ()
 {
-	return env.tx_begin_read (create_txn_callbacks ());
+	return env.tx_begin_read (create_txn_callbacks (), &cache_order);
 }
 
 std::string nano::mdb_store::vendor_get () const
@@ -276,6 +284,9 @@ bool nano::mdb_store::do_upgrades (nano::write_transaction & transaction_a, bool
 		case 19:
 			upgrade_v19_to_v20 (transaction_a);
 		case 20:
+			upgrade_v20_to_v21 (transaction_a);
+			needs_vacuuming = true;
+		case 21:
 			break;
 		default:
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
@@ -737,6 +748,41 @@ void nano::mdb_store::upgrade_v19_to_v20 (nano::write_transaction const & transa
 	logger.always_log ("Finished creating new pruned table");
 }
 
+void nano::mdb_store::upgrade_v20_to_v21 (nano::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v20 to v21 database upgrade...");
+	auto count_pre (count (transaction_a, blocks));
+
+	// Write blocks in the compact format to a new table, keys are already sorted so they can be appended
+	MDB_dbi temp_blocks;
+	mdb_dbi_open (env.tx (transaction_a), "temp_blocks", MDB_CREATE, &temp_blocks);
+	for (auto i (nano::store_iterator<nano::block_hash, nano::block_w_sideband> (std::make_unique<nano::mdb_iterator<nano::block_hash, nano::block_w_sideband>> (transaction_a, blocks))), n (nano::store_iterator<nano::block_hash, nano::block_w_sideband> (nullptr)); i != n; ++i)
+	{
+		std::vector<uint8_t> data;
+		block_serialize (data, *i->second.block, i->second.sideband);
+		nano::mdb_val value{ data.size (), (void *)data.data () };
+		auto s = mdb_put (env.tx (transaction_a), temp_blocks, nano::mdb_val (i->first), value, MDB_APPEND);
+		release_assert (success (s));
+	}
+
+	logger.always_log ("Copying compact blocks back to the blocks table");
+
+	// Empty the blocks table and copy the converted entries back
+	release_assert (!mdb_drop (env.tx (transaction_a), blocks, 0));
+	for (auto i (nano::store_iterator<nano::block_hash, nano::mdb_val> (std::make_unique<nano::mdb_iterator<nano::block_hash, nano::mdb_val>> (transaction_a, temp_blocks))), n (nano::store_iterator<nano::block_hash, nano::mdb_val> (nullptr)); i != n; ++i)
+	{
+		auto s = mdb_put (env.tx (transaction_a), blocks, nano::mdb_val (i->first), i->second, MDB_APPEND);
+		release_assert (success (s));
+	}
+	mdb_drop (env.tx (transaction_a), temp_blocks, 1);
+
+	auto count_post (count (transaction_a, blocks));
+	release_assert (count_pre == count_post);
+
+	version_put (transaction_a, 21);
+	logger.always_log ("Finished upgrading all blocks to the compact format");
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void nano::mdb_store::create_backup_file (nano::mdb_env & env_a, boost::filesystem::path const & filepath_a, nano::logger_mt & logger_a)
 {
@@ -800,6 +846,32 @@ int nano::mdb_store::get (nano::transaction const & transaction_a, tables table_
 	return mdb_get (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a);
 }
 
+void nano::mdb_store::get_batch (nano::transaction const & transaction_a, tables table_a, std::vector<nano::mdb_val> const & keys_a, std::vector<nano::mdb_val> & values_a, std::vector<int> & statuses_a) const
+{
+	values_a.assign (keys_a.size (), nano::mdb_val{});
+	statuses_a.assign (keys_a.size (), MDB_NOTFOUND);
+	// Visit keys in database order so consecutive lookups touch neighbouring pages
+	std::vector<size_t> order (keys_a.size ());
+	std::iota (order.begin (), order.end (), 0);
+	std::sort (order.begin (), order.end (), [&keys_a](size_t const lhs, size_t const rhs) {
+		auto const & lhs_key (keys_a[lhs]);
+		auto const & rhs_key (keys_a[rhs]);
+		auto lhs_data (reinterpret_cast<uint8_t const *> (lhs_key.data ()));
+		auto rhs_data (reinterpret_cast<uint8_t const *> (rhs_key.data ()));
+		return std::lexicographical_compare (lhs_data, lhs_data + lhs_key.size (), rhs_data, rhs_data + rhs_key.size ());
+	});
+	MDB_cursor * cursor;
+	auto status (mdb_cursor_open (env.tx (transaction_a), table_to_dbi (table_a), &cursor));
+	release_assert (status == MDB_SUCCESS);
+	for (auto index : order)
+	{
+		// MDB_SET_KEY overwrites the key with the copy stored in the database, so look up a temporary
+		MDB_val key (keys_a[index].value);
+		statuses_a[index] = mdb_cursor_get (cursor, &key, &values_a[index].value, MDB_SET_KEY);
+	}
+	mdb_cursor_close (cursor);
+}
+
 int nano::mdb_store::put (nano::write_transaction const & transaction_a, tables table_a, nano::mdb_val const & key_a, const nano::mdb_val & value_a) const
 {
 	return (mdb_put (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a, 0));
@@ -34,7 +34,7 @@ void nano::mdb_env::init (bool & error_a, boost::filesystem::path const & path_a
 			// MDB_NORDAHEAD will allow platforms that support it to load the DB in memory as needed.
 			// MDB_NOMEMINIT prevents zeroing malloc'ed pages. Can provide improvement for non-sensitive data but may make memory checkers noisy (e.g valgrind).
 			auto environment_flags = MDB_NOSUBDIR | MDB_NOTLS | MDB_NORDAHEAD;
-			if (options_a.config.sync == nano::lmdb_config::sync_strategy::nosync_safe)
+			if (options_a.config.sync == nano::lmdb_config::sync_strategy::nosync_safe || options_a.config.sync == nano::lmdb_config::sync_strategy::group_commit)
 			{
 				environment_flags |= MDB_NOMETASYNC;
 			}
@@ -93,14 +93,17 @@ nano::mdb_env::operator MDB_env * () const
 	return environment;
 }
 
-nano::read_transaction nano::mdb_env::tx_begin_read (mdb_txn_callbacks mdb_txn_callbacks) const
+nano::read_transaction nano::mdb_env::tx_begin_read (mdb_txn_callbacks mdb_txn_callbacks, nano::store_cache_order * cache_order_a) const
 {
-	return nano::read_transaction{ std::make_unique<nano::read_mdb_txn> (*this, mdb_txn_callbacks) };
+	// The cache sequence is sampled before the snapshot is taken
+	auto cache_sequence (cache_order_a != nullptr ? cache_order_a->sequence () : 0);
+	return nano::read_transaction{ std::make_unique<nano::read_mdb_txn> (*this, mdb_txn_callbacks), cache_order_a, cache_sequence };
 }
 
-nano::write_transaction nano::mdb_env::tx_begin_write (mdb_txn_callbacks mdb_txn_callbacks) const
+nano::write_transaction nano::mdb_env::tx_begin_write (mdb_txn_callbacks mdb_txn_callbacks, nano::store_cache_order * cache_order_a) const
 {
-	return nano::write_transaction{ std::make_unique<nano::write_mdb_txn> (*this, mdb_txn_callbacks) };
+	auto cache_sequence (cache_order_a != nullptr ? cache_order_a->sequence () : 0);
+	return nano::write_transaction{ std::make_unique<nano::write_mdb_txn> (*this, mdb_txn_callbacks), cache_order_a, cache_sequence };
 }
 
 MDB_txn * nano::mdb_env::tx (nano::transaction const & transaction_a) const
@@ -58,8 +58,8 @@ public:
 	void init (bool &, boost::filesystem::path const &, nano::mdb_env::options options_a = nano::mdb_env::options::make ());
 	~mdb_env ();
 	operator MDB_env * () const;
-	nano::read_transaction tx_begin_read (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
-	nano::write_transaction tx_begin_write (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
+	nano::read_transaction tx_begin_read (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}, nano::store_cache_order * cache_order = nullptr) const;
+	nano::write_transaction tx_begin_write (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}, nano::store_cache_order * cache_order = nullptr) const;
 	MDB_txn * tx (nano::transaction const & transaction_a) const;
 	MDB_env * environment;
 };
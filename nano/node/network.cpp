@@ -19,6 +19,7 @@ limiter (node_a.config.bandwidth_limit_burst_ratio, node_a.config.bandwidth_limi
 tcp_message_manager (node_a.config.tcp_incoming_connections_max),
 node (node_a),
 publish_filter (256 * 1024),
+vote_filter (256 * 1024),
 udp_channels (node_a, port_a),
 tcp_channels (node_a),
 port (port_a),
@@ -472,7 +473,11 @@ public:
 					}
 				}
 			}
-			node.vote_processor.vote (message_a.vote, channel);
+			if (node.vote_processor.vote (message_a.vote, channel))
+			{
+				// Dropped by the vote processor, allow a repeat of this vote to be processed
+				node.network.vote_filter.clear (message_a.digest);
+			}
 		}
 	}
 	void bulk_pull (nano::bulk_pull const &) override
@@ -508,7 +513,7 @@ public:
 		nano::telemetry_ack telemetry_ack;
 		if (!node.flags.disable_providing_telemetry_metrics)
 		{
-			auto telemetry_data = nano::local_telemetry_data (node.store, node.ledger.cache, node.network, node.config.bandwidth_limit, node.network_params, node.startup_time, node.active.active_difficulty (), node.node_id);
+			auto telemetry_data = nano::local_telemetry_data (node.store, node.unchecked, node.ledger.cache, node.network, node.config.bandwidth_limit, node.network_params, node.startup_time, node.active.active_difficulty (), node.node_id);
 			telemetry_ack = nano::telemetry_ack (telemetry_data);
 		}
 		channel->send (telemetry_ack, nullptr, nano::buffer_drop_policy::no_socket_drop);
@@ -887,6 +892,22 @@ nano::message_buffer * nano::message_buffer_manager::dequeue ()
 	return result;
 }
 
+std::vector<nano::message_buffer *> nano::message_buffer_manager::dequeue (size_t max_a)
+{
+	nano::unique_lock<std::mutex> lock (mutex);
+	while (!stopped && full.empty ())
+	{
+		condition.wait (lock);
+	}
+	std::vector<nano::message_buffer *> result;
+	while (!full.empty () && result.size () < max_a)
+	{
+		result.push_back (full.front ());
+		full.pop_front ();
+	}
+	return result;
+}
+
 void nano::message_buffer_manager::release (nano::message_buffer * data_a)
 {
 	debug_assert (data_a != nullptr);
@@ -51,6 +51,10 @@ public:
 	// Function will block until a buffer has been added
 	// Return nullptr if the container has stopped
 	nano::message_buffer * dequeue ();
+	// Return up to max_a buffers that have been filled with message data, in arrival order
+	// Function will block until at least one buffer has been added
+	// Return an empty vector if the container has stopped
+	std::vector<nano::message_buffer *> dequeue (size_t max_a);
 	// Return a buffer to the freelist after is has been serviced
 	void release (nano::message_buffer *);
 	// Stop container and notify waiting threads
@@ -188,6 +192,7 @@ public:
 	nano::tcp_message_manager tcp_message_manager;
 	nano::node & node;
 	nano::network_filter publish_filter;
+	nano::network_filter vote_filter;
 	nano::transport::udp_channels udp_channels;
 	nano::transport::tcp_channels tcp_channels;
 	std::atomic<uint16_t> port{ 0 };
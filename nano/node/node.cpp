@@ -85,7 +85,7 @@ node (io_ctx_a, application_path_a, alarm_a, nano::node_config (peering_port_a,
 }
 
 nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path const & application_path_a, nano::alarm & alarm_a, nano::node_config const & config_a, nano::work_pool & work_a, nano::node_flags flags_a, unsigned seq) :
-write_database_queue (!flags_a.force_use_write_database_queue && (config_a.rocksdb_config.enable || nano::using_rocksdb_in_tests ())),
+write_database_queue (!flags_a.force_use_write_database_queue && (config_a.rocksdb_config.enable || nano::using_rocksdb_in_tests ()), (config_a.lmdb_config.sync == nano::lmdb_config::sync_strategy::group_commit && !config_a.rocksdb_config.enable && !nano::using_rocksdb_in_tests ()) ? std::function<void()> ([this]() { store.sync (); }) : nullptr, config_a.lmdb_config.group_commit_max_latency),
 io_ctx (io_ctx_a),
 node_initialized_latch (1),
 config (config_a),
@@ -95,20 +95,22 @@ alarm (alarm_a),
 work (work_a),
 distributed_work (*this),
 logger (config_a.logging.min_time_between_log_output),
-store_impl (nano::make_store (logger, application_path_a, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_config, config_a.backup_before_upgrade, config_a.rocksdb_config.enable)),
+store_impl (nano::make_store (logger, application_path_a, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_config, config_a.backup_before_upgrade, config_a.rocksdb_config.enable, config_a.block_cache_max, config_a.account_cache_max)),
 store (*store_impl),
 wallets_store_impl (std::make_unique<nano::mdb_wallets_store> (application_path_a / "wallets.ldb", config_a.lmdb_config)),
 wallets_store (*wallets_store_impl),
 gap_cache (*this),
-ledger (store, stats, flags_a.generate_cache, [this]() { this->network.erase_below_version (network_params.protocol.protocol_version_min (true)); }),
+ledger (store, stats, flags_a.generate_cache, [this]() { this->network.erase_below_version (network_params.protocol.protocol_version_min (true)); }, flags_a.read_only ? boost::filesystem::path () : application_path_a / ((config_a.rocksdb_config.enable || nano::using_rocksdb_in_tests ()) ? "rocksdb_rep_weights.snapshot" : "rep_weights.snapshot")),
+unchecked (store, config_a.unchecked_memory_max),
 checker (config.signature_checker_threads),
+signature_pipeline (checker, stats, nano::signature_checker::batch_size * (config.signature_checker_threads + 1)),
 network (*this, config.peering_port),
 telemetry (std::make_shared<nano::telemetry> (network, alarm, worker, observers.telemetry, stats, network_params, flags.disable_ongoing_telemetry_requests)),
 bootstrap_initiator (*this),
 bootstrap (config.peering_port, *this),
 application_path (application_path_a),
 port_mapping (*this),
-vote_processor (checker, active, observers, stats, config, flags, logger, online_reps, ledger, network_params),
+vote_processor (signature_pipeline, active, observers, stats, config, flags, logger, online_reps, ledger, network_params),
 rep_crawler (*this),
 warmed_up (0),
 block_processor (*this, write_database_queue),
@@ -382,6 +384,25 @@ node_seq (seq)
 			std::exit (1);
 		}
 
+		ledger.pruning = flags.enable_pruning || ledger.cache.pruned_count > 0;
+		if (ledger.pruning)
+		{
+			if (config.enable_voting && !flags.inactive_node)
+			{
+				// Voting needs the representative and balance of arbitrary blocks, which pruned chains cannot provide
+				std::string str = "Incompatibility detected between config node.enable_voting and ledger pruning (--enable_pruning or an already pruned ledger)";
+				logger.always_log (str);
+				std::cerr << str << std::endl;
+				std::exit (1);
+			}
+			logger.always_log (boost::str (boost::format ("Ledger pruning is enabled, %1% blocks have been pruned") % ledger.cache.pruned_count));
+			if (!flags.enable_pruning && !flags.read_only)
+			{
+				// Pruned blocks cannot be restored, the node keeps treating them as existing but stops pruning further
+				logger.always_log ("Ledger contains pruned blocks but the --enable_pruning flag is not set, no more blocks will be pruned");
+			}
+		}
+
 		if (config.enable_voting)
 		{
 			std::ostringstream stream;
@@ -420,7 +441,7 @@ node_seq (seq)
 			if (!flags.disable_unchecked_drop && !use_bootstrap_weight && !flags.read_only)
 			{
 				auto transaction (store.tx_begin_write ({ tables::unchecked }));
-				store.unchecked_clear (transaction);
+				unchecked.clear (transaction);
 				logger.always_log ("Dropping unchecked blocks");
 			}
 		}
@@ -562,7 +583,9 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (collect_container_info (node.alarm, "alarm"));
 	composite->add_component (collect_container_info (node.work, "work"));
 	composite->add_component (collect_container_info (node.gap_cache, "gap_cache"));
+	composite->add_component (collect_container_info (node.unchecked, "unchecked"));
 	composite->add_component (collect_container_info (node.ledger, "ledger"));
+	composite->add_component (collect_container_info (node.store, "store"));
 	composite->add_component (collect_container_info (node.active, "active"));
 	composite->add_component (collect_container_info (node.bootstrap_initiator, "bootstrap_initiator"));
 	composite->add_component (collect_container_info (node.bootstrap, "bootstrap"));
@@ -574,6 +597,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (collect_container_info (node.observers, "observers"));
 	composite->add_component (collect_container_info (node.wallets, "wallets"));
 	composite->add_component (collect_container_info (node.vote_processor, "vote_processor"));
+	composite->add_component (collect_container_info (node.signature_pipeline, "signature_pipeline"));
 	composite->add_component (collect_container_info (node.rep_crawler, "rep_crawler"));
 	composite->add_component (collect_container_info (node.block_processor, "block_processor"));
 	composite->add_component (collect_container_info (node.block_arrival, "block_arrival"));
@@ -594,6 +618,24 @@ void nano::node::process_active (std::shared_ptr<nano::block> incoming)
 	block_processor.add (incoming, nano::seconds_since_epoch ());
 }
 
+void nano::node::process_local_async (std::shared_ptr<nano::block> block_a)
+{
+	// Add block hash as recently arrived to trigger automatic rebroadcast and election
+	block_arrival.add (block_a->hash ());
+	// Set current time to trigger automatic rebroadcast and election
+	nano::unchecked_info info (block_a, block_a->account (), nano::seconds_since_epoch (), nano::signature_verification::unknown);
+	block_processor.add (info, nano::block_source::local);
+}
+
+boost::optional<nano::process_return> nano::node::process_local_queued (std::shared_ptr<nano::block> block_a, bool const work_watcher_a)
+{
+	// Add block hash as recently arrived to trigger automatic rebroadcast and election
+	block_arrival.add (block_a->hash ());
+	// Set current time to trigger automatic rebroadcast and election
+	nano::unchecked_info info (block_a, block_a->account (), nano::seconds_since_epoch (), nano::signature_verification::unknown);
+	return block_processor.add_blocking (info, work_watcher_a);
+}
+
 nano::process_return nano::node::process (nano::block & block_a)
 {
 	auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }, { tables::confirmation_height }));
@@ -631,6 +673,13 @@ void nano::node::start ()
 			this_l->ongoing_unchecked_cleanup ();
 		});
 	}
+	if (flags.enable_pruning)
+	{
+		auto this_l (shared ());
+		worker.push_task ([this_l]() {
+			this_l->ongoing_ledger_pruning ();
+		});
+	}
 	ongoing_store_flush ();
 	if (!flags.disable_rep_crawler)
 	{
@@ -678,6 +727,12 @@ void nano::node::stop ()
 		{
 			block_processor_thread.join ();
 		}
+		if (unchecked.memory_size () != 0)
+		{
+			// Keep the unchecked blocks held in memory for the next start
+			auto transaction (store.tx_begin_write ({ tables::unchecked }));
+			unchecked.flush (transaction);
+		}
 		aggregator.stop ();
 		vote_processor.stop ();
 		active.stop ();
@@ -691,6 +746,7 @@ void nano::node::stop ()
 		bootstrap_initiator.stop ();
 		bootstrap.stop ();
 		port_mapping.stop ();
+		signature_pipeline.stop ();
 		checker.stop ();
 		wallets.stop ();
 		stats.stop ();
@@ -700,6 +756,8 @@ void nano::node::stop ()
 		{
 			epoch_upgrade->wait ();
 		}
+		// All ledger writers are stopped, lets the next start skip rebuilding rep weights
+		ledger.rep_weights_snapshot_write ();
 		// work pool is not stopped on purpose due to testing setup
 	}
 }
@@ -832,6 +890,17 @@ void nano::node::ongoing_store_flush ()
 		auto transaction (store.tx_begin_write ({ tables::vote }));
 		store.flush (transaction);
 	}
+	uint64_t hits;
+	uint64_t misses;
+	store.get_block_cache ().take_counts (hits, misses);
+	stats.add (nano::stat::type::block_cache, nano::stat::detail::hit, nano::stat::dir::in, hits);
+	stats.add (nano::stat::type::block_cache, nano::stat::detail::miss, nano::stat::dir::in, misses);
+	store.get_account_info_cache ().take_counts (hits, misses);
+	stats.add (nano::stat::type::account_info_cache, nano::stat::detail::hit, nano::stat::dir::in, hits);
+	stats.add (nano::stat::type::account_info_cache, nano::stat::detail::miss, nano::stat::dir::in, misses);
+	store.get_confirmation_height_cache ().take_counts (hits, misses);
+	stats.add (nano::stat::type::confirmation_height_cache, nano::stat::detail::hit, nano::stat::dir::in, hits);
+	stats.add (nano::stat::type::confirmation_height_cache, nano::stat::detail::miss, nano::stat::dir::in, misses);
 	std::weak_ptr<nano::node> node_w (shared_from_this ());
 	alarm.add (std::chrono::steady_clock::now () + std::chrono::seconds (5), [node_w]() {
 		if (auto node_l = node_w.lock ())
@@ -925,16 +994,15 @@ void nano::node::unchecked_cleanup ()
 		auto now (nano::seconds_since_epoch ());
 		auto transaction (store.tx_begin_read ());
 		// Max 1M records to clean, max 2 minutes reading to prevent slow i/o systems issues
-		for (auto i (store.unchecked_begin (transaction)), n (store.unchecked_end ()); i != n && cleaning_list.size () < 1024 * 1024 && nano::seconds_since_epoch () - now < 120; ++i)
-		{
-			nano::unchecked_key const & key (i->first);
-			nano::unchecked_info const & info (i->second);
+		unchecked.for_each (
+		transaction, [this, now, &digests, &cleaning_list](nano::unchecked_key const & key, nano::unchecked_info const & info) {
 			if ((now - info.modified) > static_cast<uint64_t> (config.unchecked_cutoff_time.count ()))
 			{
 				digests.push_back (network.publish_filter.hash (info.block));
 				cleaning_list.push_back (key);
 			}
-		}
+		},
+		[&cleaning_list, now]() { return cleaning_list.size () < 1024 * 1024 && nano::seconds_since_epoch () - now < 120; });
 	}
 	if (!cleaning_list.empty ())
 	{
@@ -949,9 +1017,9 @@ void nano::node::unchecked_cleanup ()
 		{
 			auto key (cleaning_list.front ());
 			cleaning_list.pop_front ();
-			if (store.unchecked_exists (transaction, key))
+			if (unchecked.exists (transaction, key))
 			{
-				store.unchecked_del (transaction, key);
+				unchecked.del (transaction, key);
 			}
 		}
 	}
@@ -970,6 +1038,129 @@ void nano::node::ongoing_unchecked_cleanup ()
 	});
 }
 
+bool nano::node::collect_ledger_pruning_targets (std::deque<nano::block_hash> & pruning_targets_a, nano::account & last_account_a, uint64_t const batch_read_size_a, uint64_t const max_depth_a, uint64_t const cutoff_time_a)
+{
+	uint64_t read_operations (0);
+	bool finish_transaction (false);
+	auto transaction (store.tx_begin_read ());
+	for (auto i (store.confirmation_height_begin (transaction, last_account_a)), n (store.confirmation_height_end ()); i != n && !finish_transaction;)
+	{
+		++read_operations;
+		auto const & account (i->first);
+		nano::block_hash hash (i->second.frontier);
+		uint64_t depth (0);
+		// The representative block of the cemented frontier is kept, rollbacks of uncemented blocks need to find it
+		auto representative (ledger.representative (transaction, hash));
+		auto representative_kept (representative.is_zero ());
+		while (!hash.is_zero () && (depth < max_depth_a || !representative_kept))
+		{
+			auto block (store.block_get (transaction, hash));
+			if (block != nullptr)
+			{
+				if (block->sideband ().timestamp > cutoff_time_a || depth == 0 || !representative_kept)
+				{
+					representative_kept = representative_kept || hash == representative;
+					hash = block->previous ();
+				}
+				else
+				{
+					break;
+				}
+			}
+			else
+			{
+				release_assert (depth != 0);
+				hash.clear ();
+			}
+			if (++depth % batch_read_size_a == 0)
+			{
+				transaction.refresh ();
+			}
+		}
+		if (!hash.is_zero ())
+		{
+			pruning_targets_a.push_back (hash);
+			stats.inc (nano::stat::type::pruning, nano::stat::detail::pruning_targets);
+		}
+		read_operations += depth;
+		if (read_operations >= batch_read_size_a)
+		{
+			last_account_a = account.number () + 1;
+			finish_transaction = true;
+		}
+		else
+		{
+			++i;
+		}
+	}
+	return !finish_transaction || last_account_a.is_zero ();
+}
+
+void nano::node::ledger_pruning (uint64_t const batch_size_a, bool bootstrap_weight_reached_a, bool log_to_cout_a)
+{
+	uint64_t const max_depth (config.max_pruning_depth != 0 ? config.max_pruning_depth : std::numeric_limits<uint64_t>::max ());
+	uint64_t const cutoff_time (bootstrap_weight_reached_a ? nano::seconds_since_epoch () - config.max_pruning_age.count () : std::numeric_limits<uint64_t>::max ());
+	uint64_t pruned_count (0);
+	uint64_t transaction_write_count (0);
+	nano::account last_account (1); // 0 Burn account is never opened. So it can be used to break loop
+	std::deque<nano::block_hash> pruning_targets;
+	bool target_finished (false);
+	while ((transaction_write_count != 0 || !target_finished) && !stopped)
+	{
+		// Search pruning targets
+		while (pruning_targets.size () < batch_size_a && !target_finished && !stopped)
+		{
+			target_finished = collect_ledger_pruning_targets (pruning_targets, last_account, batch_size_a * 2, max_depth, cutoff_time);
+		}
+		// Pruning write operation
+		transaction_write_count = 0;
+		if (!pruning_targets.empty () && !stopped)
+		{
+			auto scoped_write_guard = write_database_queue.wait (nano::writer::pruning);
+			auto write_transaction (store.tx_begin_write ({ tables::blocks, tables::pruned }));
+			while (!pruning_targets.empty () && transaction_write_count < batch_size_a && !stopped)
+			{
+				auto const & pruning_hash (pruning_targets.front ());
+				auto account_pruned_count (ledger.pruning_action (write_transaction, pruning_hash, batch_size_a));
+				transaction_write_count += account_pruned_count;
+				pruning_targets.pop_front ();
+			}
+			pruned_count += transaction_write_count;
+			auto log_message (boost::str (boost::format ("%1% blocks pruned") % pruned_count));
+			if (!log_to_cout_a)
+			{
+				logger.try_log (log_message);
+			}
+			else
+			{
+				std::cout << log_message << std::endl;
+			}
+		}
+	}
+	auto log_message (boost::str (boost::format ("Total recently pruned block count: %1%") % pruned_count));
+	if (!log_to_cout_a)
+	{
+		logger.always_log (log_message);
+	}
+	else
+	{
+		std::cout << log_message << std::endl;
+	}
+}
+
+void nano::node::ongoing_ledger_pruning ()
+{
+	auto bootstrap_weight_reached (ledger.cache.block_count >= ledger.bootstrap_weight_max_blocks);
+	ledger_pruning (flags.block_processor_batch_size != 0 ? flags.block_processor_batch_size : 2 * 1024, bootstrap_weight_reached, false);
+	auto ledger_pruning_interval (bootstrap_weight_reached ? config.max_pruning_age : std::min (config.max_pruning_age, std::chrono::seconds (15 * 60)));
+	auto this_l (shared ());
+	alarm.add (std::chrono::steady_clock::now () + ledger_pruning_interval, [this_l]() {
+		this_l->worker.push_task ([this_l]() {
+			this_l->ongoing_ledger_pruning ();
+		});
+	});
+}
+
 int nano::node::price (nano::uint128_t const & balance_a, int amount_a)
 {
 	debug_assert (balance_a >= amount_a * nano::Gxrb_ratio);
@@ -1242,11 +1433,13 @@ void nano::node::process_confirmed_data (nano::transaction const & transaction_a
 	}
 	// Faster amount calculation
 	auto previous (block_a->previous ());
-	auto previous_balance (ledger.balance (transaction_a, previous));
+	// The previous block may have been pruned after the block was cemented, the amount is then reported as 0
+	bool error_or_pruned (false);
+	auto previous_balance (ledger.balance_safe (transaction_a, previous, error_or_pruned));
 	auto block_balance (store.block_balance_calculated (block_a));
 	if (hash_a != ledger.network_params.ledger.genesis_account)
 	{
-		amount_a = block_balance > previous_balance ? block_balance - previous_balance : previous_balance - block_balance;
+		amount_a = error_or_pruned ? 0 : block_balance > previous_balance ? block_balance - previous_balance : previous_balance - block_balance;
 	}
 	else
 	{
@@ -1254,7 +1447,7 @@ void nano::node::process_confirmed_data (nano::transaction const & transaction_a
 	}
 	if (auto state = dynamic_cast<nano::state_block *> (block_a.get ()))
 	{
-		if (state->hashables.balance < previous_balance)
+		if (error_or_pruned ? state->sideband ().details.is_send : state->hashables.balance < previous_balance)
 		{
 			is_state_send_a = true;
 		}
@@ -1701,12 +1894,20 @@ nano::node_flags const & nano::inactive_node_flag_defaults ()
 	return node_flags;
 }
 
-std::unique_ptr<nano::block_store> nano::make_store (nano::logger_mt & logger, boost::filesystem::path const & path, bool read_only, bool add_db_postfix, nano::rocksdb_config const & rocksdb_config, nano::txn_tracking_config const & txn_tracking_config_a, std::chrono::milliseconds block_processor_batch_max_time_a, nano::lmdb_config const & lmdb_config_a, bool backup_before_upgrade, bool use_rocksdb_backend)
+std::unique_ptr<nano::block_store> nano::make_store (nano::logger_mt & logger, boost::filesystem::path const & path, bool read_only, bool add_db_postfix, nano::rocksdb_config const & rocksdb_config, nano::txn_tracking_config const & txn_tracking_config_a, std::chrono::milliseconds block_processor_batch_max_time_a, nano::lmdb_config const & lmdb_config_a, bool backup_before_upgrade, bool use_rocksdb_backend, size_t block_cache_max, size_t account_cache_max)
 {
+	std::unique_ptr<nano::block_store> result;
 	if (use_rocksdb_backend || using_rocksdb_in_tests ())
 	{
-		return std::make_unique<nano::rocksdb_store> (logger, add_db_postfix ? path / "rocksdb" : path, rocksdb_config, read_only);
+		result = std::make_unique<nano::rocksdb_store> (logger, add_db_postfix ? path / "rocksdb" : path, rocksdb_config, read_only);
 	}
-
-	return std::make_unique<nano::mdb_store> (logger, add_db_postfix ? path / "data.ldb" : path, txn_tracking_config_a, block_processor_batch_max_time_a, lmdb_config_a, backup_before_upgrade);
+	else
+	{
+		result = std::make_unique<nano::mdb_store> (logger, add_db_postfix ? path / "data.ldb" : path, txn_tracking_config_a, block_processor_batch_max_time_a, lmdb_config_a, backup_before_upgrade);
+	}
+	// Enabled once any upgrade has run, upgrades rewrite the blocks table directly
+	result->get_block_cache ().resize (block_cache_max);
+	result->get_account_info_cache ().resize (account_cache_max);
+	result->get_confirmation_height_cache ().resize (account_cache_max);
+	return result;
 }
@@ -25,6 +25,7 @@
 #include <nano/node/request_aggregator.hpp>
 #include <nano/node/signatures.hpp>
 #include <nano/node/telemetry.hpp>
+#include <nano/node/unchecked_map.hpp>
 #include <nano/node/vote_processor.hpp>
 #include <nano/node/wallet.hpp>
 #include <nano/node/write_database_queue.hpp>
@@ -115,6 +116,9 @@ public:
 	void process_active (std::shared_ptr<nano::block>);
 	nano::process_return process (nano::block &);
 	nano::process_return process_local (std::shared_ptr<nano::block>, bool const = false);
+	void process_local_async (std::shared_ptr<nano::block>);
+	/** As process_local, but queued on the block processor's local lane. No result if the node stopped first */
+	boost::optional<nano::process_return> process_local_queued (std::shared_ptr<nano::block>, bool const = false);
 	void keepalive_preconfigured (std::vector<std::string> const &);
 	nano::block_hash latest (nano::account const &);
 	nano::uint128_t balance (nano::account const &);
@@ -133,6 +137,9 @@ public:
 	void search_pending ();
 	void bootstrap_wallet ();
 	void unchecked_cleanup ();
+	bool collect_ledger_pruning_targets (std::deque<nano::block_hash> &, nano::account &, uint64_t const, uint64_t const, uint64_t const);
+	void ledger_pruning (uint64_t const, bool, bool);
+	void ongoing_ledger_pruning ();
 	int price (nano::uint128_t const &, int);
 	// The default difficulty updates to base only when the first epoch_2 block is processed
 	uint64_t default_difficulty (nano::work_version const) const;
@@ -176,7 +183,9 @@ public:
 	nano::wallets_store & wallets_store;
 	nano::gap_cache gap_cache;
 	nano::ledger ledger;
+	nano::unchecked_map unchecked;
 	nano::signature_checker checker;
+	nano::signature_pipeline signature_pipeline;
 	nano::network network;
 	std::shared_ptr<nano::telemetry> telemetry;
 	nano::bootstrap_initiator bootstrap_initiator;
@@ -84,16 +84,21 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("network_threads", network_threads, "Number of threads dedicated to processing network messages. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
 	toml.put ("work_threads", work_threads, "Number of threads dedicated to CPU generated work. Defaults to all available CPU threads.\ntype:uint64");
 	toml.put ("signature_checker_threads", signature_checker_threads, "Number of additional threads dedicated to signature verification. Defaults to number of CPU threads / 2.\ntype:uint64");
+	toml.put ("vote_processor_threads", vote_processor_threads, "Number of threads processing incoming votes. Votes are split among them by representative. Defaults to number of CPU threads / 4, and at least 1.\ntype:uint64,[1..]");
 	toml.put ("enable_voting", enable_voting, "Enable or disable voting. Enabling this option requires additional system resources, namely increased CPU, bandwidth and disk usage.\ntype:bool");
 	toml.put ("bootstrap_connections", bootstrap_connections, "Number of outbound bootstrap connections. Must be a power of 2. Defaults to 4.\nWarning: a larger amount of connections may use substantially more system memory.\ntype:uint64");
 	toml.put ("bootstrap_connections_max", bootstrap_connections_max, "Maximum number of inbound bootstrap connections. Defaults to 64.\nWarning: a larger amount of connections may use additional system memory.\ntype:uint64");
 	toml.put ("bootstrap_initiator_threads", bootstrap_initiator_threads, "Number of threads dedicated to concurrent bootstrap attempts. Defaults to 1.\nWarning: a larger amount of attempts may use additional system memory and disk IO.\ntype:uint64");
 	toml.put ("lmdb_max_dbs", deprecated_lmdb_max_dbs, "DEPRECATED: use node.lmdb.max_databases instead.\nMaximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large number of wallets is required (see https://docs.nano.org/integration-guides/key-management/).\ntype:uint64");
 	toml.put ("block_processor_batch_max_time", block_processor_batch_max_time.count (), "The maximum time the block processor can continuously process blocks for.\ntype:milliseconds");
+	toml.put ("account_cache_max", account_cache_max, "Number of account infos, and separately of confirmation heights, kept in memory, about 0.2KB each, to serve repeated account lookups without reading the database. 0 disables the caches.\ntype:uint64");
+	toml.put ("block_cache_max", block_cache_max, "Number of recently used blocks kept deserialized in memory, about 0.5KB each, to serve repeated block lookups without reading the database. 0 disables the cache.\ntype:uint64");
 	toml.put ("allow_local_peers", allow_local_peers, "Enable or disable local host peering.\ntype:bool");
 	toml.put ("vote_minimum", vote_minimum.to_string_dec (), "Local representatives do not vote if the delegated weight is under this threshold. Saves on system resources.\ntype:string,amount,raw");
 	toml.put ("vote_generator_delay", vote_generator_delay.count (), "Delay before votes are sent to allow for efficient bundling of hashes in votes.\ntype:milliseconds");
 	toml.put ("vote_generator_threshold", vote_generator_threshold, "Number of bundled hashes required for an additional generator delay.\ntype:uint64,[1..11]");
+	toml.put ("vote_generator_coalesce_delay", vote_generator_coalesce_delay.count (), "Maximum time a confirmation request waits so replies to requests arriving together can share votes.\ntype:milliseconds");
+	toml.put ("unchecked_memory_max", unchecked_memory_max, "Number of unchecked blocks kept in memory, about 0.5KB each, so blocks whose dependency arrives soon after are never written to disk. Older blocks and those above this number go to the unchecked table. 0 keeps every unchecked block in the table.\ntype:uint64");
 	toml.put ("unchecked_cutoff_time", unchecked_cutoff_time.count (), "Number of seconds before deleting an unchecked entry.\nWarning: lower values (e.g., 3600 seconds, or 1 hour) may result in unsuccessful bootstraps, especially a bootstrap from scratch.\ntype:seconds");
 	toml.put ("tcp_io_timeout", tcp_io_timeout.count (), "Timeout for TCP connect-, read- and write operations.\nWarning: a low value (e.g., below 5 seconds) may result in TCP connections failing.\ntype:seconds");
 	toml.put ("pow_sleep_interval", pow_sleep_interval.count (), "Time to sleep between batch work generation attempts. Reduces max CPU usage at the expense of a longer generation time.\ntype:nanoseconds");
@@ -111,6 +116,10 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("max_work_generate_multiplier", max_work_generate_multiplier, "Maximum allowed difficulty multiplier for work generation.\ntype:double,[1..]");
 	toml.put ("frontiers_confirmation", serialize_frontiers_confirmation (frontiers_confirmation), "Mode controlling frontier confirmation rate.\ntype:string,{auto,always,disabled}");
 	toml.put ("max_queued_requests", max_queued_requests, "Limit for number of queued confirmation requests for one channel, after which new requests are dropped until the queue drops below this value.\ntype:uint32");
+	toml.put ("block_processor_priority_local", block_processor_priority_local, "Number of blocks the block processor takes in turn from the queue of locally created blocks.\ntype:uint32,[1..]");
+	toml.put ("block_processor_priority_live", block_processor_priority_live, "Number of blocks the block processor takes in turn from the queue of blocks published on the live network.\ntype:uint32,[1..]");
+	toml.put ("block_processor_priority_unchecked", block_processor_priority_unchecked, "Number of blocks the block processor takes in turn from the queue of unchecked blocks whose dependencies arrived.\ntype:uint32,[1..]");
+	toml.put ("block_processor_priority_bootstrap", block_processor_priority_bootstrap, "Number of blocks the block processor takes in turn from the queue of bootstrapped blocks.\ntype:uint32,[1..]");
 
 	auto work_peers_l (toml.create_array ("work_peers", "A list of \"address:port\" entries to identify work peers."));
 	for (auto i (work_peers.begin ()), n (work_peers.end ()); i != n; ++i)
@@ -137,6 +146,8 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	{
 		secondary_work_peers_l->push_back (boost::str (boost::format ("%1%:%2%") % i->first % i->second));
 	}
+	experimental_l.put ("max_pruning_age", max_pruning_age.count (), "Time limit for blocks age after pruning.\ntype:seconds");
+	experimental_l.put ("max_pruning_depth", max_pruning_depth, "Limit for full blocks in chain after pruning.\ntype:uint64");
 	toml.put_child ("experimental", experimental_l);
 
 	nano::tomlconfig callback_l;
@@ -294,14 +305,23 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 
 		toml.get<unsigned> ("vote_generator_threshold", vote_generator_threshold);
 
+		auto coalesce_delay_l = vote_generator_coalesce_delay.count ();
+		toml.get ("vote_generator_coalesce_delay", coalesce_delay_l);
+		vote_generator_coalesce_delay = std::chrono::milliseconds (coalesce_delay_l);
+
 		auto block_processor_batch_max_time_l = block_processor_batch_max_time.count ();
 		toml.get ("block_processor_batch_max_time", block_processor_batch_max_time_l);
 		block_processor_batch_max_time = std::chrono::milliseconds (block_processor_batch_max_time_l);
 
+		toml.get<size_t> ("block_cache_max", block_cache_max);
+		toml.get<size_t> ("account_cache_max", account_cache_max);
+
 		auto unchecked_cutoff_time_l = static_cast<unsigned long> (unchecked_cutoff_time.count ());
 		toml.get ("unchecked_cutoff_time", unchecked_cutoff_time_l);
 		unchecked_cutoff_time = std::chrono::seconds (unchecked_cutoff_time_l);
 
+		toml.get<size_t> ("unchecked_memory_max", unchecked_memory_max);
+
 		auto tcp_io_timeout_l = static_cast<unsigned long> (tcp_io_timeout.count ());
 		toml.get ("tcp_io_timeout", tcp_io_timeout_l);
 		tcp_io_timeout = std::chrono::seconds (tcp_io_timeout_l);
@@ -320,6 +340,7 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get<bool> ("enable_voting", enable_voting);
 		toml.get<bool> ("allow_local_peers", allow_local_peers);
 		toml.get<unsigned> (signature_checker_threads_key, signature_checker_threads);
+		toml.get<unsigned> ("vote_processor_threads", vote_processor_threads);
 
 		auto lmdb_max_dbs_default = deprecated_lmdb_max_dbs;
 		toml.get<int> ("lmdb_max_dbs", deprecated_lmdb_max_dbs);
@@ -372,6 +393,10 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get<double> ("max_work_generate_multiplier", max_work_generate_multiplier);
 
 		toml.get<uint32_t> ("max_queued_requests", max_queued_requests);
+		toml.get<uint32_t> ("block_processor_priority_local", block_processor_priority_local);
+		toml.get<uint32_t> ("block_processor_priority_live", block_processor_priority_live);
+		toml.get<uint32_t> ("block_processor_priority_unchecked", block_processor_priority_unchecked);
+		toml.get<uint32_t> ("block_processor_priority_bootstrap", block_processor_priority_bootstrap);
 
 		if (toml.has_key ("frontiers_confirmation"))
 		{
@@ -389,6 +414,10 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 					this->deserialize_address (entry_a, this->secondary_work_peers);
 				});
 			}
+			auto max_pruning_age_l (max_pruning_age.count ());
+			experimental_config_l.get ("max_pruning_age", max_pruning_age_l);
+			max_pruning_age = std::chrono::seconds (max_pruning_age_l);
+			experimental_config_l.get<uint64_t> ("max_pruning_depth", max_pruning_depth);
 		}
 
 		// Validate ranges
@@ -409,6 +438,10 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		{
 			toml.get_error ().set ("io_threads must be non-zero");
 		}
+		if (vote_processor_threads == 0)
+		{
+			toml.get_error ().set ("vote_processor_threads must be non-zero");
+		}
 		if (active_elections_size <= 250 && !network.is_dev_network ())
 		{
 			toml.get_error ().set ("active_elections_size must be greater than 250");
@@ -425,6 +458,14 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		{
 			toml.get_error ().set ("work_watcher_period must be equal or larger than 1");
 		}
+		if (block_processor_priority_local == 0 || block_processor_priority_live == 0 || block_processor_priority_unchecked == 0 || block_processor_priority_bootstrap == 0)
+		{
+			toml.get_error ().set ("block_processor_priority values must be greater than 0");
+		}
+		if (max_pruning_age < std::chrono::seconds (5 * 60) && !network_params.network.is_dev_network ())
+		{
+			toml.get_error ().set ("max_pruning_age must be greater than or equal to 5 minutes");
+		}
 		if (max_work_generate_multiplier < 1)
 		{
 			toml.get_error ().set ("max_work_generate_multiplier must be greater than or equal to 1");
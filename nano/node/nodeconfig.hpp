@@ -54,6 +54,7 @@ public:
 	nano::amount vote_minimum{ nano::Gxrb_ratio };
 	std::chrono::milliseconds vote_generator_delay{ std::chrono::milliseconds (100) };
 	unsigned vote_generator_threshold{ 3 };
+	std::chrono::milliseconds vote_generator_coalesce_delay{ std::chrono::milliseconds (10) };
 	nano::amount online_weight_minimum{ 60000 * nano::Gxrb_ratio };
 	unsigned online_weight_quorum{ 50 };
 	unsigned election_hint_weight_percent{ 10 };
@@ -63,6 +64,7 @@ public:
 	unsigned work_threads{ std::max<unsigned> (4, std::thread::hardware_concurrency ()) };
 	/* Use half available threads on the system for signature checking. The calling thread does checks as well, so these are extra worker threads */
 	unsigned signature_checker_threads{ std::thread::hardware_concurrency () / 2 };
+	unsigned vote_processor_threads{ std::max<unsigned> (1, std::thread::hardware_concurrency () / 4) };
 	bool enable_voting{ false };
 	unsigned bootstrap_connections{ 4 };
 	unsigned bootstrap_connections_max{ 64 };
@@ -81,6 +83,12 @@ public:
 	uint16_t external_port{ 0 };
 	std::chrono::milliseconds block_processor_batch_max_time{ network_params.network.is_dev_network () ? std::chrono::milliseconds (500) : std::chrono::milliseconds (5000) };
 	std::chrono::seconds unchecked_cutoff_time{ std::chrono::seconds (4 * 60 * 60) }; // 4 hours
+	/** Unchecked blocks kept in memory before they spill into the unchecked table, 0 keeps them all in the table */
+	size_t unchecked_memory_max{ 0 };
+	/** Deserialized blocks kept in the store's block cache, 0 disables the cache */
+	size_t block_cache_max{ 0 };
+	/** Account infos and confirmation heights each kept in the store's account caches, 0 disables the caches */
+	size_t account_cache_max{ 0 };
 	/** Timeout for initiated async operations */
 	std::chrono::seconds tcp_io_timeout{ (network_params.network.is_dev_network () && !is_sanitizer_build) ? std::chrono::seconds (5) : std::chrono::seconds (15) };
 	std::chrono::nanoseconds pow_sleep_interval{ 0 };
@@ -100,6 +108,15 @@ public:
 	std::chrono::seconds work_watcher_period{ std::chrono::seconds (5) };
 	double max_work_generate_multiplier{ 64. };
 	uint32_t max_queued_requests{ 512 };
+	/** Weights of the block processor input lanes, local and live blocks are preferred so elections do not wait behind bootstrap */
+	uint32_t block_processor_priority_local{ 16 };
+	uint32_t block_processor_priority_live{ 8 };
+	uint32_t block_processor_priority_unchecked{ 4 };
+	uint32_t block_processor_priority_bootstrap{ 1 };
+	/** Only blocks cemented longer than this ago are pruned, the default (1 day) is intentionally conservative */
+	std::chrono::seconds max_pruning_age{ !network_params.network.is_beta_network () ? std::chrono::seconds (24 * 60 * 60) : std::chrono::seconds (5 * 60) };
+	/** Maximum number of cemented blocks kept per account, the frontier included. 0 disables the depth limit, only max_pruning_age applies */
+	uint64_t max_pruning_depth{ 0 };
 	nano::rocksdb_config rocksdb_config;
 	nano::lmdb_config lmdb_config;
 	nano::frontiers_confirmation_mode frontiers_confirmation{ nano::frontiers_confirmation_mode::automatic };
@@ -141,6 +158,7 @@ public:
 	bool force_use_write_database_queue{ false }; // For testing only. RocksDB does not use the database queue, but some tests rely on it being used.
 	bool fast_bootstrap{ false };
 	bool read_only{ false };
+	bool enable_pruning{ false };
 	nano::confirmation_height_mode confirmation_height_processor_mode{ nano::confirmation_height_mode::automatic };
 	nano::generate_cache generate_cache;
 	bool inactive_node{ false };
@@ -161,25 +161,44 @@ std::vector<std::shared_ptr<nano::block>> nano::request_aggregator::aggregate (s
 	size_t cached_hashes = 0;
 	std::vector<std::shared_ptr<nano::block>> to_generate;
 	std::vector<std::shared_ptr<nano::vote>> cached_votes;
-	for (auto const & hash_root : requests_a)
+	std::vector<std::shared_ptr<nano::block>> blocks (requests_a.size ());
+	std::vector<bool> cached (requests_a.size (), false);
+	std::vector<nano::block_hash> ledger_hashes;
+	std::vector<size_t> ledger_indices;
+	for (size_t i (0), n (requests_a.size ()); i < n; ++i)
 	{
+		auto const & hash_root (requests_a[i]);
 		// 1. Votes in cache
 		auto find_votes (local_votes.votes (hash_root.second, hash_root.first));
 		if (!find_votes.empty ())
 		{
 			++cached_hashes;
+			cached[i] = true;
 			cached_votes.insert (cached_votes.end (), find_votes.begin (), find_votes.end ());
 		}
 		else
 		{
 			// 2. Election winner by hash
-			auto block = active.winner (hash_root.first);
-
-			// 3. Ledger by hash
-			if (block == nullptr)
+			blocks[i] = active.winner (hash_root.first);
+			if (blocks[i] == nullptr)
 			{
-				block = ledger.store.block_get (transaction, hash_root.first);
+				ledger_hashes.push_back (hash_root.first);
+				ledger_indices.push_back (i);
 			}
+		}
+	}
+	// 3. Ledger by hash, looked up in a single batch
+	auto ledger_blocks (ledger.store.block_get_batch (transaction, ledger_hashes));
+	for (size_t i (0), n (ledger_blocks.size ()); i < n; ++i)
+	{
+		blocks[ledger_indices[i]] = std::move (ledger_blocks[i]);
+	}
+	for (size_t i (0), n (requests_a.size ()); i < n; ++i)
+	{
+		if (!cached[i])
+		{
+			auto const & hash_root (requests_a[i]);
+			auto & block (blocks[i]);
 
 			// 4. Ledger by root
 			if (block == nullptr && !hash_root.second.is_zero ())
@@ -34,6 +34,9 @@ public:
 private:
 	std::function<void(rocksdb::FlushJobInfo const &)> flush_completed_cb;
 };
+
+/** Meta key holding the first block not yet converted by the v21 upgrade, present only while that upgrade is incomplete */
+nano::uint256_union const upgrade_v21_progress_key (2);
 }
 
 namespace nano
@@ -138,14 +141,101 @@ void nano::rocksdb_store::open (bool & error_a, boost::filesystem::path const &
 
 	if (!error_a)
 	{
-		auto transaction = tx_begin_read ();
-		auto version_l = version_get (transaction);
+		auto version_l = version_get (tx_begin_read ());
 		if (version_l > version)
 		{
 			error_a = true;
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
 		}
+		else if (version_l < version)
+		{
+			if (open_read_only_a)
+			{
+				// Fresh and unversioned ledgers are read as they are, only a partially upgraded one mixes both block formats
+				auto transaction (tx_begin_read ());
+				if (exists (transaction, tables::meta, nano::rocksdb_val (upgrade_v21_progress_key)))
+				{
+					error_a = true;
+					logger.always_log ("The ledger has an interrupted upgrade, which cannot be completed in read only mode");
+				}
+				else
+				{
+					blocks_legacy_format = blocks_begin (transaction) != blocks_end ();
+				}
+			}
+			else
+			{
+				auto transaction (tx_begin_write ());
+				error_a |= do_upgrades (transaction);
+			}
+		}
+	}
+}
+
+bool nano::rocksdb_store::do_upgrades (nano::write_transaction & transaction_a)
+{
+	auto error (false);
+	auto version_l = version_get (transaction_a);
+	switch (version_l)
+	{
+		// The version was not stored before v21, so version_get () reports the minimum version for any older RocksDB ledger
+		case 14:
+		case 15:
+		case 16:
+		case 17:
+		case 18:
+		case 19:
+		case 20:
+			upgrade_v20_to_v21 (transaction_a);
+		case 21:
+			break;
+		default:
+			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is not supported for upgrades") % version_l));
+			error = true;
+			break;
+	}
+	return error;
+}
+
+void nano::rocksdb_store::upgrade_v20_to_v21 (nano::write_transaction & transaction_a)
+{
+	logger.always_log ("Preparing v20 to v21 database upgrade...");
+	// An interrupted upgrade resumes from the first block it had not converted, every block before it is in the compact format
+	nano::block_hash start (0);
+	nano::rocksdb_val progress;
+	if (success (get (transaction_a, tables::meta, nano::rocksdb_val (upgrade_v21_progress_key), progress)))
+	{
+		start = static_cast<nano::block_hash> (progress);
+		logger.always_log (boost::str (boost::format ("Resuming the upgrade from block %1%") % start.to_string ()));
+	}
+	// Old entries are read from a snapshot so rewriting them does not disturb the iteration
+	auto transaction_l (tx_begin_read ());
+	auto const batch_size (max_block_write_batch_num ());
+	uint64_t count (0);
+	for (auto i (make_iterator<nano::block_hash, nano::block_w_sideband> (transaction_l, tables::blocks, nano::rocksdb_val (start))), n (nano::store_iterator<nano::block_hash, nano::block_w_sideband> (nullptr)); i != n; ++i)
+	{
+		if (count > 0 && count % batch_size == 0)
+		{
+			// Commit in batches so the pending writes of a large ledger stay within the memtable budget
+			auto status (put (transaction_a, tables::meta, nano::rocksdb_val (upgrade_v21_progress_key), nano::rocksdb_val (i->first)));
+			release_assert (success (status));
+			transaction_a.commit ();
+			transaction_a.renew ();
+			logger.always_log (boost::str (boost::format ("%1% blocks converted") % count));
+		}
+		std::vector<uint8_t> data;
+		block_serialize (data, *i->second.block, i->second.sideband);
+		auto status (put (transaction_a, tables::blocks, i->first, nano::rocksdb_val (data.size (), data.data ())));
+		release_assert (success (status));
+		++count;
+	}
+	if (exists (transaction_a, tables::meta, nano::rocksdb_val (upgrade_v21_progress_key)))
+	{
+		auto status (del (transaction_a, tables::meta, nano::rocksdb_val (upgrade_v21_progress_key)));
+		release_assert (success (status));
 	}
+	version_put (transaction_a, 21);
+	logger.always_log ("Finished upgrading all blocks to the compact format");
 }
 
 void nano::rocksdb_store::generate_tombstone_map ()
@@ -288,6 +378,8 @@ std::vector<rocksdb::ColumnFamilyDescriptor> nano::rocksdb_store::create_column_
 
 nano::write_transaction nano::rocksdb_store::tx_begin_write (std::vector<nano::tables> const & tables_requiring_locks_a, std::vector<nano::tables> const & tables_no_locks_a)
 {
+	// The cache sequence is sampled before the snapshot is taken
+	auto cache_sequence (cache_order.sequence ());
 	std::unique_ptr<nano::write_rocksdb_txn> txn;
 	release_assert (optimistic_db != nullptr);
 	if (tables_requiring_locks_a.empty () && tables_no_locks_a.empty ())
@@ -303,12 +395,13 @@ nano::write_transaction nano::rocksdb_store::tx_begin_write (std::vector<nano::t
 	// Tables must be kept in alphabetical order. These can be used for mutex locking, so order is important to prevent deadlocking
 	debug_assert (std::is_sorted (tables_requiring_locks_a.begin (), tables_requiring_locks_a.end ()));
 
-	return nano::write_transaction{ std::move (txn) };
+	return nano::write_transaction{ std::move (txn), &cache_order, cache_sequence };
 }
 
 nano::read_transaction nano::rocksdb_store::tx_begin_read ()
 {
-	return nano::read_transaction{ std::make_unique<nano::read_rocksdb_txn> (db.get ()) };
+	auto cache_sequence (cache_order.sequence ());
+	return nano::read_transaction{ std::make_unique<nano::read_rocksdb_txn> (db.get ()), &cache_order, cache_sequence };
 }
 
 std::string nano::rocksdb_store::vendor_get () const
@@ -443,6 +536,35 @@ int nano::rocksdb_store::get (nano::transaction const & transaction_a, tables ta
 	return status.code ();
 }
 
+void nano::rocksdb_store::get_batch (nano::transaction const & transaction_a, tables table_a, std::vector<nano::rocksdb_val> const & keys_a, std::vector<nano::rocksdb_val> & values_a, std::vector<int> & statuses_a) const
+{
+	std::vector<rocksdb::Slice> keys (keys_a.begin (), keys_a.end ());
+	std::vector<rocksdb::ColumnFamilyHandle *> handles (keys.size (), table_to_column_family (table_a));
+	std::vector<std::string> values;
+	std::vector<rocksdb::Status> statuses;
+	if (is_read (transaction_a))
+	{
+		statuses = db->MultiGet (snapshot_options (transaction_a), handles, keys, &values);
+	}
+	else
+	{
+		rocksdb::ReadOptions options;
+		statuses = tx (transaction_a)->MultiGet (options, handles, keys, &values);
+	}
+
+	values_a.assign (keys.size (), nano::rocksdb_val{});
+	statuses_a.resize (keys.size ());
+	for (size_t i (0), n (keys.size ()); i < n; ++i)
+	{
+		statuses_a[i] = statuses[i].code ();
+		if (statuses[i].ok ())
+		{
+			values_a[i].buffer = std::make_shared<std::vector<uint8_t>> (values[i].begin (), values[i].end ());
+			values_a[i].convert_buffer_to_value ();
+		}
+	}
+}
+
 int nano::rocksdb_store::put (nano::write_transaction const & transaction_a, tables table_a, nano::rocksdb_val const & key_a, nano::rocksdb_val const & value_a)
 {
 	debug_assert (transaction_a.contains (table_a));
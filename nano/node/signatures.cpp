@@ -1,9 +1,14 @@
 #include <nano/boost/asio/post.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/stats.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/node/signatures.hpp>
 
+size_t constexpr nano::signature_checker::batch_size;
+size_t constexpr nano::signature_checker::batch_size_min;
+std::chrono::microseconds constexpr nano::signature_checker::batch_latency_target;
+
 nano::signature_checker::signature_checker (unsigned num_threads) :
 thread_pool (num_threads),
 single_threaded (num_threads == 0),
@@ -28,7 +33,8 @@ void nano::signature_checker::verify (nano::signature_check_set & check_a)
 		return;
 	}
 
-	if (check_a.size <= batch_size || single_threaded)
+	auto batch_size_l (batch_size_for (check_a.size));
+	if (check_a.size <= batch_size_l || single_threaded)
 	{
 		// Not dealing with many so just use the calling thread for checking signatures
 		auto result = verify_batch (check_a, 0, check_a.size);
@@ -37,23 +43,23 @@ void nano::signature_checker::verify (nano::signature_check_set & check_a)
 	}
 
 	// Split up the tasks equally over the calling thread and the thread pool.
-	// Any overflow on the modulus of the batch_size is given to the calling thread, so the thread pool
-	// only ever operates on batch_size sizes.
-	size_t overflow_size = check_a.size % batch_size;
-	size_t num_full_batches = check_a.size / batch_size;
+	// Any overflow on the modulus of the batch size is given to the calling thread, so the thread pool
+	// only ever operates on batch_size_l sizes.
+	size_t overflow_size = check_a.size % batch_size_l;
+	size_t num_full_batches = check_a.size / batch_size_l;
 
 	auto total_threads_to_split_over = num_threads + 1;
 	auto num_base_batches_each = num_full_batches / total_threads_to_split_over;
 	auto num_full_overflow_batches = num_full_batches % total_threads_to_split_over;
 
-	auto size_calling_thread = (num_base_batches_each * batch_size) + overflow_size;
+	auto size_calling_thread = (num_base_batches_each * batch_size_l) + overflow_size;
 	auto num_full_batches_thread = (num_base_batches_each * num_threads);
 	if (num_full_overflow_batches > 0)
 	{
 		if (overflow_size == 0)
 		{
 			// Give the calling thread priority over any batches when there is no excess remainder.
-			size_calling_thread += batch_size;
+			size_calling_thread += batch_size_l;
 			num_full_batches_thread += num_full_overflow_batches - 1;
 		}
 		else
@@ -62,13 +68,13 @@ void nano::signature_checker::verify (nano::signature_check_set & check_a)
 		}
 	}
 
-	release_assert (check_a.size == (num_full_batches_thread * batch_size + size_calling_thread));
+	release_assert (check_a.size == (num_full_batches_thread * batch_size_l + size_calling_thread));
 
 	std::promise<void> promise;
 	std::future<void> future = promise.get_future ();
 
 	// Verify a number of signature batches over the thread pool (does not block)
-	verify_async (check_a, num_full_batches_thread, promise);
+	verify_async (check_a, num_full_batches_thread, batch_size_l, promise);
 
 	// Verify the rest on the calling thread, this operates on the signatures at the end of the check set
 	auto result = verify_batch (check_a, check_a.size - size_calling_thread, size_calling_thread);
@@ -92,24 +98,46 @@ void nano::signature_checker::flush ()
 		;
 }
 
+size_t nano::signature_checker::batch_size_for (size_t size_a) const
+{
+	// Spread the set evenly over the thread pool and the calling thread
+	auto result ((size_a + num_threads) / (num_threads + 1));
+	// Once the verification cost is known, keep each batch within the latency target
+	auto cost (nanoseconds_per_signature.load ());
+	if (cost != 0)
+	{
+		result = std::min<size_t> (result, std::chrono::nanoseconds (batch_latency_target).count () / cost);
+	}
+	// Whole multiples of the smallest batch
+	return std::max (batch_size_min, std::min (batch_size, result) / batch_size_min * batch_size_min);
+}
+
 bool nano::signature_checker::verify_batch (const nano::signature_check_set & check_a, size_t start_index, size_t size)
 {
+	auto begin (std::chrono::steady_clock::now ());
 	nano::validate_message_batch (check_a.messages + start_index, check_a.message_lengths + start_index, check_a.pub_keys + start_index, check_a.signatures + start_index, size, check_a.verifications + start_index);
+	if (size >= batch_size_min)
+	{
+		// Small sets are dominated by fixed overhead and would overestimate the cost, racing updates only lose a sample
+		uint64_t sample (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count () / size);
+		auto previous (nanoseconds_per_signature.load ());
+		nanoseconds_per_signature = previous == 0 ? sample : (previous * 7 + sample) / 8;
+	}
 	return std::all_of (check_a.verifications + start_index, check_a.verifications + start_index + size, [](int verification) { return verification == 0 || verification == 1; });
 }
 
-/* This operates on a number of signatures of size (num_batches * batch_size) from the beginning of the check_a pointers.
+/* This operates on a number of signatures of size (num_batches * batch_size_a) from the beginning of the check_a pointers.
  * Caller should check the value of the promise which indicates when the work has been completed.
  */
-void nano::signature_checker::verify_async (nano::signature_check_set & check_a, size_t num_batches, std::promise<void> & promise)
+void nano::signature_checker::verify_async (nano::signature_check_set & check_a, size_t num_batches, size_t batch_size_a, std::promise<void> & promise)
 {
 	auto task = std::make_shared<Task> (check_a, num_batches);
 	++tasks_remaining;
 
 	for (size_t batch = 0; batch < num_batches; ++batch)
 	{
-		auto size = batch_size;
-		auto start_index = batch * batch_size;
+		auto size = batch_size_a;
+		auto start_index = batch * batch_size_a;
 
 		boost::asio::post (thread_pool, [this, task, size, start_index, &promise] {
 			auto result = this->verify_batch (task->check, start_index, size);
@@ -148,3 +176,238 @@ void nano::signature_checker::set_thread_names (unsigned num_threads)
 		future.wait ();
 	}
 }
+
+nano::signature_cache::signature_cache (size_t size_a) :
+items (size_a, 0)
+{
+	debug_assert (size_a > 0);
+}
+
+size_t nano::signature_cache::lookup (nano::signature_check_set const & check_a, std::vector<nano::uint128_t> & digests_a) const
+{
+	// Each entry is digested as message || public key || signature, the last two have a fixed size so the concatenation is unambiguous
+	size_t total (0);
+	for (size_t i (0); i < check_a.size; ++i)
+	{
+		total += check_a.message_lengths[i] + sizeof (nano::public_key) + sizeof (nano::signature);
+	}
+	std::vector<uint8_t> bytes (total);
+	std::vector<uint8_t const *> entries (check_a.size);
+	std::vector<size_t> sizes (check_a.size);
+	auto entry (bytes.data ());
+	for (size_t i (0); i < check_a.size; ++i)
+	{
+		entries[i] = entry;
+		entry = std::copy (check_a.messages[i], check_a.messages[i] + check_a.message_lengths[i], entry);
+		entry = std::copy (check_a.pub_keys[i], check_a.pub_keys[i] + sizeof (nano::public_key), entry);
+		entry = std::copy (check_a.signatures[i], check_a.signatures[i] + sizeof (nano::signature), entry);
+		sizes[i] = entry - entries[i];
+	}
+	digests_a.resize (check_a.size);
+	hasher.hash (entries.data (), sizes.data (), check_a.size, digests_a.data ());
+	size_t result (0);
+	nano::lock_guard<std::mutex> guard (mutex);
+	for (size_t i (0); i < check_a.size; ++i)
+	{
+		auto const & digest (digests_a[i]);
+		check_a.verifications[i] = digest != 0 && items[static_cast<size_t> (digest % items.size ())] == digest ? 1 : 0;
+		result += check_a.verifications[i];
+	}
+	return result;
+}
+
+void nano::signature_cache::insert (nano::signature_check_set const & check_a, std::vector<nano::uint128_t> const & digests_a)
+{
+	debug_assert (digests_a.size () == check_a.size);
+	nano::lock_guard<std::mutex> guard (mutex);
+	for (size_t i (0); i < check_a.size; ++i)
+	{
+		if (check_a.verifications[i] == 1)
+		{
+			auto const & digest (digests_a[i]);
+			items[static_cast<size_t> (digest % items.size ())] = digest;
+		}
+	}
+}
+
+std::chrono::milliseconds constexpr nano::signature_pipeline::block_deadline;
+size_t constexpr nano::signature_pipeline::cache_size;
+
+nano::signature_pipeline::signature_pipeline (nano::signature_checker & checker_a, nano::stat & stats_a, size_t batch_max_a, size_t cache_size_a) :
+checker (checker_a),
+stats (stats_a),
+batch_max (batch_max_a),
+cache (cache_size_a),
+thread ([this]() {
+	nano::thread_role::set (nano::thread_role::name::signature_pipeline);
+	run ();
+})
+{
+}
+
+nano::signature_pipeline::~signature_pipeline ()
+{
+	stop ();
+}
+
+void nano::signature_pipeline::add (nano::signature_check_set & check_a, nano::signature_source source_a, std::function<void()> const & callback_a)
+{
+	nano::signature_pipeline::request request{ &check_a, std::chrono::steady_clock::now (), callback_a };
+	auto hits (cache.lookup (check_a, request.digests));
+	request.misses.reserve (check_a.size - hits);
+	for (size_t i (0); i < check_a.size; ++i)
+	{
+		if (check_a.verifications[i] != 1)
+		{
+			request.misses.push_back (i);
+		}
+	}
+	stats.add (nano::stat::type::signature_cache, nano::stat::detail::hit, nano::stat::dir::in, hits);
+	stats.add (nano::stat::type::signature_cache, nano::stat::detail::miss, nano::stat::dir::in, request.misses.size ());
+	nano::unique_lock<std::mutex> lock (mutex);
+	if (request.misses.empty ())
+	{
+		lock.unlock ();
+		callback_a ();
+	}
+	else if (!stopped)
+	{
+		queued += request.misses.size ();
+		queues[static_cast<size_t> (source_a)].push_back (std::move (request));
+		lock.unlock ();
+		condition.notify_all ();
+	}
+	else
+	{
+		// The pipeline thread is gone, verify on the caller's thread
+		lock.unlock ();
+		verify_batch ({ std::move (request) });
+	}
+}
+
+void nano::signature_pipeline::verify (nano::signature_check_set & check_a, nano::signature_source source_a)
+{
+	std::promise<void> promise;
+	add (check_a, source_a, [&promise]() {
+		promise.set_value ();
+	});
+	promise.get_future ().wait ();
+}
+
+void nano::signature_pipeline::stop ()
+{
+	{
+		nano::lock_guard<std::mutex> guard (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+size_t nano::signature_pipeline::size ()
+{
+	nano::lock_guard<std::mutex> guard (mutex);
+	return queued;
+}
+
+void nano::signature_pipeline::run ()
+{
+	nano::unique_lock<std::mutex> lock (mutex);
+	// Sets still queued when stopping are passed through so no producer is left waiting
+	while (!stopped || !queues[0].empty () || !queues[1].empty ())
+	{
+		if (!queues[0].empty () || !queues[1].empty ())
+		{
+			auto batch (next_batch ());
+			lock.unlock ();
+			verify_batch (batch);
+			lock.lock ();
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+}
+
+std::vector<nano::signature_pipeline::request> nano::signature_pipeline::next_batch ()
+{
+	std::vector<nano::signature_pipeline::request> result;
+	size_t size (0);
+	auto cutoff (std::chrono::steady_clock::now () - block_deadline);
+	auto take = [this, &result, &size, cutoff](nano::signature_source source_a, bool overdue_only_a) {
+		auto & queue (queues[static_cast<size_t> (source_a)]);
+		while (!queue.empty () && (result.empty () || size + queue.front ().misses.size () <= batch_max) && (!overdue_only_a || queue.front ().arrival <= cutoff))
+		{
+			size += queue.front ().misses.size ();
+			result.push_back (std::move (queue.front ()));
+			queue.pop_front ();
+		}
+	};
+	take (nano::signature_source::block, true);
+	take (nano::signature_source::vote, false);
+	take (nano::signature_source::block, false);
+	queued -= size;
+	return result;
+}
+
+void nano::signature_pipeline::verify_batch (std::vector<nano::signature_pipeline::request> const & batch_a)
+{
+	if (batch_a.size () == 1 && batch_a.front ().misses.size () == batch_a.front ().check->size)
+	{
+		checker.verify (*batch_a.front ().check);
+	}
+	else
+	{
+		size_t size (0);
+		for (auto const & request : batch_a)
+		{
+			size += request.misses.size ();
+		}
+		std::vector<unsigned char const *> messages;
+		messages.reserve (size);
+		std::vector<size_t> lengths;
+		lengths.reserve (size);
+		std::vector<unsigned char const *> pub_keys;
+		pub_keys.reserve (size);
+		std::vector<unsigned char const *> signatures;
+		signatures.reserve (size);
+		std::vector<int> verifications (size, 0);
+		for (auto const & request : batch_a)
+		{
+			auto const & check (*request.check);
+			for (auto index : request.misses)
+			{
+				messages.push_back (check.messages[index]);
+				lengths.push_back (check.message_lengths[index]);
+				pub_keys.push_back (check.pub_keys[index]);
+				signatures.push_back (check.signatures[index]);
+			}
+		}
+		nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
+		checker.verify (check);
+		auto verification (verifications.begin ());
+		for (auto const & request : batch_a)
+		{
+			for (auto index : request.misses)
+			{
+				request.check->verifications[index] = *verification++;
+			}
+		}
+	}
+	for (auto const & request : batch_a)
+	{
+		cache.insert (*request.check, request.digests);
+		request.callback ();
+	}
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (signature_pipeline & signature_pipeline, const std::string & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "signatures", signature_pipeline.size (), sizeof (unsigned char const *) * 3 + sizeof (size_t) + sizeof (int) }));
+	return composite;
+}
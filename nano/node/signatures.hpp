@@ -1,14 +1,23 @@
 #pragma once
 
 #include <nano/boost/asio/thread_pool.hpp>
+#include <nano/lib/locks.hpp>
 #include <nano/lib/utility.hpp>
+#include <nano/secure/network_filter.hpp>
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
 #include <future>
 #include <mutex>
+#include <thread>
 
 namespace nano
 {
+class stat;
+
 class signature_check_set final
 {
 public:
@@ -35,7 +44,14 @@ public:
 	void stop ();
 	void flush ();
 
+	/** Largest batch handed to a single thread */
 	static size_t constexpr batch_size = 256;
+	/** Smallest batch handed to a single thread, below this handing work to the pool costs more than it saves */
+	static size_t constexpr batch_size_min = 64;
+	/** Batches are sized so a thread verifies one in about this time */
+	static std::chrono::microseconds constexpr batch_latency_target{ 4000 };
+	/** Batch size for a set of \p size_a signatures, spreading it over all threads within batch_latency_target */
+	size_t batch_size_for (size_t size_a) const;
 
 private:
 	struct Task final
@@ -53,12 +69,103 @@ private:
 	};
 
 	bool verify_batch (const nano::signature_check_set & check_a, size_t index, size_t size);
-	void verify_async (nano::signature_check_set & check_a, size_t num_batches, std::promise<void> & promise);
+	void verify_async (nano::signature_check_set & check_a, size_t num_batches, size_t batch_size_a, std::promise<void> & promise);
 	void set_thread_names (unsigned num_threads);
 	boost::asio::thread_pool thread_pool;
 	std::atomic<int> tasks_remaining{ 0 };
 	const bool single_threaded;
 	unsigned num_threads;
 	std::atomic<bool> stopped{ false };
+	/** Moving average of the verification time of a signature, 0 until the first batch is verified */
+	std::atomic<uint64_t> nanoseconds_per_signature{ 0 };
+};
+
+/** Producers of signatures verified through nano::signature_pipeline, in descending priority */
+enum class signature_source : uint8_t
+{
+	vote,
+	block
+};
+
+/**
+ * Bounded set of (message, public key, signature) entries already known to be valid, so duplicates arriving from
+ * several peers or through both live and bootstrap traffic are verified once.
+ * Entries are keyed by a SipHash 2/4/128 digest with a random key. The full digest is stored and compared, new entries overwrite the one in their slot.
+ * @note This class is thread-safe.
+ */
+class signature_cache final
+{
+public:
+	explicit signature_cache (size_t size_a);
+	/**
+	 * Computes the digest of every entry of \p check_a into \p digests_a sets the verification of entries known to be valid to 1 and of the others to 0.
+	 * @return the number of entries found
+	 */
+	size_t lookup (nano::signature_check_set const & check_a, std::vector<nano::uint128_t> & digests_a) const;
+	/** Inserts the digest of every entry of \p check_a whose verification is 1 */
+	void insert (nano::signature_check_set const & check_a, std::vector<nano::uint128_t> const & digests_a);
+
+private:
+	/** Only used for its randomly keyed, batched digests */
+	nano::network_filter hasher{ 1 };
+	mutable std::mutex mutex;
+	/** Digests of valid entries, zero marks an empty slot */
+	std::vector<nano::uint128_t> items;
 };
+
+/**
+ * Verifies signature sets from several producers on one thread, combining them into large signature_checker batches.
+ * A batch is dispatched as soon as the previous one finishes, so a lone set is verified without waiting
+ * while sets arriving during a batch are combined into the next one.
+ * Votes are taken first, unless a block set has been queued for longer than block_deadline.
+ * Signatures found in the signature cache are not queued, valid ones are added to it once verified.
+ */
+class signature_pipeline final
+{
+public:
+	signature_pipeline (nano::signature_checker &, nano::stat &, size_t batch_max_a, size_t cache_size_a = cache_size);
+	~signature_pipeline ();
+	/** Queues \p check_a, which must stay valid until \p callback_a is called from the pipeline thread with its verifications filled in */
+	void add (nano::signature_check_set & check_a, nano::signature_source, std::function<void()> const & callback_a);
+	/** Queues \p check_a and blocks until it is verified */
+	void verify (nano::signature_check_set & check_a, nano::signature_source);
+	void stop ();
+	/** Number of queued signatures */
+	size_t size ();
+
+	/** Block sets queued for longer than this are taken before votes */
+	static std::chrono::milliseconds constexpr block_deadline{ 1000 };
+	static size_t constexpr cache_size{ 256 * 1024 };
+
+private:
+	class request final
+	{
+	public:
+		nano::signature_check_set * check;
+		std::chrono::steady_clock::time_point arrival;
+		std::function<void()> callback;
+		/** Cache digest of every signature in check */
+		std::vector<nano::uint128_t> digests;
+		/** Indices of the signatures in check which still have to be verified */
+		std::vector<size_t> misses;
+	};
+	void run ();
+	std::vector<nano::signature_pipeline::request> next_batch ();
+	void verify_batch (std::vector<nano::signature_pipeline::request> const &);
+
+	nano::signature_checker & checker;
+	nano::stat & stats;
+	size_t const batch_max;
+	nano::signature_cache cache;
+	std::array<std::deque<nano::signature_pipeline::request>, 2> queues;
+	size_t queued{ 0 };
+	bool stopped{ false };
+	std::mutex mutex;
+	nano::condition_variable condition;
+	std::thread thread;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (signature_pipeline &, const std::string &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (signature_pipeline & signature_pipeline, const std::string & name);
 }
@@ -60,6 +60,10 @@ public:
 	{
 		return queue_size >= queue_size_max * 2;
 	}
+	size_t get_queue_size () const
+	{
+		return queue_size;
+	}
 
 protected:
 	/** Holds the buffer and callback for queued writes */
@@ -9,8 +9,29 @@
 
 #include <boost/format.hpp>
 
-nano::state_block_signature_verification::state_block_signature_verification (nano::signature_checker & signature_checker, nano::epochs & epochs, nano::node_config & node_config, nano::logger_mt & logger, uint64_t state_block_signature_verification_size) :
-signature_checker (signature_checker),
+std::string nano::to_string (nano::block_source const source_a)
+{
+	std::string result ("invalid");
+	switch (source_a)
+	{
+		case nano::block_source::local:
+			result = "local";
+			break;
+		case nano::block_source::live:
+			result = "live";
+			break;
+		case nano::block_source::bootstrap:
+			result = "bootstrap";
+			break;
+		case nano::block_source::unchecked:
+			result = "unchecked";
+			break;
+	}
+	return result;
+}
+
+nano::state_block_signature_verification::state_block_signature_verification (nano::signature_pipeline & signature_pipeline, nano::epochs & epochs, nano::node_config & node_config, nano::logger_mt & logger, uint64_t state_block_signature_verification_size) :
+signature_pipeline (signature_pipeline),
 epochs (epochs),
 node_config (node_config),
 logger (logger),
@@ -74,11 +95,11 @@ bool nano::state_block_signature_verification::is_active ()
 	return active;
 }
 
-void nano::state_block_signature_verification::add (nano::unchecked_info const & info_a)
+void nano::state_block_signature_verification::add (nano::block_processor_item const & item_a)
 {
 	{
 		nano::lock_guard<std::mutex> guard (mutex);
-		state_blocks.push_back (info_a);
+		state_blocks.push_back (item_a);
 	}
 	condition.notify_one ();
 }
@@ -89,9 +110,9 @@ size_t nano::state_block_signature_verification::size ()
 	return state_blocks.size ();
 }
 
-std::deque<nano::unchecked_info> nano::state_block_signature_verification::setup_items (size_t max_count)
+std::deque<nano::block_processor_item> nano::state_block_signature_verification::setup_items (size_t max_count)
 {
-	std::deque<nano::unchecked_info> items;
+	std::deque<nano::block_processor_item> items;
 	if (state_blocks.size () <= max_count)
 	{
 		items.swap (state_blocks);
@@ -108,7 +129,7 @@ std::deque<nano::unchecked_info> nano::state_block_signature_verification::setup
 	return items;
 }
 
-void nano::state_block_signature_verification::verify_state_blocks (std::deque<nano::unchecked_info> & items)
+void nano::state_block_signature_verification::verify_state_blocks (std::deque<nano::block_processor_item> & items)
 {
 	if (!items.empty ())
 	{
@@ -131,8 +152,9 @@ void nano::state_block_signature_verification::verify_state_blocks (std::deque<n
 		signatures.reserve (size);
 		std::vector<int> verifications;
 		verifications.resize (size, 0);
-		for (auto & item : items)
+		for (auto & queued : items)
 		{
+			auto const & item (queued.info);
 			hashes.push_back (item.block->hash ());
 			messages.push_back (hashes.back ().bytes.data ());
 			lengths.push_back (sizeof (decltype (hashes)::value_type));
@@ -151,7 +173,7 @@ void nano::state_block_signature_verification::verify_state_blocks (std::deque<n
 			signatures.push_back (blocks_signatures.back ().bytes.data ());
 		}
 		nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
-		signature_checker.verify (check);
+		signature_pipeline.verify (check, nano::signature_source::block);
 		if (node_config.logging.timing_logging () && timer_l.stop () > std::chrono::milliseconds (10))
 		{
 			logger.try_log (boost::str (boost::format ("Batch verified %1% state blocks in %2% %3%") % size % timer_l.value ().count () % timer_l.unit ()));
@@ -163,6 +185,6 @@ void nano::state_block_signature_verification::verify_state_blocks (std::deque<n
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (state_block_signature_verification & state_block_signature_verification, const std::string & name)
 {
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "state_blocks", state_block_signature_verification.size (), sizeof (nano::unchecked_info) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "state_blocks", state_block_signature_verification.size (), sizeof (nano::block_processor_item) }));
 	return composite;
 }
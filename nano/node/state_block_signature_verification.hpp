@@ -3,6 +3,7 @@
 #include <nano/lib/locks.hpp>
 #include <nano/secure/common.hpp>
 
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <thread>
@@ -12,23 +13,45 @@ namespace nano
 class epochs;
 class logger_mt;
 class node_config;
-class signature_checker;
+class signature_pipeline;
+
+/** Input lanes of the block processor, see block_processor::next */
+enum class block_source : uint8_t
+{
+	local,
+	live,
+	bootstrap,
+	unchecked
+};
+std::string to_string (nano::block_source const);
+
+/** A block waiting in the block processor together with the lane it was queued on and when */
+class block_processor_item final
+{
+public:
+	nano::unchecked_info info;
+	nano::block_source source{ nano::block_source::live };
+	std::chrono::steady_clock::time_point arrival;
+	/** Set by block_processor::add_blocking, called with the ledger result once the batch holding the block is committed */
+	std::function<void(nano::process_return const &)> processed;
+	bool watch_work{ false };
+};
 
 class state_block_signature_verification
 {
 public:
-	state_block_signature_verification (nano::signature_checker &, nano::epochs &, nano::node_config &, nano::logger_mt &, uint64_t);
+	state_block_signature_verification (nano::signature_pipeline &, nano::epochs &, nano::node_config &, nano::logger_mt &, uint64_t);
 	~state_block_signature_verification ();
-	void add (nano::unchecked_info const & info_a);
+	void add (nano::block_processor_item const & item_a);
 	size_t size ();
 	void stop ();
 	bool is_active ();
 
-	std::function<void(std::deque<nano::unchecked_info> &, std::vector<int> const &, std::vector<nano::block_hash> const &, std::vector<nano::signature> const &)> blocks_verified_callback;
+	std::function<void(std::deque<nano::block_processor_item> &, std::vector<int> const &, std::vector<nano::block_hash> const &, std::vector<nano::signature> const &)> blocks_verified_callback;
 	std::function<void()> transition_inactive_callback;
 
 private:
-	nano::signature_checker & signature_checker;
+	nano::signature_pipeline & signature_pipeline;
 	nano::epochs & epochs;
 	nano::node_config & node_config;
 	nano::logger_mt & logger;
@@ -36,13 +59,13 @@ private:
 	std::mutex mutex;
 	bool stopped{ false };
 	bool active{ false };
-	std::deque<nano::unchecked_info> state_blocks;
+	std::deque<nano::block_processor_item> state_blocks;
 	nano::condition_variable condition;
 	std::thread thread;
 
 	void run (uint64_t block_processor_verification_size);
-	std::deque<nano::unchecked_info> setup_items (size_t);
-	void verify_state_blocks (std::deque<nano::unchecked_info> &);
+	std::deque<nano::block_processor_item> setup_items (size_t);
+	void verify_state_blocks (std::deque<nano::block_processor_item> &);
 };
 
 std::unique_ptr<nano::container_info_component> collect_container_info (state_block_signature_verification & state_block_signature_verification, const std::string & name);
@@ -99,6 +99,16 @@ void nano::transport::channel_tcp::send_buffer (nano::shared_const_buffer const
 	}
 }
 
+size_t nano::transport::channel_tcp::queue_depth () const
+{
+	size_t result (0);
+	if (auto socket_l = socket.lock ())
+	{
+		result = socket_l->get_queue_size ();
+	}
+	return result;
+}
+
 std::string nano::transport::channel_tcp::to_string () const
 {
 	if (auto socket_l = socket.lock ())
@@ -93,9 +93,29 @@ void nano::transport::channel::send (nano::message const & message_a, std::funct
 	auto detail (visitor.result);
 	auto is_droppable_by_limiter = drop_policy_a == nano::buffer_drop_policy::limiter;
 	auto should_drop (node.network.limiter.should_drop (buffer.size ()));
+	auto class_l (nano::transport::to_traffic_class (message_a.header.type));
+	auto decision (nano::transport::outbound_scheduler::decision::drop);
 	if (!is_droppable_by_limiter || !should_drop)
 	{
-		send_buffer (buffer, callback_a, drop_policy_a);
+		decision = scheduler->admit (class_l, queue_depth (), drop_policy_a);
+	}
+	if (decision == nano::transport::outbound_scheduler::decision::send)
+	{
+		send_buffer (
+		buffer, [scheduler_l = scheduler, node_w = std::weak_ptr<nano::node> (node.shared ()), detail, class_l, start = std::chrono::steady_clock::now (), callback_a](boost::system::error_code const & ec, size_t size_a) {
+			auto latency (std::chrono::steady_clock::now () - start);
+			scheduler_l->complete (class_l, size_a, latency, !ec);
+			auto node_l (node_w.lock ());
+			if (node_l && !ec)
+			{
+				node_l->stats.add (nano::stat::type::outbound_latency, detail, nano::stat::dir::out, std::chrono::duration_cast<std::chrono::milliseconds> (latency).count ());
+			}
+			if (callback_a)
+			{
+				callback_a (ec, size_a);
+			}
+		},
+		drop_policy_a);
 		node.stats.inc (nano::stat::type::message, detail, nano::stat::dir::out);
 	}
 	else
@@ -107,7 +127,14 @@ void nano::transport::channel::send (nano::message const & message_a, std::funct
 			});
 		}
 
-		node.stats.inc (nano::stat::type::drop, detail, nano::stat::dir::out);
+		if (is_droppable_by_limiter && should_drop)
+		{
+			node.stats.inc (nano::stat::type::drop, detail, nano::stat::dir::out);
+		}
+		else
+		{
+			node.stats.inc (decision == nano::transport::outbound_scheduler::decision::coalesce ? nano::stat::type::outbound_coalesce : nano::stat::type::outbound_drop, detail, nano::stat::dir::out);
+		}
 		if (node.config.logging.network_packet_logging ())
 		{
 			auto key = static_cast<uint8_t> (detail) << 8;
@@ -116,6 +143,128 @@ void nano::transport::channel::send (nano::message const & message_a, std::funct
 	}
 }
 
+nano::transport::traffic_class nano::transport::to_traffic_class (nano::message_type type_a)
+{
+	auto result (nano::transport::traffic_class::control);
+	switch (type_a)
+	{
+		case nano::message_type::confirm_ack:
+			result = nano::transport::traffic_class::vote;
+			break;
+		case nano::message_type::confirm_req:
+			result = nano::transport::traffic_class::confirm_req;
+			break;
+		case nano::message_type::publish:
+			result = nano::transport::traffic_class::publish;
+			break;
+		case nano::message_type::keepalive:
+			result = nano::transport::traffic_class::keepalive;
+			break;
+		case nano::message_type::telemetry_req:
+		case nano::message_type::telemetry_ack:
+			result = nano::transport::traffic_class::telemetry;
+			break;
+		default:
+			break;
+	}
+	return result;
+}
+
+std::chrono::milliseconds constexpr nano::transport::outbound_scheduler::lagging_latency;
+
+size_t nano::transport::outbound_scheduler::limit (nano::transport::traffic_class class_a)
+{
+	auto result (nano::socket::queue_size_max);
+	switch (class_a)
+	{
+		case nano::transport::traffic_class::control:
+		case nano::transport::traffic_class::vote:
+			break;
+		case nano::transport::traffic_class::confirm_req:
+			result = nano::socket::queue_size_max * 3 / 4;
+			break;
+		case nano::transport::traffic_class::publish:
+			result = nano::socket::queue_size_max / 2;
+			break;
+		case nano::transport::traffic_class::keepalive:
+		case nano::transport::traffic_class::telemetry:
+			result = nano::socket::queue_size_max / 4;
+			break;
+	}
+	return result;
+}
+
+nano::transport::outbound_scheduler::decision nano::transport::outbound_scheduler::admit (nano::transport::traffic_class class_a, size_t queue_depth_a, nano::buffer_drop_policy policy_a)
+{
+	auto result (decision::send);
+	if (policy_a != nano::buffer_drop_policy::no_socket_drop && class_a != nano::transport::traffic_class::control)
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		auto limit_l (limit (class_a));
+		// Votes keep the full queue even when lagging, they are what peers need most
+		if (latency_average > lagging_latency.count () && class_a != nano::transport::traffic_class::vote)
+		{
+			limit_l /= 2;
+		}
+		auto index (static_cast<size_t> (class_a));
+		if (queue_depth_a >= limit_l)
+		{
+			result = decision::drop;
+		}
+		else if ((class_a == nano::transport::traffic_class::keepalive || class_a == nano::transport::traffic_class::telemetry) && queue_depth_a > 0 && pending[index] > 0)
+		{
+			result = decision::coalesce;
+		}
+	}
+	if (result == decision::send)
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		++pending[static_cast<size_t> (class_a)];
+	}
+	return result;
+}
+
+void nano::transport::outbound_scheduler::complete (nano::transport::traffic_class class_a, size_t size_a, std::chrono::steady_clock::duration latency_a, bool success_a)
+{
+	// Exponential moving averages, each sample contributing 1/8
+	double constexpr weight{ 0.125 };
+	auto now (std::chrono::steady_clock::now ());
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto & pending_l (pending[static_cast<size_t> (class_a)]);
+	debug_assert (pending_l > 0);
+	pending_l -= pending_l > 0 ? 1 : 0;
+	if (success_a)
+	{
+		latency_average += weight * (std::chrono::duration_cast<std::chrono::milliseconds> (latency_a).count () - latency_average);
+		// Writes complete in order, so the time since the previous completion is the time spent writing this one
+		auto service (std::min<std::chrono::steady_clock::duration> (latency_a, now - last_completion));
+		auto seconds (std::chrono::duration<double> (service).count ());
+		if (seconds > 0)
+		{
+			throughput_average += weight * (size_a / seconds - throughput_average);
+		}
+		last_completion = now;
+	}
+}
+
+bool nano::transport::outbound_scheduler::lagging () const
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return latency_average > lagging_latency.count ();
+}
+
+std::chrono::milliseconds nano::transport::outbound_scheduler::latency () const
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return std::chrono::milliseconds (static_cast<std::chrono::milliseconds::rep> (latency_average));
+}
+
+uint64_t nano::transport::outbound_scheduler::throughput () const
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return static_cast<uint64_t> (throughput_average);
+}
+
 namespace
 {
 boost::asio::ip::address_v6 mapped_from_v4_bytes (unsigned long address_a)
@@ -34,6 +34,54 @@ namespace transport
 		udp = 1,
 		tcp = 2
 	};
+	/** Outbound message classes in descending priority, lower priority classes are dropped first when a peer falls behind */
+	enum class traffic_class : uint8_t
+	{
+		control, // node_id_handshake and bootstrap messages, never shaped
+		vote,
+		confirm_req,
+		publish,
+		keepalive,
+		telemetry
+	};
+	nano::transport::traffic_class to_traffic_class (nano::message_type);
+	/**
+	 * Per channel outbound scheduler. Admits messages by class against the depth of the channel's write queue,
+	 * tracks the peer's write latency and throughput and sheds low priority traffic while the peer lags
+	 * so the socket write queue stays short.
+	 */
+	class outbound_scheduler final
+	{
+	public:
+		enum class decision
+		{
+			send,
+			/** Dropped as the write queue is too deep for the class */
+			drop,
+			/** Dropped as an equivalent message of the same class is still waiting in the write queue */
+			coalesce
+		};
+		decision admit (nano::transport::traffic_class, size_t queue_depth_a, nano::buffer_drop_policy);
+		/** Records the completion of an admitted message, \p latency_a being the time since it was admitted */
+		void complete (nano::transport::traffic_class, size_t size_a, std::chrono::steady_clock::duration latency_a, bool success_a);
+		bool lagging () const;
+		/** Moving average of the time between admitting a message and its write completing */
+		std::chrono::milliseconds latency () const;
+		/** Moving average of the write throughput in bytes per second */
+		uint64_t throughput () const;
+		/** Peers are lagging once the average write latency exceeds this */
+		static std::chrono::milliseconds constexpr lagging_latency{ 500 };
+
+	private:
+		static size_t constexpr class_count{ static_cast<size_t> (nano::transport::traffic_class::telemetry) + 1 };
+		/** Write queue depth at which a class stops being admitted, lagging peers get half of it */
+		static size_t limit (nano::transport::traffic_class);
+		mutable std::mutex mutex;
+		std::array<size_t, class_count> pending{};
+		double latency_average{ 0 };
+		double throughput_average{ 0 };
+		std::chrono::steady_clock::time_point last_completion;
+	};
 	class channel
 	{
 	public:
@@ -47,6 +95,11 @@ namespace transport
 		virtual nano::endpoint get_endpoint () const = 0;
 		virtual nano::tcp_endpoint get_tcp_endpoint () const = 0;
 		virtual nano::transport::transport_type get_type () const = 0;
+		/** Number of writes waiting in the channel's own queue */
+		virtual size_t queue_depth () const
+		{
+			return 0;
+		}
 
 		std::chrono::steady_clock::time_point get_last_bootstrap_attempt () const
 		{
@@ -128,6 +181,8 @@ namespace transport
 		boost::optional<nano::account> node_id{ boost::none };
 		std::atomic<uint8_t> network_version{ 0 };
 
+		std::shared_ptr<nano::transport::outbound_scheduler> const scheduler{ std::make_shared<nano::transport::outbound_scheduler> () };
+
 	protected:
 		nano::node & node;
 	};
@@ -521,7 +521,7 @@ public:
 };
 }
 
-void nano::transport::udp_channels::receive_action (nano::message_buffer * data_a)
+void nano::transport::udp_channels::receive_action (nano::message_buffer * data_a, nano::uint128_t const * digest_a)
 {
 	auto allowed_sender (true);
 	if (data_a->endpoint == get_local_endpoint ())
@@ -539,8 +539,8 @@ void nano::transport::udp_channels::receive_action (nano::message_buffer * data_
 	if (allowed_sender)
 	{
 		udp_message_visitor visitor (node, data_a->endpoint);
-		nano::message_parser parser (node.network.publish_filter, node.block_uniquer, node.vote_uniquer, visitor, node.work, node.ledger.cache.epoch_2_started);
-		parser.deserialize_buffer (data_a->buffer, data_a->size);
+		nano::message_parser parser (node.network.publish_filter, node.block_uniquer, node.vote_uniquer, visitor, node.work, node.ledger.cache.epoch_2_started, &node.network.vote_filter, data_a->endpoint);
+		parser.deserialize_buffer (data_a->buffer, data_a->size, digest_a);
 		if (parser.status == nano::message_parser::parse_status::success)
 		{
 			node.stats.add (nano::stat::type::traffic_udp, nano::stat::dir::in, data_a->size);
@@ -549,6 +549,10 @@ void nano::transport::udp_channels::receive_action (nano::message_buffer * data_
 		{
 			node.stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_publish);
 		}
+		else if (parser.status == nano::message_parser::parse_status::duplicate_confirm_ack_message)
+		{
+			node.stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_confirm_ack);
+		}
 		else
 		{
 			node.stats.inc (nano::stat::type::error);
@@ -590,6 +594,7 @@ void nano::transport::udp_channels::receive_action (nano::message_buffer * data_
 					node.stats.inc (nano::stat::type::udp, nano::stat::detail::outdated_version);
 					break;
 				case nano::message_parser::parse_status::duplicate_publish_message:
+				case nano::message_parser::parse_status::duplicate_confirm_ack_message:
 				case nano::message_parser::parse_status::success:
 					/* Already checked, unreachable */
 					break;
@@ -609,15 +614,74 @@ void nano::transport::udp_channels::receive_action (nano::message_buffer * data_
 
 void nano::transport::udp_channels::process_packets ()
 {
+	std::vector<nano::uint128_t> storage;
+	std::vector<nano::uint128_t const *> digests;
 	while (!stopped)
 	{
-		auto data (node.network.buffer_container.dequeue ());
-		if (data == nullptr)
+		auto buffers (node.network.buffer_container.dequeue (packet_batch_size));
+		if (buffers.empty ())
 		{
 			break;
 		}
-		receive_action (data);
-		node.network.buffer_container.release (data);
+		digest_packets (buffers, storage, digests);
+		for (size_t i (0); i < buffers.size (); ++i)
+		{
+			receive_action (buffers[i], digests[i]);
+			node.network.buffer_container.release (buffers[i]);
+		}
+	}
+}
+
+void nano::transport::udp_channels::digest_packets (std::vector<nano::message_buffer *> const & buffers_a, std::vector<nano::uint128_t> & storage_a, std::vector<nano::uint128_t const *> & digests_a)
+{
+	// Digests must not move once pointers to them are handed out
+	storage_a.resize (buffers_a.size ());
+	digests_a.assign (buffers_a.size (), nullptr);
+	std::array<std::vector<size_t>, 2> indices;
+	auto & publish_indices (indices[0]);
+	auto & confirm_ack_indices (indices[1]);
+	for (size_t i (0); i < buffers_a.size (); ++i)
+	{
+		auto const & buffer (*buffers_a[i]);
+		if (buffer.size > nano::message_header::size && buffer.size <= nano::message_parser::max_safe_udp_message_size)
+		{
+			auto error (false);
+			nano::bufferstream stream (buffer.buffer, buffer.size);
+			nano::message_header header (error, stream);
+			if (!error)
+			{
+				if (header.type == nano::message_type::publish)
+				{
+					publish_indices.push_back (i);
+				}
+				else if (header.type == nano::message_type::confirm_ack)
+				{
+					confirm_ack_indices.push_back (i);
+				}
+			}
+		}
+	}
+	std::array<nano::network_filter *, 2> filters{ &node.network.publish_filter, &node.network.vote_filter };
+	std::vector<uint8_t const *> bodies;
+	std::vector<size_t> sizes;
+	std::vector<nano::uint128_t> results;
+	for (size_t f (0); f < filters.size (); ++f)
+	{
+		bodies.clear ();
+		sizes.clear ();
+		for (auto i : indices[f])
+		{
+			bodies.push_back (buffers_a[i]->buffer + nano::message_header::size);
+			sizes.push_back (buffers_a[i]->size - nano::message_header::size);
+		}
+		results.resize (bodies.size ());
+		filters[f]->hash (bodies.data (), sizes.data (), bodies.size (), results.data ());
+		for (size_t j (0); j < indices[f].size (); ++j)
+		{
+			auto i (indices[f][j]);
+			storage_a[i] = results[j];
+			digests_a[i] = &storage_a[i];
+		}
 	}
 }
 
@@ -93,7 +93,7 @@ namespace transport
 		void stop ();
 		void send (nano::shared_const_buffer const & buffer_a, nano::endpoint endpoint_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a);
 		nano::endpoint get_local_endpoint () const;
-		void receive_action (nano::message_buffer *);
+		void receive_action (nano::message_buffer *, nano::uint128_t const * = nullptr);
 		void process_packets ();
 		std::shared_ptr<nano::transport::channel> create (nano::endpoint const &);
 		bool max_ip_connections (nano::endpoint const &);
@@ -109,6 +109,10 @@ namespace transport
 
 	private:
 		void close_socket ();
+		/** Digests the bodies of the publish and confirm_ack messages in \p buffers_a in one batch per filter, \p digests_a [i] is left null for any other buffer */
+		void digest_packets (std::vector<nano::message_buffer *> const & buffers_a, std::vector<nano::uint128_t> & storage_a, std::vector<nano::uint128_t const *> & digests_a);
+		/** Maximum number of received buffers taken by process_packets at once */
+		static size_t constexpr packet_batch_size{ 64 };
 		class endpoint_tag
 		{
 		};
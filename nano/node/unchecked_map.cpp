@@ -0,0 +1,208 @@
+#include <nano/node/unchecked_map.hpp>
+#include <nano/secure/blockstore.hpp>
+
+nano::unchecked_map::unchecked_map (nano::block_store & store_a, size_t memory_max_a, std::chrono::seconds spill_age_a) :
+memory_max (memory_max_a),
+spill_age (spill_age_a),
+store (store_a)
+{
+	table_empty = false;
+	if (memory_max != 0 && !store.init_error ())
+	{
+		auto transaction (store.tx_begin_read ());
+		table_empty = store.unchecked_begin (transaction) == store.unchecked_end ();
+	}
+}
+
+void nano::unchecked_map::put (nano::write_transaction const & transaction_a, nano::unchecked_key const & key_a, nano::unchecked_info const & info_a)
+{
+	nano::unique_lock<std::mutex> lock (mutex, std::defer_lock);
+	if (memory_max != 0)
+	{
+		lock.lock ();
+	}
+	if (memory_max != 0 && (table_empty || !store.unchecked_exists (transaction_a, key_a)))
+	{
+		// Same as overwriting the row in the table, the entry is renewed
+		auto & keys (entries.get<tag_key> ());
+		auto existing (keys.find (boost::make_tuple (key_a.previous, key_a.hash)));
+		if (existing != keys.end ())
+		{
+			keys.erase (existing);
+		}
+		entries.get<tag_sequence> ().push_back ({ key_a.previous, key_a.hash, info_a, std::chrono::steady_clock::now () });
+		spill (transaction_a);
+	}
+	else
+	{
+		store.unchecked_put (transaction_a, key_a, info_a);
+	}
+}
+
+void nano::unchecked_map::spill (nano::write_transaction const & transaction_a)
+{
+	auto cutoff (std::chrono::steady_clock::now () - spill_age);
+	auto & sequence (entries.get<tag_sequence> ());
+	while (!sequence.empty () && (sequence.size () > memory_max || sequence.front ().arrival < cutoff))
+	{
+		auto const & entry (sequence.front ());
+		store.unchecked_put (transaction_a, nano::unchecked_key (entry.dependency, entry.hash), entry.info);
+		table_empty = false;
+		sequence.pop_front ();
+	}
+}
+
+std::vector<nano::unchecked_info> nano::unchecked_map::get (nano::transaction const & transaction_a, nano::block_hash const & hash_a)
+{
+	if (memory_max == 0)
+	{
+		return store.unchecked_get (transaction_a, hash_a);
+	}
+	nano::lock_guard<std::mutex> lock (mutex);
+	std::vector<nano::unchecked_info> result;
+	if (!table_empty)
+	{
+		result = store.unchecked_get (transaction_a, hash_a);
+	}
+	auto range (entries.get<tag_key> ().equal_range (boost::make_tuple (hash_a)));
+	for (auto i (range.first); i != range.second; ++i)
+	{
+		result.push_back (i->info);
+	}
+	return result;
+}
+
+bool nano::unchecked_map::exists (nano::transaction const & transaction_a, nano::unchecked_key const & key_a)
+{
+	if (memory_max == 0)
+	{
+		return store.unchecked_exists (transaction_a, key_a);
+	}
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto const & keys (entries.get<tag_key> ());
+	return keys.find (boost::make_tuple (key_a.previous, key_a.hash)) != keys.end () || (!table_empty && store.unchecked_exists (transaction_a, key_a));
+}
+
+void nano::unchecked_map::del (nano::write_transaction const & transaction_a, nano::unchecked_key const & key_a)
+{
+	if (memory_max == 0)
+	{
+		store.unchecked_del (transaction_a, key_a);
+	}
+	else
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		auto & keys (entries.get<tag_key> ());
+		auto existing (keys.find (boost::make_tuple (key_a.previous, key_a.hash)));
+		if (existing != keys.end ())
+		{
+			keys.erase (existing);
+		}
+		else if (!table_empty)
+		{
+			store.unchecked_del (transaction_a, key_a);
+		}
+	}
+}
+
+void nano::unchecked_map::clear (nano::write_transaction const & transaction_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	entries.clear ();
+	store.unchecked_clear (transaction_a);
+	table_empty = memory_max != 0;
+}
+
+size_t nano::unchecked_map::count (nano::transaction const & transaction_a)
+{
+	if (memory_max == 0)
+	{
+		return store.unchecked_count (transaction_a);
+	}
+	nano::lock_guard<std::mutex> lock (mutex);
+	return entries.size () + (table_empty ? 0 : store.unchecked_count (transaction_a));
+}
+
+void nano::unchecked_map::for_each (nano::transaction const & transaction_a, nano::unchecked_key const & start_a, std::function<void(nano::unchecked_key const &, nano::unchecked_info const &)> const & action_a, std::function<bool()> const & predicate_a)
+{
+	if (memory_max == 0)
+	{
+		for (auto i (store.unchecked_begin (transaction_a, start_a)), n (store.unchecked_end ()); i != n && predicate_a (); ++i)
+		{
+			action_a (i->first, i->second);
+		}
+	}
+	else
+	{
+		// Entries in memory are copied so the table is read and action_a called without holding the lock
+		std::vector<std::pair<nano::unchecked_key, nano::unchecked_info>> memory;
+		bool table_empty_l;
+		{
+			nano::lock_guard<std::mutex> lock (mutex);
+			auto const & keys (entries.get<tag_key> ());
+			for (auto i (keys.lower_bound (boost::make_tuple (start_a.previous, start_a.hash))), n (keys.end ()); i != n; ++i)
+			{
+				memory.emplace_back (nano::unchecked_key (i->dependency, i->hash), i->info);
+			}
+			table_empty_l = table_empty;
+		}
+		auto less = [](nano::unchecked_key const & lhs_a, nano::unchecked_key const & rhs_a) {
+			return lhs_a.previous < rhs_a.previous || (lhs_a.previous == rhs_a.previous && lhs_a.hash < rhs_a.hash);
+		};
+		// Both sequences are in key order, merge them. An entry spilled after the copy is in both and visited once
+		auto i (memory.begin ());
+		auto n (memory.end ());
+		if (!table_empty_l)
+		{
+			for (auto j (store.unchecked_begin (transaction_a, start_a)), m (store.unchecked_end ()); j != m && predicate_a (); ++j)
+			{
+				for (; i != n && less (i->first, j->first) && predicate_a (); ++i)
+				{
+					action_a (i->first, i->second);
+				}
+				if (!predicate_a ())
+				{
+					break;
+				}
+				if (i != n && i->first == j->first)
+				{
+					++i;
+				}
+				action_a (j->first, j->second);
+			}
+		}
+		for (; i != n && predicate_a (); ++i)
+		{
+			action_a (i->first, i->second);
+		}
+	}
+}
+
+void nano::unchecked_map::for_each (nano::transaction const & transaction_a, std::function<void(nano::unchecked_key const &, nano::unchecked_info const &)> const & action_a, std::function<bool()> const & predicate_a)
+{
+	for_each (transaction_a, nano::unchecked_key (0, 0), action_a, predicate_a);
+}
+
+void nano::unchecked_map::flush (nano::write_transaction const & transaction_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	for (auto const & entry : entries)
+	{
+		store.unchecked_put (transaction_a, nano::unchecked_key (entry.dependency, entry.hash), entry.info);
+		table_empty = false;
+	}
+	entries.clear ();
+}
+
+size_t nano::unchecked_map::memory_size ()
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return entries.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (unchecked_map & unchecked_map, const std::string & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", unchecked_map.memory_size (), sizeof (decltype (unchecked_map.entries)::value_type) }));
+	return composite;
+}
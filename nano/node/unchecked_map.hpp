@@ -0,0 +1,88 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/secure/common.hpp>
+
+#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nano
+{
+class block_store;
+class transaction;
+class write_transaction;
+
+/**
+ * Blocks waiting for a missing dependency, keyed like the unchecked table by the hash of the dependency and the hash of the block.
+ * Up to memory_max entries are kept in memory so blocks whose dependency arrives shortly after, the common case during bootstrap,
+ * are never written to the table only to be deleted again. Entries spill into the table once they are older than spill_age or
+ * when the memory is full, and flush writes the remaining ones there when the node stops.
+ * A key is either in memory or in the table, lookups check both so callers see the same contents the table alone would have.
+ * With memory_max zero every call goes straight to the table without locking.
+ */
+class unchecked_map final
+{
+public:
+	unchecked_map (nano::block_store &, size_t memory_max_a, std::chrono::seconds spill_age_a = std::chrono::minutes (5));
+	void put (nano::write_transaction const &, nano::unchecked_key const &, nano::unchecked_info const &);
+	std::vector<nano::unchecked_info> get (nano::transaction const &, nano::block_hash const &);
+	bool exists (nano::transaction const &, nano::unchecked_key const &);
+	void del (nano::write_transaction const &, nano::unchecked_key const &);
+	void clear (nano::write_transaction const &);
+	size_t count (nano::transaction const &);
+	/**
+	 * Calls \p action_a for the entries from \p start_a on in key order, merging those in memory with those in the table, while \p predicate_a returns true.
+	 * The entries in memory are copied first, \p action_a is called without the map locked and may call back into it.
+	 */
+	void for_each (nano::transaction const &, nano::unchecked_key const & start_a, std::function<void(nano::unchecked_key const &, nano::unchecked_info const &)> const & action_a, std::function<bool()> const & predicate_a = [] { return true; });
+	void for_each (nano::transaction const &, std::function<void(nano::unchecked_key const &, nano::unchecked_info const &)> const & action_a, std::function<bool()> const & predicate_a = [] { return true; });
+	/** Writes every entry held in memory to the table */
+	void flush (nano::write_transaction const &);
+	/** Number of entries held in memory */
+	size_t memory_size ();
+
+	size_t const memory_max;
+	std::chrono::seconds const spill_age;
+
+private:
+	class entry final
+	{
+	public:
+		nano::block_hash dependency;
+		nano::block_hash hash;
+		nano::unchecked_info info;
+		std::chrono::steady_clock::time_point arrival;
+	};
+	void spill (nano::write_transaction const &);
+	nano::block_store & store;
+	// clang-format off
+	class tag_sequence {};
+	class tag_key {};
+	using ordered_entries = boost::multi_index_container<entry,
+	boost::multi_index::indexed_by<
+		boost::multi_index::sequenced<boost::multi_index::tag<tag_sequence>>,
+		boost::multi_index::ordered_unique<boost::multi_index::tag<tag_key>,
+			boost::multi_index::composite_key<entry,
+				boost::multi_index::member<entry, nano::block_hash, &entry::dependency>,
+				boost::multi_index::member<entry, nano::block_hash, &entry::hash>>>>>;
+	// clang-format on
+	ordered_entries entries;
+	/** While true nothing has been written to the table since it was last seen empty, so lookups can skip it */
+	bool table_empty;
+	std::mutex mutex;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (unchecked_map &, const std::string &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (unchecked_map & unchecked_map, const std::string & name);
+}
@@ -15,8 +15,8 @@
 
 #include <boost/format.hpp>
 
-nano::vote_processor::vote_processor (nano::signature_checker & checker_a, nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stat & stats_a, nano::node_config & config_a, nano::node_flags & flags_a, nano::logger_mt & logger_a, nano::online_reps & online_reps_a, nano::ledger & ledger_a, nano::network_params & network_params_a) :
-checker (checker_a),
+nano::vote_processor::vote_processor (nano::signature_pipeline & signature_pipeline_a, nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stat & stats_a, nano::node_config & config_a, nano::node_flags & flags_a, nano::logger_mt & logger_a, nano::online_reps & online_reps_a, nano::ledger & ledger_a, nano::network_params & network_params_a) :
+signature_pipeline (signature_pipeline_a),
 active (active_a),
 observers (observers_a),
 stats (stats_a),
@@ -25,37 +25,35 @@ logger (logger_a),
 online_reps (online_reps_a),
 ledger (ledger_a),
 network_params (network_params_a),
-max_votes (flags_a.vote_processor_capacity),
-started (false),
-stopped (false),
-is_active (false),
-thread ([this]() {
-	nano::thread_role::set (nano::thread_role::name::vote_processing);
-	process_loop ();
-})
+max_votes (flags_a.vote_processor_capacity)
 {
-	nano::unique_lock<std::mutex> lock (mutex);
-	condition.wait (lock, [& started = started] { return started; });
+	auto shard_count (std::max<size_t> (1, config.vote_processor_threads));
+	max_votes_shard = (max_votes + shard_count - 1) / shard_count;
+	for (size_t i (0); i < shard_count; ++i)
+	{
+		shards.push_back (std::make_unique<nano::vote_processor::shard> ());
+	}
+	for (auto & shard_l : shards)
+	{
+		shard_l->thread = std::thread ([this, &shard = *shard_l]() {
+			nano::thread_role::set (nano::thread_role::name::vote_processing);
+			process_loop (shard);
+		});
+	}
 }
 
-void nano::vote_processor::process_loop ()
+void nano::vote_processor::process_loop (nano::vote_processor::shard & shard_a)
 {
 	nano::timer<std::chrono::milliseconds> elapsed;
 	bool log_this_iteration;
 
-	nano::unique_lock<std::mutex> lock (mutex);
-	started = true;
-
-	lock.unlock ();
-	condition.notify_all ();
-	lock.lock ();
-
+	nano::unique_lock<std::mutex> lock (shard_a.mutex);
 	while (!stopped)
 	{
-		if (!votes.empty ())
+		if (!shard_a.votes.empty ())
 		{
-			decltype (votes) votes_l;
-			votes_l.swap (votes);
+			decltype (shard_a.votes) votes_l;
+			votes_l.swap (shard_a.votes);
 
 			log_this_iteration = false;
 			if (config.logging.network_logging () && votes_l.size () > 50)
@@ -67,14 +65,14 @@ void nano::vote_processor::process_loop ()
 				log_this_iteration = true;
 				elapsed.restart ();
 			}
-			is_active = true;
+			shard_a.is_active = true;
 			lock.unlock ();
 			verify_votes (votes_l);
 			lock.lock ();
-			is_active = false;
+			shard_a.is_active = false;
 
 			lock.unlock ();
-			condition.notify_all ();
+			shard_a.condition.notify_all ();
 			lock.lock ();
 
 			if (log_this_iteration && elapsed.stop () > std::chrono::milliseconds (100))
@@ -84,42 +82,53 @@ void nano::vote_processor::process_loop ()
 		}
 		else
 		{
-			condition.wait (lock);
+			shard_a.condition.wait (lock);
 		}
 	}
 }
 
+nano::vote_processor::shard & nano::vote_processor::shard_for (nano::account const & representative_a)
+{
+	return *shards[representative_a.qwords[0] % shards.size ()];
+}
+
 bool nano::vote_processor::vote (std::shared_ptr<nano::vote> vote_a, std::shared_ptr<nano::transport::channel> channel_a)
 {
 	bool process (false);
-	nano::unique_lock<std::mutex> lock (mutex);
+	auto & shard_l (shard_for (vote_a->account));
+	nano::unique_lock<std::mutex> lock (shard_l.mutex);
 	if (!stopped)
 	{
+		auto size (shard_l.votes.size ());
 		// Level 0 (< 0.1%)
-		if (votes.size () < 6.0 / 9.0 * max_votes)
+		if (size < 6.0 / 9.0 * max_votes_shard)
 		{
 			process = true;
 		}
-		// Level 1 (0.1-1%)
-		else if (votes.size () < 7.0 / 9.0 * max_votes)
-		{
-			process = (representatives_1.find (vote_a->account) != representatives_1.end ());
-		}
-		// Level 2 (1-5%)
-		else if (votes.size () < 8.0 / 9.0 * max_votes)
+		else if (size < max_votes_shard)
 		{
-			process = (representatives_2.find (vote_a->account) != representatives_2.end ());
-		}
-		// Level 3 (> 5%)
-		else if (votes.size () < max_votes)
-		{
-			process = (representatives_3.find (vote_a->account) != representatives_3.end ());
+			nano::lock_guard<std::mutex> guard (mutex);
+			// Level 1 (0.1-1%)
+			if (size < 7.0 / 9.0 * max_votes_shard)
+			{
+				process = (representatives_1.find (vote_a->account) != representatives_1.end ());
+			}
+			// Level 2 (1-5%)
+			else if (size < 8.0 / 9.0 * max_votes_shard)
+			{
+				process = (representatives_2.find (vote_a->account) != representatives_2.end ());
+			}
+			// Level 3 (> 5%)
+			else
+			{
+				process = (representatives_3.find (vote_a->account) != representatives_3.end ());
+			}
 		}
 		if (process)
 		{
-			votes.emplace_back (vote_a, channel_a);
+			shard_l.votes.emplace_back (vote_a, channel_a);
 			lock.unlock ();
-			condition.notify_all ();
+			shard_l.condition.notify_all ();
 			// Lock no longer required
 		}
 		else
@@ -130,7 +139,7 @@ bool nano::vote_processor::vote (std::shared_ptr<nano::vote> vote_a, std::shared
 	return !process;
 }
 
-void nano::vote_processor::verify_votes (decltype (votes) const & votes_a)
+void nano::vote_processor::verify_votes (decltype (nano::vote_processor::shard::votes) const & votes_a)
 {
 	auto size (votes_a.size ());
 	std::vector<unsigned char const *> messages;
@@ -152,7 +161,7 @@ void nano::vote_processor::verify_votes (decltype (votes) const & votes_a)
 		signatures.push_back (vote.first->signature.bytes.data ());
 	}
 	nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
-	checker.verify (check);
+	signature_pipeline.verify (check, nano::signature_source::vote);
 	auto i (0);
 	for (auto const & vote : votes_a)
 	{
@@ -202,45 +211,62 @@ nano::vote_code nano::vote_processor::vote_blocking (std::shared_ptr<nano::vote>
 
 void nano::vote_processor::stop ()
 {
+	stopped = true;
+	for (auto & shard_l : shards)
 	{
-		nano::lock_guard<std::mutex> lock (mutex);
-		stopped = true;
+		{
+			// Prevent a race with condition.wait in process_loop
+			nano::lock_guard<std::mutex> lock (shard_l->mutex);
+		}
+		shard_l->condition.notify_all ();
 	}
-	condition.notify_all ();
-	if (thread.joinable ())
+	for (auto & shard_l : shards)
 	{
-		thread.join ();
+		if (shard_l->thread.joinable ())
+		{
+			shard_l->thread.join ();
+		}
 	}
 }
 
 void nano::vote_processor::flush ()
 {
-	nano::unique_lock<std::mutex> lock (mutex);
-	while (is_active || !votes.empty ())
+	for (auto & shard_l : shards)
 	{
-		condition.wait (lock);
+		nano::unique_lock<std::mutex> lock (shard_l->mutex);
+		while (shard_l->is_active || !shard_l->votes.empty ())
+		{
+			shard_l->condition.wait (lock);
+		}
 	}
 }
 
 void nano::vote_processor::flush_active ()
 {
-	nano::unique_lock<std::mutex> lock (mutex);
-	while (is_active)
+	for (auto & shard_l : shards)
 	{
-		condition.wait (lock);
+		nano::unique_lock<std::mutex> lock (shard_l->mutex);
+		while (shard_l->is_active)
+		{
+			shard_l->condition.wait (lock);
+		}
 	}
 }
 
 size_t nano::vote_processor::size ()
 {
-	nano::lock_guard<std::mutex> guard (mutex);
-	return votes.size ();
+	size_t result (0);
+	for (auto & shard_l : shards)
+	{
+		nano::lock_guard<std::mutex> guard (shard_l->mutex);
+		result += shard_l->votes.size ();
+	}
+	return result;
 }
 
 bool nano::vote_processor::empty ()
 {
-	nano::lock_guard<std::mutex> guard (mutex);
-	return votes.empty ();
+	return size () == 0;
 }
 
 bool nano::vote_processor::half_full ()
@@ -280,21 +306,20 @@ void nano::vote_processor::calculate_weights ()
 
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (vote_processor & vote_processor, const std::string & name)
 {
-	size_t votes_count;
+	auto votes_count (vote_processor.size ());
 	size_t representatives_1_count;
 	size_t representatives_2_count;
 	size_t representatives_3_count;
 
 	{
 		nano::lock_guard<std::mutex> guard (vote_processor.mutex);
-		votes_count = vote_processor.votes.size ();
 		representatives_1_count = vote_processor.representatives_1.size ();
 		representatives_2_count = vote_processor.representatives_2.size ();
 		representatives_3_count = vote_processor.representatives_3.size ();
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", votes_count, sizeof (decltype (vote_processor.votes)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", votes_count, sizeof (decltype (nano::vote_processor::shard::votes)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_1", representatives_1_count, sizeof (decltype (vote_processor.representatives_1)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_2", representatives_2_count, sizeof (decltype (vote_processor.representatives_2)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_3", representatives_3_count, sizeof (decltype (vote_processor.representatives_3)::value_type) }));
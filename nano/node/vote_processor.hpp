@@ -4,15 +4,17 @@
 #include <nano/lib/utility.hpp>
 #include <nano/secure/common.hpp>
 
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace nano
 {
-class signature_checker;
+class signature_pipeline;
 class active_transactions;
 class block_store;
 class node_observers;
@@ -30,13 +32,17 @@ namespace transport
 	class channel;
 }
 
+/**
+ * Verifies and applies incoming votes on node_config::vote_processor_threads threads.
+ * Votes are sharded by representative so votes from one representative are still processed in arrival order,
+ * each shard has its own queue, thread and share of the capacity.
+ */
 class vote_processor final
 {
 public:
-	explicit vote_processor (nano::signature_checker & checker_a, nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stat & stats_a, nano::node_config & config_a, nano::node_flags & flags_a, nano::logger_mt & logger_a, nano::online_reps & online_reps_a, nano::ledger & ledger_a, nano::network_params & network_params_a);
+	explicit vote_processor (nano::signature_pipeline & signature_pipeline_a, nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stat & stats_a, nano::node_config & config_a, nano::node_flags & flags_a, nano::logger_mt & logger_a, nano::online_reps & online_reps_a, nano::ledger & ledger_a, nano::network_params & network_params_a);
 	/** Returns false if the vote was processed */
 	bool vote (std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>);
-	/** Note: node.active.mutex lock is required */
 	nano::vote_code vote_blocking (std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>, bool = false);
 	void verify_votes (std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> const &);
 	void flush ();
@@ -49,9 +55,19 @@ public:
 	void stop ();
 
 private:
-	void process_loop ();
+	class shard final
+	{
+	public:
+		std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> votes;
+		nano::condition_variable condition;
+		std::mutex mutex;
+		bool is_active{ false };
+		std::thread thread;
+	};
+	void process_loop (nano::vote_processor::shard &);
+	nano::vote_processor::shard & shard_for (nano::account const &);
 
-	nano::signature_checker & checker;
+	nano::signature_pipeline & signature_pipeline;
 	nano::active_transactions & active;
 	nano::node_observers & observers;
 	nano::stat & stats;
@@ -62,18 +78,17 @@ private:
 	nano::network_params & network_params;
 
 	size_t max_votes;
+	/** Capacity of each shard, random early detection applies per shard */
+	size_t max_votes_shard;
 
-	std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> votes;
+	std::vector<std::unique_ptr<nano::vote_processor::shard>> shards;
 	/** Representatives levels for random early detection */
 	std::unordered_set<nano::account> representatives_1;
 	std::unordered_set<nano::account> representatives_2;
 	std::unordered_set<nano::account> representatives_3;
-	nano::condition_variable condition;
+	/** Protects the representatives levels, only taken by vote () once a shard is filling up */
 	std::mutex mutex;
-	bool started;
-	bool stopped;
-	bool is_active;
-	std::thread thread;
+	std::atomic<bool> stopped{ false };
 
 	friend std::unique_ptr<container_info_component> collect_container_info (vote_processor & vote_processor, const std::string & name);
 	friend class vote_processor_weights_Test;
@@ -10,6 +10,8 @@
 #include <nano/secure/ledger.hpp>
 
 #include <chrono>
+#include <set>
+#include <unordered_map>
 
 bool nano::local_vote_history::consistency_check (nano::root const & root_a) const
 {
@@ -180,14 +182,25 @@ size_t nano::vote_generator::generate (std::vector<std::shared_ptr<nano::block>>
 		nano::transform_if (blocks_a.begin (), blocks_a.end (), std::back_inserter (candidates), dependents_confirmed, as_candidate);
 	}
 	auto const result = candidates.size ();
-	nano::lock_guard<std::mutex> guard (mutex);
+	nano::unique_lock<std::mutex> lock (mutex);
+	if (requests.empty ())
+	{
+		requests_start = std::chrono::steady_clock::now ();
+	}
+	requests_hashes += result;
 	requests.emplace_back (std::move (candidates), channel_a);
 	while (requests.size () > max_requests)
 	{
 		// On a large queue of requests, erase the oldest one
+		requests_hashes -= requests.front ().first.size ();
 		requests.pop_front ();
 		stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_replies_discarded);
 	}
+	if (requests_hashes >= nano::network::confirm_ack_hashes_max)
+	{
+		lock.unlock ();
+		condition.notify_all ();
+	}
 	return result;
 }
 
@@ -232,47 +245,87 @@ void nano::vote_generator::broadcast (nano::unique_lock<std::mutex> & lock_a)
 	stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_broadcasts);
 }
 
-void nano::vote_generator::reply (nano::unique_lock<std::mutex> & lock_a, request_t && request_a)
+void nano::vote_generator::reply (nano::unique_lock<std::mutex> & lock_a, std::deque<request_t> && requests_a)
 {
 	lock_a.unlock ();
-	std::unordered_set<std::shared_ptr<nano::vote>> cached_sent;
-	auto transaction (ledger.store.tx_begin_read ());
-	auto i (request_a.first.cbegin ());
-	auto n (request_a.first.cend ());
-	while (i != n && !stopped)
+	// Requests from the same channel are merged
+	std::unordered_map<std::shared_ptr<nano::transport::channel>, std::vector<candidate_t>> channels;
+	for (auto & request : requests_a)
+	{
+		auto & candidates_l (channels[request.second]);
+		candidates_l.insert (candidates_l.end (), request.first.begin (), request.first.end ());
+	}
+	stats.add (nano::stat::type::vote_generator, nano::stat::detail::generator_coalesced_requests, stat::dir::in, requests_a.size () - 1);
+	// Hashes without a cached vote, each appearing once however many channels requested it
+	std::vector<nano::block_hash> hashes;
+	std::vector<nano::root> roots;
+	std::unordered_map<nano::block_hash, size_t> packed;
+	std::unordered_map<std::shared_ptr<nano::transport::channel>, std::vector<size_t>> channel_packed;
+	for (auto & [channel, candidates_l] : channels)
 	{
-		std::vector<nano::block_hash> hashes;
-		std::vector<nano::root> roots;
-		hashes.reserve (nano::network::confirm_ack_hashes_max);
-		roots.reserve (nano::network::confirm_ack_hashes_max);
-		for (; i != n && hashes.size () < nano::network::confirm_ack_hashes_max; ++i)
+		auto channel_l (channel);
+		std::unordered_set<std::shared_ptr<nano::vote>> cached_sent;
+		auto & indices (channel_packed[channel]);
+		for (auto const & [root, hash] : candidates_l)
 		{
-			auto cached_votes = history.votes (i->first, i->second);
+			auto cached_votes = history.votes (root, hash);
 			for (auto const & cached_vote : cached_votes)
 			{
 				if (cached_sent.insert (cached_vote).second)
 				{
 					stats.add (nano::stat::type::requests, nano::stat::detail::requests_cached_late_hashes, stat::dir::in, cached_vote->blocks.size ());
 					stats.inc (nano::stat::type::requests, nano::stat::detail::requests_cached_late_votes, stat::dir::in);
-					reply_action (cached_vote, request_a.second);
+					reply_action (cached_vote, channel_l);
 				}
 			}
 			if (cached_votes.empty ())
 			{
-				roots.push_back (i->first);
-				hashes.push_back (i->second);
+				auto inserted (packed.emplace (hash, hashes.size ()));
+				if (inserted.second)
+				{
+					roots.push_back (root);
+					hashes.push_back (hash);
+				}
+				indices.push_back (inserted.first->second);
 			}
 		}
-		if (!hashes.empty ())
+	}
+	// Votes are generated for full packs of hashes, votes[i] covering hashes [i * confirm_ack_hashes_max, (i + 1) * confirm_ack_hashes_max)
+	std::vector<std::vector<std::shared_ptr<nano::vote>>> votes;
+	for (size_t i (0); i < hashes.size () && !stopped; i += nano::network::confirm_ack_hashes_max)
+	{
+		auto end (std::min (hashes.size (), i + nano::network::confirm_ack_hashes_max));
+		std::vector<nano::block_hash> hashes_l (hashes.begin () + i, hashes.begin () + end);
+		std::vector<nano::root> roots_l (roots.begin () + i, roots.begin () + end);
+		votes.emplace_back ();
+		vote (hashes_l, roots_l, [&votes](std::shared_ptr<nano::vote> const & vote_a) {
+			votes.back ().push_back (vote_a);
+		});
+		stats.add (nano::stat::type::vote_generator, nano::stat::detail::generator_packed_hashes, stat::dir::in, hashes_l.size ());
+		stats.add (nano::stat::type::vote_generator, nano::stat::detail::generator_packed_votes, stat::dir::in, votes.back ().size ());
+	}
+	for (auto & [channel, indices] : channel_packed)
+	{
+		std::set<size_t> packs;
+		for (auto index : indices)
+		{
+			packs.insert (index / nano::network::confirm_ack_hashes_max);
+		}
+		stats.add (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes, stat::dir::in, indices.size ());
+		auto channel_l (channel);
+		for (auto pack : packs)
 		{
-			stats.add (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes, stat::dir::in, hashes.size ());
-			vote (hashes, roots, [this, &channel = request_a.second](std::shared_ptr<nano::vote> const & vote_a) {
-				this->reply_action (vote_a, channel);
-				this->stats.inc (nano::stat::type::requests, nano::stat::detail::requests_generated_votes, stat::dir::in);
-			});
+			if (pack < votes.size ())
+			{
+				for (auto const & vote_l : votes[pack])
+				{
+					reply_action (vote_l, channel_l);
+					stats.inc (nano::stat::type::requests, nano::stat::detail::requests_generated_votes, stat::dir::in);
+				}
+			}
 		}
 	}
-	stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_replies);
+	stats.add (nano::stat::type::vote_generator, nano::stat::detail::generator_replies, stat::dir::in, requests_a.size ());
 	lock_a.lock ();
 }
 
@@ -319,9 +372,12 @@ void nano::vote_generator::run ()
 		}
 		else if (!requests.empty ())
 		{
-			auto request (requests.front ());
-			requests.pop_front ();
-			reply (lock, std::move (request));
+			// Hold replies back until they fill a vote or the coalescing budget of the oldest request runs out
+			condition.wait_until (lock, requests_start + config.vote_generator_coalesce_delay, [this]() { return this->stopped || this->requests_hashes >= nano::network::confirm_ack_hashes_max || this->candidates.size () >= nano::network::confirm_ack_hashes_max; });
+			decltype (requests) requests_l;
+			requests_l.swap (requests);
+			requests_hashes = 0;
+			reply (lock, std::move (requests_l));
 		}
 		else
 		{
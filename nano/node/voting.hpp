@@ -97,7 +97,8 @@ public:
 private:
 	void run ();
 	void broadcast (nano::unique_lock<std::mutex> &);
-	void reply (nano::unique_lock<std::mutex> &, request_t &&);
+	/** Replies to all \p requests_a at once, hashes requested by several peers are packed into shared votes so each is signed only once */
+	void reply (nano::unique_lock<std::mutex> &, std::deque<request_t> &&);
 	void vote (std::vector<nano::block_hash> const &, std::vector<nano::root> const &, std::function<void(std::shared_ptr<nano::vote> const &)> const &);
 	void broadcast_action (std::shared_ptr<nano::vote> const &) const;
 	std::function<void(std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> &)> reply_action; // must be set only during initialization by using set_reply_action
@@ -112,6 +113,10 @@ private:
 	nano::condition_variable condition;
 	static size_t constexpr max_requests{ 2048 };
 	std::deque<request_t> requests;
+	/** Number of candidates in requests */
+	size_t requests_hashes{ 0 };
+	/** Arrival of the oldest request, replies are held back at most vote_generator_coalesce_delay from it */
+	std::chrono::steady_clock::time_point requests_start;
 	std::deque<candidate_t> candidates;
 	nano::network_params network_params;
 	std::atomic<bool> stopped{ false };
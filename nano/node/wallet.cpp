@@ -1056,7 +1056,8 @@ bool nano::wallet::action_complete (std::shared_ptr<nano::block> const & block_a
 		}
 		if (!error)
 		{
-			error = wallets.node.process_local (block_a, true).code != nano::process_result::progress;
+			auto result (wallets.node.process_local_queued (block_a, true));
+			error = !result || result->code != nano::process_result::progress;
 			debug_assert (error || block_a->sideband ().details == details_a);
 		}
 		if (!error && generate_work_a)
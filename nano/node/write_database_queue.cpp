@@ -50,21 +50,63 @@ void nano::write_guard::release ()
 	owns = false;
 }
 
-nano::write_database_queue::write_database_queue (bool use_noops_a) :
-guard_finish_callback ([use_noops_a, &queue = queue, &mutex = mutex, &cv = cv]() {
+nano::write_database_queue::write_database_queue (bool use_noops_a, std::function<void()> sync_a, std::chrono::milliseconds group_commit_max_latency_a) :
+guard_finish_callback ([use_noops_a, this]() {
 	if (!use_noops_a)
 	{
-		{
-			nano::lock_guard<std::mutex> guard (mutex);
-			queue.pop_front ();
-		}
-		cv.notify_all ();
+		finish ();
 	}
 }),
-use_noops (use_noops_a)
+use_noops (use_noops_a),
+sync (sync_a),
+group_commit_max_latency (group_commit_max_latency_a)
 {
 }
 
+void nano::write_database_queue::finish ()
+{
+	nano::unique_lock<std::mutex> lock (mutex);
+	queue.pop_front ();
+	auto commit (++commits);
+	lock.unlock ();
+	cv.notify_all ();
+	if (sync)
+	{
+		// The writer's transaction is committed, let a flush in progress see it and wait for it to be durable
+		sync_cv.notify_all ();
+		lock.lock ();
+		wait_synced (commit, lock);
+	}
+}
+
+void nano::write_database_queue::wait_synced (uint64_t commit_a, nano::unique_lock<std::mutex> & lock_a)
+{
+	while (synced < commit_a)
+	{
+		if (!syncing)
+		{
+			syncing = true;
+			// Writers still queued can join this flush if they commit in time
+			auto cutoff (std::chrono::steady_clock::now () + group_commit_max_latency);
+			while (!queue.empty () && std::chrono::steady_clock::now () < cutoff)
+			{
+				sync_cv.wait_until (lock_a, cutoff);
+			}
+			auto target (commits);
+			lock_a.unlock ();
+			sync ();
+			lock_a.lock ();
+			synced = target;
+			syncing = false;
+			sync_cv.notify_all ();
+		}
+		else
+		{
+			sync_cv.wait (lock_a);
+		}
+	}
+}
+
 nano::write_guard nano::write_database_queue::wait (nano::writer writer)
 {
 	if (use_noops)
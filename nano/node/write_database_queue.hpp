@@ -2,6 +2,7 @@
 
 #include <nano/lib/locks.hpp>
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
@@ -35,10 +36,15 @@ private:
 	bool owns{ true };
 };
 
+/**
+ * Serializes the writers of the ledger database.
+ * With a \p sync_a function the queue group commits: writers commit without a durable flush and, once they release
+ * their guard, wait for one flush shared with the writers that committed up to \p group_commit_max_latency_a later.
+ */
 class write_database_queue final
 {
 public:
-	write_database_queue (bool use_noops_a);
+	write_database_queue (bool use_noops_a, std::function<void()> sync_a = nullptr, std::chrono::milliseconds group_commit_max_latency_a = std::chrono::milliseconds (0));
 	/** Blocks until we are at the head of the queue */
 	write_guard wait (nano::writer writer);
 
@@ -52,10 +58,20 @@ public:
 	write_guard pop ();
 
 private:
+	void finish ();
+	/** Blocks until the commits up to \p commit_a are flushed, one of the waiting writers does the flush */
+	void wait_synced (uint64_t commit_a, nano::unique_lock<std::mutex> &);
 	std::deque<nano::writer> queue;
 	std::mutex mutex;
 	nano::condition_variable cv;
 	std::function<void()> guard_finish_callback;
 	bool use_noops;
+	std::function<void()> sync;
+	std::chrono::milliseconds group_commit_max_latency;
+	/** Number of released write guards, and how many of those are known to be flushed */
+	uint64_t commits{ 0 };
+	uint64_t synced{ 0 };
+	bool syncing{ false };
+	nano::condition_variable sync_cv;
 };
 }
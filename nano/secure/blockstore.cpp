@@ -11,11 +11,14 @@ result (0)
 void nano::representative_visitor::compute (nano::block_hash const & hash_a)
 {
 	current = hash_a;
-	while (result.is_zero ())
+	auto block (store.block_get (transaction, current));
+	while (result.is_zero () && block != nullptr)
 	{
-		auto block (store.block_get (transaction, current));
-		debug_assert (block != nullptr);
 		block->visit (*this);
+		if (result.is_zero ())
+		{
+			block = store.block_get (transaction, current);
+		}
 	}
 }
 
@@ -44,7 +47,8 @@ void nano::representative_visitor::state_block (nano::state_block const & block_
 	result = block_a.hash ();
 }
 
-nano::read_transaction::read_transaction (std::unique_ptr<nano::read_transaction_impl> read_transaction_impl) :
+nano::read_transaction::read_transaction (std::unique_ptr<nano::read_transaction_impl> read_transaction_impl, nano::store_cache_order * cache_order, uint64_t cache_sequence) :
+transaction (cache_order, cache_sequence),
 impl (std::move (read_transaction_impl))
 {
 }
@@ -61,6 +65,10 @@ void nano::read_transaction::reset () const
 
 void nano::read_transaction::renew () const
 {
+	if (cache_order != nullptr)
+	{
+		cache_sequence = cache_order->sequence ();
+	}
 	impl->renew ();
 }
 
@@ -70,7 +78,8 @@ void nano::read_transaction::refresh () const
 	renew ();
 }
 
-nano::write_transaction::write_transaction (std::unique_ptr<nano::write_transaction_impl> write_transaction_impl) :
+nano::write_transaction::write_transaction (std::unique_ptr<nano::write_transaction_impl> write_transaction_impl, nano::store_cache_order * cache_order, uint64_t cache_sequence) :
+transaction (cache_order, cache_sequence),
 impl (std::move (write_transaction_impl))
 {
 	/*
@@ -79,6 +88,17 @@ impl (std::move (write_transaction_impl))
 	debug_assert (nano::thread_role::get () != nano::thread_role::name::io);
 }
 
+nano::write_transaction::~write_transaction ()
+{
+	if (cache_order != nullptr)
+	{
+		// Destroying the implementation commits it
+		cache_order->commit (*this, [this]() {
+			impl.reset ();
+		});
+	}
+}
+
 void * nano::write_transaction::get_handle () const
 {
 	return impl->get_handle ();
@@ -86,11 +106,24 @@ void * nano::write_transaction::get_handle () const
 
 void nano::write_transaction::commit () const
 {
-	impl->commit ();
+	if (cache_order != nullptr)
+	{
+		cache_order->commit (*this, [this]() {
+			impl->commit ();
+		});
+	}
+	else
+	{
+		impl->commit ();
+	}
 }
 
 void nano::write_transaction::renew ()
 {
+	if (cache_order != nullptr)
+	{
+		cache_sequence = cache_order->sequence ();
+	}
 	impl->renew ();
 }
 
@@ -98,3 +131,12 @@ bool nano::write_transaction::contains (nano::tables table_a) const
 {
 	return impl->contains (table_a);
 }
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (block_store & block_store, const std::string & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (collect_container_info (block_store.get_block_cache (), "block_cache"));
+	composite->add_component (collect_container_info (block_store.get_account_info_cache (), "account_info_cache"));
+	composite->add_component (collect_container_info (block_store.get_confirmation_height_cache (), "confirmation_height_cache"));
+	return composite;
+}
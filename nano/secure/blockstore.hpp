@@ -11,9 +11,13 @@
 #include <nano/secure/versioning.hpp>
 
 #include <boost/endian/conversion.hpp>
+#include <boost/optional.hpp>
 #include <boost/polymorphic_cast.hpp>
 
+#include <array>
+#include <functional>
 #include <stack>
+#include <unordered_map>
 
 namespace nano
 {
@@ -415,7 +419,7 @@ class transaction;
 class block_store;
 
 /**
- * Determine the representative for this block
+ * Determine the representative for this block, the result stays zero if the chain has been pruned before one is found
  */
 class representative_visitor final : public nano::block_visitor
 {
@@ -542,11 +546,60 @@ public:
 	virtual bool contains (nano::tables table_a) const = 0;
 };
 
+class transaction;
+
+/**
+ * Orders the store caches with commits so a transaction only uses cached entries its snapshot agrees with.
+ * Transactions sample the sequence before taking their snapshot. A write transaction buffers its cache updates,
+ * when it commits the sequence is odd while the updates are published, stamped with the next even sequence, and the
+ * transaction is committed. Entries stamped later than a transaction's sample may be newer than its snapshot.
+ */
+class store_cache_order final
+{
+public:
+	uint64_t sequence () const
+	{
+		return sequence_m.load ();
+	}
+
+	/** Publishes the buffered cache updates of the transaction, then runs the commit */
+	void commit (nano::transaction const & transaction_a, std::function<void()> const & commit_a)
+	{
+		nano::lock_guard<std::mutex> guard (mutex);
+		auto stamp (sequence_m.fetch_add (1) + 2);
+		for (auto const & publish : publishers)
+		{
+			publish (transaction_a, stamp);
+		}
+		commit_a ();
+		sequence_m.store (stamp);
+	}
+
+	void add (std::function<void(nano::transaction const &, uint64_t)> const & publish_a)
+	{
+		publishers.push_back (publish_a);
+	}
+
+private:
+	std::mutex mutex;
+	std::atomic<uint64_t> sequence_m{ 0 };
+	std::vector<std::function<void(nano::transaction const &, uint64_t)>> publishers;
+};
+
 class transaction
 {
 public:
+	transaction (nano::store_cache_order * cache_order_a, uint64_t cache_sequence_a) :
+	cache_order (cache_order_a),
+	cache_sequence (cache_sequence_a)
+	{
+	}
 	virtual ~transaction () = default;
 	virtual void * get_handle () const = 0;
+	/** Null for transactions which don't belong to a block store */
+	nano::store_cache_order * const cache_order;
+	/** Cache sequence sampled before the snapshot was taken */
+	mutable uint64_t cache_sequence;
 };
 
 /**
@@ -556,7 +609,7 @@ public:
 class read_transaction final : public transaction
 {
 public:
-	explicit read_transaction (std::unique_ptr<nano::read_transaction_impl> read_transaction_impl);
+	explicit read_transaction (std::unique_ptr<nano::read_transaction_impl> read_transaction_impl, nano::store_cache_order * cache_order = nullptr, uint64_t cache_sequence = 0);
 	void * get_handle () const override;
 	void reset () const;
 	void renew () const;
@@ -573,7 +626,8 @@ private:
 class write_transaction final : public transaction
 {
 public:
-	explicit write_transaction (std::unique_ptr<nano::write_transaction_impl> write_transaction_impl);
+	explicit write_transaction (std::unique_ptr<nano::write_transaction_impl> write_transaction_impl, nano::store_cache_order * cache_order = nullptr, uint64_t cache_sequence = 0);
+	~write_transaction ();
 	void * get_handle () const override;
 	void commit () const;
 	void renew ();
@@ -583,6 +637,303 @@ private:
 	std::unique_ptr<nano::write_transaction_impl> impl;
 };
 
+/**
+ * Bounded cache of decoded table entries, sharded by key and evicted with the CLOCK algorithm.
+ * Updates by a write transaction are only visible to it until it commits, see store_cache_order.
+ * Entries read from a table are added while no commit has happened since the reading transaction's snapshot.
+ */
+template <typename Key, typename Value>
+class store_cache final
+{
+public:
+	explicit store_cache (nano::store_cache_order & order_a)
+	{
+		order_a.add ([this](nano::transaction const & transaction_a, uint64_t stamp_a) {
+			publish (transaction_a, stamp_a);
+		});
+	}
+
+	/** The transaction's own update of the key, otherwise an entry stamped no later than its snapshot */
+	boost::optional<Value> get (nano::transaction const & transaction_a, Key const & key_a)
+	{
+		boost::optional<Value> result;
+		if (max > 0 && transaction_a.cache_order != nullptr)
+		{
+			auto & shard_l (shard_for (key_a));
+			nano::lock_guard<std::mutex> guard (shard_l.mutex);
+			auto own (pending_find (shard_l, transaction_a, key_a));
+			if (own != nullptr)
+			{
+				// A key erased by the transaction is read from the table
+				result = *own;
+			}
+			else
+			{
+				auto existing (shard_l.index.find (key_a));
+				if (existing != shard_l.index.end () && shard_l.entries[existing->second].stamp <= transaction_a.cache_sequence)
+				{
+					auto & entry_l (shard_l.entries[existing->second]);
+					entry_l.referenced = true;
+					result = entry_l.value;
+				}
+			}
+			if (result)
+			{
+				++shard_l.hits;
+			}
+			else
+			{
+				++shard_l.misses;
+			}
+		}
+		return result;
+	}
+
+	/** Adds an entry read by the transaction, unless a commit happened since its snapshot or the transaction updated the key itself */
+	void fill (nano::transaction const & transaction_a, Key const & key_a, Value const & value_a)
+	{
+		if (max > 0 && transaction_a.cache_order != nullptr)
+		{
+			auto & shard_l (shard_for (key_a));
+			nano::lock_guard<std::mutex> guard (shard_l.mutex);
+			auto sequence_l (transaction_a.cache_sequence);
+			if (sequence_l % 2 == 0 && transaction_a.cache_order->sequence () == sequence_l && pending_find (shard_l, transaction_a, key_a) == nullptr)
+			{
+				insert (shard_l, key_a, value_a, sequence_l);
+			}
+		}
+	}
+
+	/** Buffers an update which is published when the transaction commits */
+	void put (nano::write_transaction const & transaction_a, Key const & key_a, Value const & value_a)
+	{
+		update (transaction_a, key_a, value_a);
+	}
+
+	/** Buffers an erasure which is published when the transaction commits */
+	void erase (nano::write_transaction const & transaction_a, Key const & key_a)
+	{
+		update (transaction_a, key_a, boost::none);
+	}
+
+	bool exists (Key const & key_a)
+	{
+		auto & shard_l (shard_for (key_a));
+		nano::lock_guard<std::mutex> guard (shard_l.mutex);
+		return shard_l.index.find (key_a) != shard_l.index.end ();
+	}
+
+	/** Sets the maximum number of cached entries and drops every entry, a maximum of 0 disables the cache */
+	void resize (size_t max_a)
+	{
+		max = max_a;
+		for (auto & shard_l : shards)
+		{
+			nano::lock_guard<std::mutex> guard (shard_l.mutex);
+			shard_l.max = (max_a + shard_count - 1) / shard_count;
+			shard_l.index.clear ();
+			shard_l.entries.clear ();
+			shard_l.hand = 0;
+		}
+	}
+
+	void clear ()
+	{
+		resize (max);
+	}
+
+	size_t size ()
+	{
+		size_t result (0);
+		for (auto & shard_l : shards)
+		{
+			nano::lock_guard<std::mutex> guard (shard_l.mutex);
+			result += shard_l.entries.size ();
+		}
+		return result;
+	}
+
+	/** Lookup hits and misses since the cache was created */
+	void counts (uint64_t & hits_a, uint64_t & misses_a)
+	{
+		hits_a = 0;
+		misses_a = 0;
+		for (auto & shard_l : shards)
+		{
+			nano::lock_guard<std::mutex> guard (shard_l.mutex);
+			hits_a += shard_l.hits;
+			misses_a += shard_l.misses;
+		}
+	}
+
+	/** Lookup hits and misses since the previous call */
+	void take_counts (uint64_t & hits_a, uint64_t & misses_a)
+	{
+		uint64_t hits_l;
+		uint64_t misses_l;
+		counts (hits_l, misses_l);
+		hits_a = hits_l - hits_taken.exchange (hits_l);
+		misses_a = misses_l - misses_taken.exchange (misses_l);
+	}
+
+	std::atomic<size_t> max{ 0 };
+
+private:
+	class entry final
+	{
+	public:
+		Key key;
+		Value value;
+		uint64_t stamp;
+		bool referenced;
+	};
+	class shard final
+	{
+	public:
+		std::mutex mutex;
+		std::unordered_map<Key, size_t> index;
+		std::vector<entry> entries;
+		/** Updates buffered by each uncommitted write transaction, none for an erasure */
+		std::unordered_map<nano::transaction const *, std::unordered_map<Key, boost::optional<Value>>> pending;
+		size_t hand{ 0 };
+		size_t max{ 0 };
+		uint64_t hits{ 0 };
+		uint64_t misses{ 0 };
+	};
+
+	void update (nano::write_transaction const & transaction_a, Key const & key_a, boost::optional<Value> const & value_a)
+	{
+		if (max > 0 && transaction_a.cache_order != nullptr)
+		{
+			auto & shard_l (shard_for (key_a));
+			nano::lock_guard<std::mutex> guard (shard_l.mutex);
+			shard_l.pending[&transaction_a][key_a] = value_a;
+		}
+	}
+
+	void publish (nano::transaction const & transaction_a, uint64_t stamp_a)
+	{
+		for (auto & shard_l : shards)
+		{
+			nano::lock_guard<std::mutex> guard (shard_l.mutex);
+			auto pending_l (shard_l.pending.find (&transaction_a));
+			if (pending_l != shard_l.pending.end ())
+			{
+				for (auto const & update_l : pending_l->second)
+				{
+					if (update_l.second)
+					{
+						insert (shard_l, update_l.first, *update_l.second, stamp_a);
+					}
+					else
+					{
+						remove (shard_l, update_l.first);
+					}
+				}
+				shard_l.pending.erase (pending_l);
+			}
+		}
+	}
+
+	boost::optional<Value> const * pending_find (shard & shard_a, nano::transaction const & transaction_a, Key const & key_a) const
+	{
+		boost::optional<Value> const * result (nullptr);
+		auto pending_l (shard_a.pending.find (&transaction_a));
+		if (pending_l != shard_a.pending.end ())
+		{
+			auto existing (pending_l->second.find (key_a));
+			if (existing != pending_l->second.end ())
+			{
+				result = &existing->second;
+			}
+		}
+		return result;
+	}
+
+	void insert (shard & shard_a, Key const & key_a, Value const & value_a, uint64_t stamp_a)
+	{
+		auto existing (shard_a.index.find (key_a));
+		if (existing != shard_a.index.end ())
+		{
+			auto & entry_l (shard_a.entries[existing->second]);
+			entry_l.value = value_a;
+			entry_l.stamp = stamp_a;
+			entry_l.referenced = true;
+		}
+		else if (shard_a.entries.size () < shard_a.max)
+		{
+			shard_a.index.emplace (key_a, shard_a.entries.size ());
+			shard_a.entries.push_back ({ key_a, value_a, stamp_a, false });
+		}
+		else if (shard_a.max > 0)
+		{
+			// Sweep the hand past recently used entries, clearing their reference bit, and replace the first unreferenced one
+			while (shard_a.entries[shard_a.hand].referenced)
+			{
+				shard_a.entries[shard_a.hand].referenced = false;
+				shard_a.hand = (shard_a.hand + 1) % shard_a.entries.size ();
+			}
+			auto & victim (shard_a.entries[shard_a.hand]);
+			shard_a.index.erase (victim.key);
+			shard_a.index.emplace (key_a, shard_a.hand);
+			victim = { key_a, value_a, stamp_a, false };
+			shard_a.hand = (shard_a.hand + 1) % shard_a.entries.size ();
+		}
+	}
+
+	void remove (shard & shard_a, Key const & key_a)
+	{
+		auto existing (shard_a.index.find (key_a));
+		if (existing != shard_a.index.end ())
+		{
+			// Fill the hole with the last entry to keep the entries contiguous
+			auto position (existing->second);
+			shard_a.index.erase (existing);
+			if (position != shard_a.entries.size () - 1)
+			{
+				shard_a.entries[position] = std::move (shard_a.entries.back ());
+				shard_a.index[shard_a.entries[position].key] = position;
+			}
+			shard_a.entries.pop_back ();
+			if (shard_a.hand >= shard_a.entries.size ())
+			{
+				shard_a.hand = 0;
+			}
+		}
+	}
+
+	shard & shard_for (Key const & key_a)
+	{
+		return shards[key_a.qwords[0] % shard_count];
+	}
+	static size_t constexpr shard_count{ 16 };
+	std::array<shard, shard_count> shards;
+	std::atomic<uint64_t> hits_taken{ 0 };
+	std::atomic<uint64_t> misses_taken{ 0 };
+};
+
+template <typename Key, typename Value>
+size_t constexpr store_cache<Key, Value>::shard_count;
+
+template <typename Key, typename Value>
+std::unique_ptr<container_info_component> collect_container_info (store_cache<Key, Value> & store_cache, const std::string & name)
+{
+	uint64_t hits;
+	uint64_t misses;
+	store_cache.counts (hits, misses);
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", store_cache.size (), sizeof (Key) + sizeof (Value) }));
+	// These aren't containers, they expose the lookup counts
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "hits", hits, 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "misses", misses, 0 }));
+	return composite;
+}
+
+/** Deserialized blocks with their sideband, returned blocks are shared and must not be modified */
+using block_cache = store_cache<nano::block_hash, std::shared_ptr<nano::block>>;
+using account_info_cache = store_cache<nano::account, nano::account_info>;
+using confirmation_height_cache = store_cache<nano::account, nano::confirmation_height_info>;
+
 class ledger_cache;
 
 /**
@@ -598,6 +949,8 @@ public:
 	virtual void block_successor_clear (nano::write_transaction const &, nano::block_hash const &) = 0;
 	virtual std::shared_ptr<nano::block> block_get (nano::transaction const &, nano::block_hash const &) const = 0;
 	virtual std::shared_ptr<nano::block> block_get_no_sideband (nano::transaction const &, nano::block_hash const &) const = 0;
+	/** Looks up multiple blocks at once, the result has one entry per hash in the same order, nullptr if the block does not exist */
+	virtual std::vector<std::shared_ptr<nano::block>> block_get_batch (nano::transaction const &, std::vector<nano::block_hash> const &) const = 0;
 	virtual std::shared_ptr<nano::block> block_random (nano::transaction const &) = 0;
 	virtual void block_del (nano::write_transaction const &, nano::block_hash const &) = 0;
 	virtual bool block_exists (nano::transaction const &, nano::block_hash const &) = 0;
@@ -612,6 +965,8 @@ public:
 
 	virtual void account_put (nano::write_transaction const &, nano::account const &, nano::account_info const &) = 0;
 	virtual bool account_get (nano::transaction const &, nano::account const &, nano::account_info &) = 0;
+	/** Looks up multiple accounts at once, the result has one entry per account in the same order */
+	virtual std::vector<boost::optional<nano::account_info>> account_get_batch (nano::transaction const &, std::vector<nano::account> const &) = 0;
 	virtual void account_del (nano::write_transaction const &, nano::account const &) = 0;
 	virtual bool account_exists (nano::transaction const &, nano::account const &) = 0;
 	virtual size_t account_count (nano::transaction const &) = 0;
@@ -624,6 +979,8 @@ public:
 	virtual void pending_put (nano::write_transaction const &, nano::pending_key const &, nano::pending_info const &) = 0;
 	virtual void pending_del (nano::write_transaction const &, nano::pending_key const &) = 0;
 	virtual bool pending_get (nano::transaction const &, nano::pending_key const &, nano::pending_info &) = 0;
+	/** Looks up multiple pending entries at once, the result has one entry per key in the same order */
+	virtual std::vector<boost::optional<nano::pending_info>> pending_get_batch (nano::transaction const &, std::vector<nano::pending_key> const &) = 0;
 	virtual bool pending_exists (nano::transaction const &, nano::pending_key const &) = 0;
 	virtual bool pending_any (nano::transaction const &, nano::account const &) = 0;
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> pending_begin (nano::transaction const &, nano::pending_key const &) = 0;
@@ -667,6 +1024,9 @@ public:
 
 	virtual void version_put (nano::write_transaction const &, int) = 0;
 	virtual int version_get (nano::transaction const &) const = 0;
+	/** Identifies the rep weights snapshot written for this ledger, zero if there is none */
+	virtual nano::uint256_union rep_weights_marker_get (nano::transaction const &) const = 0;
+	virtual void rep_weights_marker_put (nano::write_transaction const &, nano::uint256_union const &) = 0;
 
 	virtual void pruned_put (nano::write_transaction const & transaction_a, nano::block_hash const & hash_a) = 0;
 	virtual void pruned_del (nano::write_transaction const & transaction_a, nano::block_hash const & hash_a) = 0;
@@ -701,6 +1061,9 @@ public:
 
 	virtual uint64_t block_account_height (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const = 0;
 	virtual std::mutex & get_cache_mutex () = 0;
+	virtual nano::block_cache & get_block_cache () = 0;
+	virtual nano::account_info_cache & get_account_info_cache () = 0;
+	virtual nano::confirmation_height_cache & get_confirmation_height_cache () = 0;
 
 	virtual unsigned max_block_write_batch_num () const = 0;
 
@@ -710,6 +1073,8 @@ public:
 	/** Not applicable to all sub-classes */
 	virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
 	virtual void serialize_memory_stats (boost::property_tree::ptree &) = 0;
+	/** Durably flushes every committed transaction. Not applicable to all sub-classes */
+	virtual void sync (){};
 
 	virtual bool init_error () const = 0;
 
@@ -722,7 +1087,9 @@ public:
 	virtual std::string vendor_get () const = 0;
 };
 
-std::unique_ptr<nano::block_store> make_store (nano::logger_mt & logger, boost::filesystem::path const & path, bool open_read_only = false, bool add_db_postfix = false, nano::rocksdb_config const & rocksdb_config = nano::rocksdb_config{}, nano::txn_tracking_config const & txn_tracking_config_a = nano::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), nano::lmdb_config const & lmdb_config_a = nano::lmdb_config{}, bool backup_before_upgrade = false, bool rocksdb_backend = false);
+std::unique_ptr<container_info_component> collect_container_info (block_store & block_store, const std::string & name);
+
+std::unique_ptr<nano::block_store> make_store (nano::logger_mt & logger, boost::filesystem::path const & path, bool open_read_only = false, bool add_db_postfix = false, nano::rocksdb_config const & rocksdb_config = nano::rocksdb_config{}, nano::txn_tracking_config const & txn_tracking_config_a = nano::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), nano::lmdb_config const & lmdb_config_a = nano::lmdb_config{}, bool backup_before_upgrade = false, bool rocksdb_backend = false, size_t block_cache_max = 0, size_t account_cache_max = 0);
 }
 
 namespace std
@@ -32,6 +32,10 @@ public:
 	friend class nano::block_predecessor_set<Val, Derived_Store>;
 
 	std::mutex cache_mutex;
+	nano::store_cache_order cache_order;
+	mutable nano::block_cache block_cache{ cache_order };
+	nano::account_info_cache account_info_cache{ cache_order };
+	nano::confirmation_height_cache confirmation_height_cache{ cache_order };
 
 	/**
 	 * If using a different store version than the latest then you may need
@@ -106,11 +110,7 @@ public:
 	{
 		debug_assert (block_a.sideband ().successor.is_zero () || block_exists (transaction_a, block_a.sideband ().successor));
 		std::vector<uint8_t> vector;
-		{
-			nano::vectorstream stream (vector);
-			nano::serialize_block (stream, block_a);
-			block_a.sideband ().serialize (stream, block_a.type ());
-		}
+		block_serialize (vector, block_a, block_a.sideband ());
 		block_raw_put (transaction_a, vector, hash_a);
 		nano::block_predecessor_set<Val, Derived_Store> predecessor (transaction_a, *this);
 		block_a.visit (predecessor);
@@ -126,20 +126,56 @@ public:
 
 	std::shared_ptr<nano::block> block_get (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const override
 	{
-		auto value (block_raw_get (transaction_a, hash_a));
 		std::shared_ptr<nano::block> result;
-		if (value.size () != 0)
+		auto cached (block_cache.get (transaction_a, hash_a));
+		if (cached)
 		{
-			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-			nano::block_type type;
-			auto error (try_read (stream, type));
-			release_assert (!error);
-			result = nano::deserialize_block (stream, type);
-			release_assert (result != nullptr);
-			nano::block_sideband sideband;
-			error = (sideband.deserialize (stream, type));
-			release_assert (!error);
-			result->sideband_set (sideband);
+			result = *cached;
+		}
+		else
+		{
+			auto value (block_raw_get (transaction_a, hash_a));
+			result = block_deserialize (value);
+			if (result != nullptr)
+			{
+				block_cache.fill (transaction_a, hash_a, result);
+			}
+		}
+		return result;
+	}
+
+	std::vector<std::shared_ptr<nano::block>> block_get_batch (nano::transaction const & transaction_a, std::vector<nano::block_hash> const & hashes_a) const override
+	{
+		std::vector<std::shared_ptr<nano::block>> result;
+		result.reserve (hashes_a.size ());
+		// Only the blocks missing from the cache are read from the table
+		std::vector<size_t> misses;
+		std::vector<nano::db_val<Val>> keys;
+		for (size_t i (0), n (hashes_a.size ()); i < n; ++i)
+		{
+			auto cached (block_cache.get (transaction_a, hashes_a[i]));
+			result.push_back (cached ? *cached : nullptr);
+			if (!cached)
+			{
+				misses.push_back (i);
+				keys.emplace_back (hashes_a[i]);
+			}
+		}
+		if (!keys.empty ())
+		{
+			std::vector<nano::db_val<Val>> values;
+			std::vector<int> statuses;
+			get_batch (transaction_a, tables::blocks, keys, values, statuses);
+			for (size_t i (0), n (keys.size ()); i < n; ++i)
+			{
+				release_assert (success (statuses[i]) || not_found (statuses[i]));
+				if (success (statuses[i]))
+				{
+					auto & block_l (result[misses[i]]);
+					block_l = block_deserialize (values[i]);
+					block_cache.fill (transaction_a, hashes_a[misses[i]], block_l);
+				}
+			}
 		}
 		return result;
 	}
@@ -215,18 +251,27 @@ public:
 	{
 		auto value (block_raw_get (transaction_a, hash_a));
 		nano::block_hash result;
+		result.clear ();
 		if (value.size () != 0)
 		{
-			debug_assert (value.size () >= result.bytes.size ());
-			auto type = block_type_from_raw (value.data ());
-			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()) + block_successor_offset (transaction_a, value.size (), type), result.bytes.size ());
-			auto error (nano::try_read (stream, result.bytes));
-			(void)error;
-			debug_assert (!error);
-		}
-		else
-		{
-			result.clear ();
+			auto data (reinterpret_cast<uint8_t const *> (value.data ()));
+			auto offset (block_sideband_offset (block_type_from_raw (value.data ())));
+			debug_assert (value.size () > offset);
+			if (blocks_legacy_format)
+			{
+				// The legacy sideband always starts with the successor
+				nano::bufferstream stream (data + offset, result.bytes.size ());
+				auto error (nano::try_read (stream, result.bytes));
+				(void)error;
+				debug_assert (!error);
+			}
+			else if ((data[offset] & nano::block_sideband::compact_successor_flag) != 0)
+			{
+				nano::bufferstream stream (data + offset + 1, result.bytes.size ());
+				auto error (nano::try_read (stream, result.bytes));
+				(void)error;
+				debug_assert (!error);
+			}
 		}
 		return result;
 	}
@@ -235,9 +280,8 @@ public:
 	{
 		auto value (block_raw_get (transaction_a, hash_a));
 		debug_assert (value.size () != 0);
-		auto type = block_type_from_raw (value.data ());
 		std::vector<uint8_t> data (static_cast<uint8_t *> (value.data ()), static_cast<uint8_t *> (value.data ()) + value.size ());
-		std::fill_n (data.begin () + block_successor_offset (transaction_a, value.size (), type), sizeof (nano::block_hash), uint8_t{ 0 });
+		block_successor_raw_set (data, nano::block_hash (0));
 		block_raw_put (transaction_a, data, hash_a);
 	}
 
@@ -353,10 +397,26 @@ public:
 		return cache_mutex;
 	}
 
+	nano::block_cache & get_block_cache () override
+	{
+		return block_cache;
+	}
+
+	nano::account_info_cache & get_account_info_cache () override
+	{
+		return account_info_cache;
+	}
+
+	nano::confirmation_height_cache & get_confirmation_height_cache () override
+	{
+		return confirmation_height_cache;
+	}
+
 	void block_del (nano::write_transaction const & transaction_a, nano::block_hash const & hash_a) override
 	{
 		auto status = del (transaction_a, tables::blocks, hash_a);
 		release_assert (success (status));
+		block_cache.erase (transaction_a, hash_a);
 	}
 
 	int version_get (nano::transaction const & transaction_a) const override
@@ -374,6 +434,34 @@ public:
 		return result;
 	}
 
+	nano::uint256_union rep_weights_marker_get (nano::transaction const & transaction_a) const override
+	{
+		nano::uint256_union marker_key (3);
+		nano::db_val<Val> data;
+		auto status = get (transaction_a, tables::meta, nano::db_val<Val> (marker_key), data);
+		nano::uint256_union result (0);
+		if (success (status))
+		{
+			result = nano::uint256_union (data);
+		}
+		return result;
+	}
+
+	void rep_weights_marker_put (nano::write_transaction const & transaction_a, nano::uint256_union const & marker_a) override
+	{
+		nano::uint256_union marker_key (3);
+		if (!marker_a.is_zero ())
+		{
+			auto status = put (transaction_a, tables::meta, nano::db_val<Val> (marker_key), nano::db_val<Val> (marker_a));
+			release_assert (success (status));
+		}
+		else if (exists (transaction_a, tables::meta, nano::db_val<Val> (marker_key)))
+		{
+			auto status = del (transaction_a, tables::meta, nano::db_val<Val> (marker_key));
+			release_assert (success (status));
+		}
+	}
+
 	nano::epoch block_version (nano::transaction const & transaction_a, nano::block_hash const & hash_a) override
 	{
 		auto block = block_get (transaction_a, hash_a);
@@ -390,6 +478,11 @@ public:
 		nano::db_val<Val> value{ data.size (), (void *)data.data () };
 		auto status = put (transaction_a, tables::blocks, hash_a, value);
 		release_assert (success (status));
+		// Also used by successor updates, which rewrite the entry
+		if (block_cache.max > 0)
+		{
+			block_cache.put (transaction_a, hash_a, block_deserialize (value));
+		}
 	}
 
 	void pending_put (nano::write_transaction const & transaction_a, nano::pending_key const & key_a, nano::pending_info const & pending_info_a) override
@@ -420,6 +513,30 @@ public:
 		return result;
 	}
 
+	std::vector<boost::optional<nano::pending_info>> pending_get_batch (nano::transaction const & transaction_a, std::vector<nano::pending_key> const & keys_a) override
+	{
+		std::vector<nano::db_val<Val>> keys (keys_a.begin (), keys_a.end ());
+		std::vector<nano::db_val<Val>> values;
+		std::vector<int> statuses;
+		get_batch (transaction_a, tables::pending, keys, values, statuses);
+		std::vector<boost::optional<nano::pending_info>> result (keys.size ());
+		for (size_t i (0), n (keys.size ()); i < n; ++i)
+		{
+			release_assert (success (statuses[i]) || not_found (statuses[i]));
+			if (success (statuses[i]))
+			{
+				nano::pending_info pending;
+				nano::bufferstream stream (reinterpret_cast<uint8_t const *> (values[i].data ()), values[i].size ());
+				auto error (pending.deserialize (stream));
+				if (!error)
+				{
+					result[i] = pending;
+				}
+			}
+		}
+		return result;
+	}
+
 	void frontier_put (nano::write_transaction const & transaction_a, nano::block_hash const & block_a, nano::account const & account_a) override
 	{
 		nano::db_val<Val> account (account_a);
@@ -513,25 +630,82 @@ public:
 		nano::db_val<Val> info (info_a);
 		auto status = put (transaction_a, tables::accounts, account_a, info);
 		release_assert (success (status));
+		if (account_info_cache.max > 0)
+		{
+			account_info_cache.put (transaction_a, account_a, info_a);
+		}
 	}
 
 	void account_del (nano::write_transaction const & transaction_a, nano::account const & account_a) override
 	{
 		auto status = del (transaction_a, tables::accounts, account_a);
 		release_assert (success (status));
+		account_info_cache.erase (transaction_a, account_a);
 	}
 
 	bool account_get (nano::transaction const & transaction_a, nano::account const & account_a, nano::account_info & info_a) override
 	{
-		nano::db_val<Val> value;
-		nano::db_val<Val> account (account_a);
-		auto status1 (get (transaction_a, tables::accounts, account, value));
-		release_assert (success (status1) || not_found (status1));
 		bool result (true);
-		if (success (status1))
+		auto cached (account_info_cache.get (transaction_a, account_a));
+		if (cached)
 		{
-			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-			result = info_a.deserialize (stream);
+			info_a = *cached;
+			result = false;
+		}
+		else
+		{
+			nano::db_val<Val> value;
+			nano::db_val<Val> account (account_a);
+			auto status1 (get (transaction_a, tables::accounts, account, value));
+			release_assert (success (status1) || not_found (status1));
+			if (success (status1))
+			{
+				nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
+				result = info_a.deserialize (stream);
+				if (!result)
+				{
+					account_info_cache.fill (transaction_a, account_a, info_a);
+				}
+			}
+		}
+		return result;
+	}
+
+	std::vector<boost::optional<nano::account_info>> account_get_batch (nano::transaction const & transaction_a, std::vector<nano::account> const & accounts_a) override
+	{
+		std::vector<boost::optional<nano::account_info>> result (accounts_a.size ());
+		// Only the accounts missing from the cache are read from the table
+		std::vector<size_t> misses;
+		std::vector<nano::db_val<Val>> keys;
+		for (size_t i (0), n (accounts_a.size ()); i < n; ++i)
+		{
+			result[i] = account_info_cache.get (transaction_a, accounts_a[i]);
+			if (!result[i])
+			{
+				misses.push_back (i);
+				keys.emplace_back (accounts_a[i]);
+			}
+		}
+		if (!keys.empty ())
+		{
+			std::vector<nano::db_val<Val>> values;
+			std::vector<int> statuses;
+			get_batch (transaction_a, tables::accounts, keys, values, statuses);
+			for (size_t i (0), n (keys.size ()); i < n; ++i)
+			{
+				release_assert (success (statuses[i]) || not_found (statuses[i]));
+				if (success (statuses[i]))
+				{
+					nano::account_info info;
+					nano::bufferstream stream (reinterpret_cast<uint8_t const *> (values[i].data ()), values[i].size ());
+					auto error (info.deserialize (stream));
+					if (!error)
+					{
+						result[misses[i]] = info;
+						account_info_cache.fill (transaction_a, accounts_a[misses[i]], info);
+					}
+				}
+			}
 		}
 		return result;
 	}
@@ -666,18 +840,35 @@ public:
 		nano::db_val<Val> confirmation_height_info (confirmation_height_info_a);
 		auto status = put (transaction_a, tables::confirmation_height, account_a, confirmation_height_info);
 		release_assert (success (status));
+		if (confirmation_height_cache.max > 0)
+		{
+			confirmation_height_cache.put (transaction_a, account_a, confirmation_height_info_a);
+		}
 	}
 
 	bool confirmation_height_get (nano::transaction const & transaction_a, nano::account const & account_a, nano::confirmation_height_info & confirmation_height_info_a) override
 	{
-		nano::db_val<Val> value;
-		auto status = get (transaction_a, tables::confirmation_height, nano::db_val<Val> (account_a), value);
-		release_assert (success (status) || not_found (status));
 		bool result (true);
-		if (success (status))
+		auto cached (confirmation_height_cache.get (transaction_a, account_a));
+		if (cached)
 		{
-			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-			result = confirmation_height_info_a.deserialize (stream);
+			confirmation_height_info_a = *cached;
+			result = false;
+		}
+		else
+		{
+			nano::db_val<Val> value;
+			auto status = get (transaction_a, tables::confirmation_height, nano::db_val<Val> (account_a), value);
+			release_assert (success (status) || not_found (status));
+			if (success (status))
+			{
+				nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
+				result = confirmation_height_info_a.deserialize (stream);
+				if (!result)
+				{
+					confirmation_height_cache.fill (transaction_a, account_a, confirmation_height_info_a);
+				}
+			}
 		}
 		return result;
 	}
@@ -686,6 +877,7 @@ public:
 	{
 		auto status (del (transaction_a, tables::confirmation_height, nano::db_val<Val> (account_a)));
 		release_assert (success (status));
+		confirmation_height_cache.erase (transaction_a, account_a);
 	}
 
 	bool confirmation_height_exists (nano::transaction const & transaction_a, nano::account const & account_a) const override
@@ -782,7 +974,9 @@ protected:
 	nano::network_params network_params;
 	std::unordered_map<nano::account, std::shared_ptr<nano::vote>> vote_cache_l1;
 	std::unordered_map<nano::account, std::shared_ptr<nano::vote>> vote_cache_l2;
-	int const version{ 20 };
+	int const version{ 21 };
+	/** Set when a read only store opens a ledger whose blocks have not been upgraded to the compact format yet */
+	bool blocks_legacy_format{ false };
 
 	template <typename Key, typename Value>
 	nano::store_iterator<Key, Value> make_iterator (nano::transaction const & transaction_a, tables table_a) const
@@ -804,9 +998,63 @@ protected:
 		return result;
 	}
 
-	size_t block_successor_offset (nano::transaction const & transaction_a, size_t entry_size_a, nano::block_type type_a) const
+	std::shared_ptr<nano::block> block_deserialize (nano::db_val<Val> const & value_a) const
+	{
+		std::shared_ptr<nano::block> result;
+		if (value_a.size () != 0)
+		{
+			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value_a.data ()), value_a.size ());
+			nano::block_type type;
+			auto error (try_read (stream, type));
+			release_assert (!error);
+			result = nano::deserialize_block (stream, type);
+			release_assert (result != nullptr);
+			nano::block_sideband sideband;
+			error = blocks_legacy_format ? sideband.deserialize (stream, type) : sideband.deserialize_compact (stream, type);
+			release_assert (!error);
+			result->sideband_set (sideband);
+		}
+		return result;
+	}
+
+	/** Writes a blocks table entry: the block type, the block and its compact sideband */
+	static void block_serialize (std::vector<uint8_t> & data_a, nano::block const & block_a, nano::block_sideband const & sideband_a)
 	{
-		return entry_size_a - nano::block_sideband::size (type_a);
+		nano::vectorstream stream (data_a);
+		nano::serialize_block (stream, block_a);
+		sideband_a.serialize_compact (stream, block_a.type ());
+	}
+
+	/** Offset of the compact sideband flags in a blocks table entry, blocks have a fixed size per type */
+	static size_t block_sideband_offset (nano::block_type type_a)
+	{
+		return sizeof (nano::block_type) + nano::block::size (type_a);
+	}
+
+	/** Updates the successor of a raw blocks table entry, which grows or shrinks as the successor is set or cleared */
+	static void block_successor_raw_set (std::vector<uint8_t> & data_a, nano::block_hash const & successor_a)
+	{
+		auto offset (block_sideband_offset (block_type_from_raw (data_a.data ())));
+		debug_assert (data_a.size () > offset);
+		auto & flags (data_a[offset]);
+		auto successor_begin (data_a.begin () + offset + 1);
+		if ((flags & nano::block_sideband::compact_successor_flag) != 0)
+		{
+			if (successor_a.is_zero ())
+			{
+				flags &= ~nano::block_sideband::compact_successor_flag;
+				data_a.erase (successor_begin, successor_begin + sizeof (nano::block_hash));
+			}
+			else
+			{
+				std::copy (successor_a.bytes.begin (), successor_a.bytes.end (), successor_begin);
+			}
+		}
+		else if (!successor_a.is_zero ())
+		{
+			flags |= nano::block_sideband::compact_successor_flag;
+			data_a.insert (successor_begin, successor_a.bytes.begin (), successor_a.bytes.end ());
+		}
 	}
 
 	static nano::block_type block_type_from_raw (void * data_a)
@@ -830,6 +1078,15 @@ protected:
 		return static_cast<Derived_Store const &> (*this).get (transaction_a, table_a, key_a, value_a);
 	}
 
+	/**
+	 * Looks up all \p keys_a in \p table_a. \p values_a and \p statuses_a are resized to match \p keys_a,
+	 * backends are free to perform the lookups in any order.
+	 */
+	void get_batch (nano::transaction const & transaction_a, tables table_a, std::vector<nano::db_val<Val>> const & keys_a, std::vector<nano::db_val<Val>> & values_a, std::vector<int> & statuses_a) const
+	{
+		static_cast<Derived_Store const &> (*this).get_batch (transaction_a, table_a, keys_a, values_a, statuses_a);
+	}
+
 	int put (nano::write_transaction const & transaction_a, tables table_a, nano::db_val<Val> const & key_a, nano::db_val<Val> const & value_a)
 	{
 		return static_cast<Derived_Store &> (*this).put (transaction_a, table_a, key_a, value_a);
@@ -871,9 +1128,8 @@ public:
 		auto hash (block_a.hash ());
 		auto value (store.block_raw_get (transaction, block_a.previous ()));
 		debug_assert (value.size () != 0);
-		auto type = store.block_type_from_raw (value.data ());
 		std::vector<uint8_t> data (static_cast<uint8_t *> (value.data ()), static_cast<uint8_t *> (value.data ()) + value.size ());
-		std::copy (hash.bytes.begin (), hash.bytes.end (), data.begin () + store.block_successor_offset (transaction, value.size (), type));
+		store.block_successor_raw_set (data, hash);
 		store.block_raw_put (transaction, data, block_a.previous ());
 	}
 	void send_block (nano::send_block const & block_a) override
@@ -1,3 +1,4 @@
+#include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/rep_weights.hpp>
 #include <nano/lib/stats.hpp>
 #include <nano/lib/utility.hpp>
@@ -6,8 +7,61 @@
 #include <nano/secure/common.hpp>
 #include <nano/secure/ledger.hpp>
 
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstring>
+#include <fstream>
+
 namespace
 {
+/**
+ * Layout of the rep weights snapshot: this header followed by entry_count entries.
+ * Values are in native byte order, a snapshot is only read back by the node which wrote it.
+ */
+class rep_weights_snapshot_header final
+{
+public:
+	std::array<char, 8> magic;
+	uint32_t format_version;
+	uint32_t store_version;
+	uint64_t block_count;
+	uint64_t account_count;
+	uint64_t entry_count;
+	uint8_t epoch_2_started;
+	std::array<uint8_t, 7> padding;
+	/** Random value also kept in the store's meta table, ties the snapshot to the ledger it was written for */
+	nano::uint256_union ledger_marker;
+	/** Blake2b of the header with a zero checksum, followed by all entries */
+	nano::uint256_union checksum;
+};
+
+class rep_weights_snapshot_entry final
+{
+public:
+	nano::account representative;
+	nano::amount weight;
+};
+
+static_assert (sizeof (rep_weights_snapshot_header) == 112, "Unexpected padding in rep weights snapshot header");
+static_assert (sizeof (rep_weights_snapshot_entry) == 48, "Unexpected padding in rep weights snapshot entry");
+
+std::array<char, 8> constexpr rep_weights_snapshot_magic{ { 'n', 'a', 'n', 'o', 'r', 'e', 'p', 'w' } };
+uint32_t constexpr rep_weights_snapshot_format_version{ 2 };
+
+nano::uint256_union rep_weights_snapshot_checksum (rep_weights_snapshot_header header_a, uint8_t const * entries_a, size_t size_a)
+{
+	header_a.checksum.clear ();
+	nano::uint256_union result;
+	blake2b_state hash;
+	blake2b_init (&hash, sizeof (result.bytes));
+	blake2b_update (&hash, &header_a, sizeof (header_a));
+	blake2b_update (&hash, entries_a, size_a);
+	blake2b_final (&hash, result.bytes.data (), sizeof (result.bytes));
+	return result;
+}
+
 /**
  * Roll back the visited block
  */
@@ -50,9 +104,10 @@ public:
 	void receive_block (nano::receive_block const & block_a) override
 	{
 		auto hash (block_a.hash ());
-		auto amount (ledger.amount (transaction, block_a.hashables.source));
+		auto amount (ledger.amount (transaction, hash));
 		auto destination_account (ledger.account (transaction, hash));
-		auto source_account (ledger.account (transaction, block_a.hashables.source));
+		// The source block may have been pruned, the pending entry then has no source account
+		auto source_account (ledger.account_safe (transaction, block_a.hashables.source));
 		nano::account_info info;
 		auto error (ledger.store.account_get (transaction, destination_account, info));
 		(void)error;
@@ -70,9 +125,10 @@ public:
 	void open_block (nano::open_block const & block_a) override
 	{
 		auto hash (block_a.hash ());
-		auto amount (ledger.amount (transaction, block_a.hashables.source));
+		auto amount (ledger.amount (transaction, hash));
 		auto destination_account (ledger.account (transaction, hash));
-		auto source_account (ledger.account (transaction, block_a.hashables.source));
+		// The source block may have been pruned, the pending entry then has no source account
+		auto source_account (ledger.account_safe (transaction, block_a.hashables.source));
 		ledger.cache.rep_weights.representation_add (block_a.representative (), 0 - amount);
 		nano::account_info new_info;
 		ledger.change_latest (transaction, destination_account, new_info, new_info);
@@ -143,7 +199,8 @@ public:
 		}
 		else if (!block_a.hashables.link.is_zero () && !ledger.is_epoch_link (block_a.hashables.link))
 		{
-			nano::pending_info pending_info (ledger.account (transaction, block_a.hashables.link.as_block_hash ()), block_a.hashables.balance.number () - balance, block_a.sideband ().source_epoch);
+			// The source block may have been pruned, the pending entry then has no source account
+			nano::pending_info pending_info (ledger.account_safe (transaction, block_a.hashables.link.as_block_hash ()), block_a.hashables.balance.number () - balance, block_a.sideband ().source_epoch);
 			ledger.store.pending_put (transaction, nano::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), pending_info);
 			ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::receive);
 		}
@@ -258,7 +315,7 @@ void ledger_processor::state_block (nano::state_block & block_a)
 void ledger_processor::state_block_impl (nano::state_block & block_a)
 {
 	auto hash (block_a.hash ());
-	auto existing (ledger.store.block_exists (transaction, hash));
+	auto existing (ledger.block_or_pruned_exists (transaction, hash));
 	result.code = existing ? nano::process_result::old : nano::process_result::progress; // Have we seen this block before? (Unambiguous)
 	if (result.code == nano::process_result::progress)
 	{
@@ -316,7 +373,7 @@ void ledger_processor::state_block_impl (nano::state_block & block_a)
 					{
 						if (!block_a.hashables.link.is_zero ())
 						{
-							result.code = ledger.store.block_exists (transaction, block_a.hashables.link.as_block_hash ()) ? nano::process_result::progress : nano::process_result::gap_source; // Have we seen the source block already? (Harmless)
+							result.code = ledger.block_or_pruned_exists (transaction, block_a.hashables.link.as_block_hash ()) ? nano::process_result::progress : nano::process_result::gap_source; // Have we seen the source block already? (Harmless)
 							if (result.code == nano::process_result::progress)
 							{
 								nano::pending_key key (block_a.hashables.account, block_a.hashables.link.as_block_hash ());
@@ -385,7 +442,7 @@ void ledger_processor::state_block_impl (nano::state_block & block_a)
 void ledger_processor::epoch_block_impl (nano::state_block & block_a)
 {
 	auto hash (block_a.hash ());
-	auto existing (ledger.store.block_exists (transaction, hash));
+	auto existing (ledger.block_or_pruned_exists (transaction, hash));
 	result.code = existing ? nano::process_result::old : nano::process_result::progress; // Have we seen this block before? (Unambiguous)
 	if (result.code == nano::process_result::progress)
 	{
@@ -475,7 +532,7 @@ void ledger_processor::epoch_block_impl (nano::state_block & block_a)
 void ledger_processor::change_block (nano::change_block & block_a)
 {
 	auto hash (block_a.hash ());
-	auto existing (ledger.store.block_exists (transaction, hash));
+	auto existing (ledger.block_or_pruned_exists (transaction, hash));
 	result.code = existing ? nano::process_result::old : nano::process_result::progress; // Have we seen this block before? (Harmless)
 	if (result.code == nano::process_result::progress)
 	{
@@ -529,7 +586,7 @@ void ledger_processor::change_block (nano::change_block & block_a)
 void ledger_processor::send_block (nano::send_block & block_a)
 {
 	auto hash (block_a.hash ());
-	auto existing (ledger.store.block_exists (transaction, hash));
+	auto existing (ledger.block_or_pruned_exists (transaction, hash));
 	result.code = existing ? nano::process_result::old : nano::process_result::progress; // Have we seen this block before? (Harmless)
 	if (result.code == nano::process_result::progress)
 	{
@@ -588,7 +645,7 @@ void ledger_processor::send_block (nano::send_block & block_a)
 void ledger_processor::receive_block (nano::receive_block & block_a)
 {
 	auto hash (block_a.hash ());
-	auto existing (ledger.store.block_exists (transaction, hash));
+	auto existing (ledger.block_or_pruned_exists (transaction, hash));
 	result.code = existing ? nano::process_result::old : nano::process_result::progress; // Have we seen this block already?  (Harmless)
 	if (result.code == nano::process_result::progress)
 	{
@@ -612,7 +669,7 @@ void ledger_processor::receive_block (nano::receive_block & block_a)
 					{
 						debug_assert (!validate_message (account, hash, block_a.signature));
 						result.verified = nano::signature_verification::valid;
-						result.code = ledger.store.block_exists (transaction, block_a.hashables.source) ? nano::process_result::progress : nano::process_result::gap_source; // Have we seen the source block already? (Harmless)
+						result.code = ledger.block_or_pruned_exists (transaction, block_a.hashables.source) ? nano::process_result::progress : nano::process_result::gap_source; // Have we seen the source block already? (Harmless)
 						if (result.code == nano::process_result::progress)
 						{
 							nano::account_info info;
@@ -656,7 +713,7 @@ void ledger_processor::receive_block (nano::receive_block & block_a)
 				}
 				else
 				{
-					result.code = ledger.store.block_exists (transaction, block_a.hashables.previous) ? nano::process_result::fork : nano::process_result::gap_previous; // If we have the block but it's not the latest we have a signed fork (Malicious)
+					result.code = ledger.block_or_pruned_exists (transaction, block_a.hashables.previous) ? nano::process_result::fork : nano::process_result::gap_previous; // If we have the block but it's not the latest we have a signed fork (Malicious)
 				}
 			}
 		}
@@ -666,7 +723,7 @@ void ledger_processor::receive_block (nano::receive_block & block_a)
 void ledger_processor::open_block (nano::open_block & block_a)
 {
 	auto hash (block_a.hash ());
-	auto existing (ledger.store.block_exists (transaction, hash));
+	auto existing (ledger.block_or_pruned_exists (transaction, hash));
 	result.code = existing ? nano::process_result::old : nano::process_result::progress; // Have we seen this block already? (Harmless)
 	if (result.code == nano::process_result::progress)
 	{
@@ -679,7 +736,7 @@ void ledger_processor::open_block (nano::open_block & block_a)
 		{
 			debug_assert (!validate_message (block_a.hashables.account, hash, block_a.signature));
 			result.verified = nano::signature_verification::valid;
-			result.code = ledger.store.block_exists (transaction, block_a.hashables.source) ? nano::process_result::progress : nano::process_result::gap_source; // Have we seen the source block? (Harmless)
+			result.code = ledger.block_or_pruned_exists (transaction, block_a.hashables.source) ? nano::process_result::progress : nano::process_result::gap_source; // Have we seen the source block? (Harmless)
 			if (result.code == nano::process_result::progress)
 			{
 				nano::account_info info;
@@ -733,11 +790,12 @@ verification (verification_a)
 }
 } // namespace
 
-nano::ledger::ledger (nano::block_store & store_a, nano::stat & stat_a, nano::generate_cache const & generate_cache_a, std::function<void()> epoch_2_started_cb_a) :
+nano::ledger::ledger (nano::block_store & store_a, nano::stat & stat_a, nano::generate_cache const & generate_cache_a, std::function<void()> epoch_2_started_cb_a, boost::filesystem::path const & rep_weights_snapshot_a) :
 store (store_a),
 stats (stat_a),
 check_bootstrap_weights (true),
-epoch_2_started_cb (epoch_2_started_cb_a)
+epoch_2_started_cb (epoch_2_started_cb_a),
+rep_weights_snapshot (rep_weights_snapshot_a)
 {
 	if (!store.init_error ())
 	{
@@ -747,7 +805,14 @@ epoch_2_started_cb (epoch_2_started_cb_a)
 
 void nano::ledger::initialize (nano::generate_cache const & generate_cache_a)
 {
-	if (generate_cache_a.reps || generate_cache_a.account_count || generate_cache_a.epoch_2 || generate_cache_a.block_count)
+	auto generate_account_cache (generate_cache_a.reps || generate_cache_a.account_count || generate_cache_a.epoch_2 || generate_cache_a.block_count);
+	if (!rep_weights_snapshot.empty () && !generate_account_cache)
+	{
+		// Changes made through this ledger are not tracked in the cache, a snapshot left on disk would become stale
+		boost::system::error_code ec;
+		boost::filesystem::remove (rep_weights_snapshot, ec);
+	}
+	if (generate_account_cache && (rep_weights_snapshot.empty () || rep_weights_snapshot_load ()))
 	{
 		store.latest_for_each_par (
 		[this](nano::store_iterator<nano::account, nano::account_info> i, nano::store_iterator<nano::account, nano::account_info> n) {
@@ -772,6 +837,13 @@ void nano::ledger::initialize (nano::generate_cache const & generate_cache_a)
 			this->cache.rep_weights.copy_from (rep_weights_l);
 		});
 	}
+	rep_weights_complete = generate_account_cache;
+	if (!rep_weights_snapshot.empty ())
+	{
+		// Any later write makes the snapshot stale, clearing the marker keeps it from being accepted should the file survive
+		auto transaction (store.tx_begin_write ({ tables::meta }));
+		store.rep_weights_marker_put (transaction, nano::uint256_union (0));
+	}
 
 	if (generate_cache_a.cemented_count)
 	{
@@ -790,12 +862,134 @@ void nano::ledger::initialize (nano::generate_cache const & generate_cache_a)
 	cache.pruned_count = store.pruned_count (transaction);
 }
 
+/*
+ * Loads the snapshot into the cache instead of scanning every account. The snapshot is removed afterwards whether it was used or not,
+ * it only describes the ledger as it was when last closed and is written again by rep_weights_snapshot_write.
+ * Returns true if the snapshot is missing or doesn't match this store, the caller then falls back to the full scan.
+ */
+bool nano::ledger::rep_weights_snapshot_load ()
+{
+	auto error (true);
+	boost::system::error_code ec;
+	if (boost::filesystem::exists (rep_weights_snapshot, ec))
+	{
+		try
+		{
+			boost::interprocess::file_mapping file (rep_weights_snapshot.string ().c_str (), boost::interprocess::read_only);
+			boost::interprocess::mapped_region region (file, boost::interprocess::read_only);
+			auto data (static_cast<uint8_t const *> (region.get_address ()));
+			auto size (region.get_size ());
+			rep_weights_snapshot_header header;
+			if (size >= sizeof (header))
+			{
+				std::memcpy (&header, data, sizeof (header));
+				auto entries (data + sizeof (header));
+				auto entries_size (size - sizeof (header));
+				auto transaction (store.tx_begin_read ());
+				// A snapshot from another ledger, or one left behind by a ledger modified since, doesn't carry the store's current marker
+				if (header.magic == rep_weights_snapshot_magic && header.format_version == rep_weights_snapshot_format_version && header.store_version == static_cast<uint32_t> (store.version_get (transaction)) && !header.ledger_marker.is_zero () && header.ledger_marker == store.rep_weights_marker_get (transaction) && entries_size == header.entry_count * sizeof (rep_weights_snapshot_entry) && rep_weights_snapshot_checksum (header, entries, entries_size) == header.checksum)
+				{
+					nano::rep_weights rep_weights_l;
+					for (uint64_t i (0); i < header.entry_count; ++i)
+					{
+						rep_weights_snapshot_entry entry;
+						std::memcpy (&entry, entries + i * sizeof (entry), sizeof (entry));
+						rep_weights_l.representation_put (entry.representative, entry.weight);
+					}
+					cache.rep_weights.copy_from (rep_weights_l);
+					cache.block_count = header.block_count;
+					cache.account_count = header.account_count;
+					if (header.epoch_2_started != 0)
+					{
+						cache.epoch_2_started.store (true);
+					}
+					error = false;
+				}
+			}
+		}
+		catch (boost::interprocess::interprocess_exception const &)
+		{
+		}
+		stats.inc (nano::stat::type::ledger, error ? nano::stat::detail::snapshot_rejected : nano::stat::detail::snapshot_loaded);
+		boost::filesystem::remove (rep_weights_snapshot, ec);
+	}
+	return error;
+}
+
+void nano::ledger::rep_weights_snapshot_write ()
+{
+	if (!rep_weights_snapshot.empty () && rep_weights_complete)
+	{
+		// Keeps other writers from changing the cache while it is copied
+		auto transaction (store.tx_begin_write ({ tables::meta }));
+		std::vector<rep_weights_snapshot_entry> entries;
+		for (auto const & weight : cache.rep_weights.get_rep_amounts ())
+		{
+			if (!weight.second.is_zero ())
+			{
+				entries.push_back ({ weight.first, weight.second });
+			}
+		}
+		rep_weights_snapshot_header header{};
+		header.magic = rep_weights_snapshot_magic;
+		header.format_version = rep_weights_snapshot_format_version;
+		header.store_version = static_cast<uint32_t> (store.version_get (transaction));
+		header.block_count = cache.block_count;
+		header.account_count = cache.account_count;
+		header.entry_count = entries.size ();
+		header.epoch_2_started = cache.epoch_2_started ? 1 : 0;
+		nano::random_pool::generate_block (header.ledger_marker.bytes.data (), header.ledger_marker.bytes.size ());
+		auto entries_size (entries.size () * sizeof (rep_weights_snapshot_entry));
+		header.checksum = rep_weights_snapshot_checksum (header, reinterpret_cast<uint8_t const *> (entries.data ()), entries_size);
+		// Written next to the final location and renamed, a partially written snapshot is never picked up
+		auto temporary (rep_weights_snapshot);
+		temporary += ".tmp";
+		std::ofstream stream (temporary.string (), std::ios::binary | std::ios::trunc);
+		stream.write (reinterpret_cast<char const *> (&header), sizeof (header));
+		stream.write (reinterpret_cast<char const *> (entries.data ()), entries_size);
+		stream.close ();
+		boost::system::error_code ec;
+		if (stream.good ())
+		{
+			boost::filesystem::rename (temporary, rep_weights_snapshot, ec);
+		}
+		if (stream.good () && !ec)
+		{
+			store.rep_weights_marker_put (transaction, header.ledger_marker);
+		}
+		else
+		{
+			boost::filesystem::remove (temporary, ec);
+		}
+	}
+}
+
 // Balance for account containing hash
 nano::uint128_t nano::ledger::balance (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const
 {
 	return hash_a.is_zero () ? 0 : store.block_balance (transaction_a, hash_a);
 }
 
+// Balance for account containing hash, error_a is set if the block is not in the ledger (e.g. it has been pruned)
+nano::uint128_t nano::ledger::balance_safe (nano::transaction const & transaction_a, nano::block_hash const & hash_a, bool & error_a) const
+{
+	nano::uint128_t result (0);
+	if (!hash_a.is_zero ())
+	{
+		auto block (store.block_get (transaction_a, hash_a));
+		if (block != nullptr)
+		{
+			result = store.block_balance_calculated (block);
+		}
+		else
+		{
+			debug_assert (pruning);
+			error_a = true;
+		}
+	}
+	return result;
+}
+
 // Balance for an account by account number
 nano::uint128_t nano::ledger::account_balance (nano::transaction const & transaction_a, nano::account const & account_a)
 {
@@ -852,6 +1046,11 @@ bool nano::ledger::block_exists (nano::block_hash const & hash_a)
 	return store.block_exists (store.tx_begin_read (), hash_a);
 }
 
+bool nano::ledger::block_or_pruned_exists (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const
+{
+	return pruning ? store.block_or_pruned_exists (transaction_a, hash_a) : store.block_exists (transaction_a, hash_a);
+}
+
 std::string nano::ledger::block_text (char const * hash_a)
 {
 	return block_text (nano::block_hash (hash_a));
@@ -1002,6 +1201,22 @@ nano::account nano::ledger::account (nano::transaction const & transaction_a, na
 	return store.block_account (transaction_a, hash_a);
 }
 
+// Return account containing hash, or zero if the block is not in the ledger (e.g. it has been pruned)
+nano::account nano::ledger::account_safe (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const
+{
+	nano::account result (0);
+	auto block (store.block_get (transaction_a, hash_a));
+	if (block != nullptr)
+	{
+		result = store.block_account_calculated (*block);
+	}
+	else
+	{
+		debug_assert (pruning);
+	}
+	return result;
+}
+
 // Return amount decrease or increase for block
 nano::uint128_t nano::ledger::amount (nano::transaction const & transaction_a, nano::account const & account_a)
 {
@@ -1017,6 +1232,16 @@ nano::uint128_t nano::ledger::amount (nano::transaction const & transaction_a, n
 	return block_balance > previous_balance ? block_balance - previous_balance : previous_balance - block_balance;
 }
 
+// Return amount decrease or increase for block, error_a is set if the previous block has been pruned
+nano::uint128_t nano::ledger::amount_safe (nano::transaction const & transaction_a, nano::block_hash const & hash_a, bool & error_a) const
+{
+	auto block (store.block_get (transaction_a, hash_a));
+	debug_assert (block != nullptr);
+	auto block_balance (balance (transaction_a, hash_a));
+	auto previous_balance (balance_safe (transaction_a, block->previous (), error_a));
+	return error_a ? 0 : block_balance > previous_balance ? block_balance - previous_balance : previous_balance - block_balance;
+}
+
 // Return latest block for account
 nano::block_hash nano::ledger::latest (nano::transaction const & transaction_a, nano::account const & account_a)
 {
@@ -1056,7 +1281,7 @@ bool nano::ledger::could_fit (nano::transaction const & transaction_a, nano::blo
 {
 	auto dependencies (dependent_blocks (transaction_a, block_a));
 	return std::all_of (dependencies.begin (), dependencies.end (), [this, &transaction_a](nano::block_hash const & hash_a) {
-		return hash_a.is_zero () || store.block_exists (transaction_a, hash_a);
+		return hash_a.is_zero () || block_or_pruned_exists (transaction_a, hash_a);
 	});
 }
 
@@ -1227,6 +1452,11 @@ bool nano::ledger::block_confirmed (nano::transaction const & transaction_a, nan
 		release_assert (!store.confirmation_height_get (transaction_a, block->account ().is_zero () ? block->sideband ().account : block->account (), confirmation_height_info));
 		confirmed = (confirmation_height_info.height >= block->sideband ().height);
 	}
+	else if (pruning)
+	{
+		// Only cemented blocks are pruned
+		confirmed = store.pruned_exists (transaction_a, hash_a);
+	}
 	return confirmed;
 }
 
@@ -1272,6 +1502,39 @@ cemented_frontier (cemented_frontier), frontier (frontier), account (account)
 {
 }
 
+// Prunes the chain down from hash_a, the block itself included. Committing every batch_size_a blocks to limit the time the write lock is held
+uint64_t nano::ledger::pruning_action (nano::write_transaction & transaction_a, nano::block_hash const & hash_a, uint64_t const batch_size_a)
+{
+	uint64_t pruned_count (0);
+	nano::block_hash hash (hash_a);
+	while (!hash.is_zero () && hash != network_params.ledger.genesis_hash)
+	{
+		auto block (store.block_get (transaction_a, hash));
+		if (block != nullptr)
+		{
+			debug_assert (block_confirmed (transaction_a, hash));
+			store.block_del (transaction_a, hash);
+			store.pruned_put (transaction_a, hash);
+			hash = block->previous ();
+			++pruned_count;
+			++cache.pruned_count;
+			if (pruned_count % batch_size_a == 0)
+			{
+				transaction_a.commit ();
+				transaction_a.renew ();
+			}
+		}
+		else
+		{
+			// Everything below a pruned block has already been pruned
+			release_assert (store.pruned_exists (transaction_a, hash));
+			hash.clear ();
+		}
+	}
+	stats.add (nano::stat::type::pruning, nano::stat::detail::pruned_blocks, nano::stat::dir::in, pruned_count);
+	return pruned_count;
+}
+
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (ledger & ledger, const std::string & name)
 {
 	auto count = ledger.bootstrap_weights_size.load ();
@@ -3,6 +3,8 @@
 #include <nano/lib/rep_weights.hpp>
 #include <nano/secure/common.hpp>
 
+#include <boost/filesystem/path.hpp>
+
 #include <map>
 
 namespace nano
@@ -25,11 +27,14 @@ public:
 class ledger final
 {
 public:
-	ledger (nano::block_store &, nano::stat &, nano::generate_cache const & = nano::generate_cache (), std::function<void()> = nullptr);
+	ledger (nano::block_store &, nano::stat &, nano::generate_cache const & = nano::generate_cache (), std::function<void()> = nullptr, boost::filesystem::path const & = boost::filesystem::path ());
 	nano::account account (nano::transaction const &, nano::block_hash const &) const;
+	nano::account account_safe (nano::transaction const &, nano::block_hash const &) const;
 	nano::uint128_t amount (nano::transaction const &, nano::account const &);
 	nano::uint128_t amount (nano::transaction const &, nano::block_hash const &);
 	nano::uint128_t balance (nano::transaction const &, nano::block_hash const &) const;
+	nano::uint128_t balance_safe (nano::transaction const &, nano::block_hash const &, bool &) const;
+	nano::uint128_t amount_safe (nano::transaction const &, nano::block_hash const &, bool &) const;
 	nano::uint128_t account_balance (nano::transaction const &, nano::account const &);
 	nano::uint128_t account_pending (nano::transaction const &, nano::account const &);
 	nano::uint128_t weight (nano::account const &);
@@ -41,6 +46,7 @@ public:
 	nano::block_hash representative (nano::transaction const &, nano::block_hash const &);
 	nano::block_hash representative_calculated (nano::transaction const &, nano::block_hash const &);
 	bool block_exists (nano::block_hash const &);
+	bool block_or_pruned_exists (nano::transaction const &, nano::block_hash const &) const;
 	std::string block_text (char const *);
 	std::string block_text (nano::block_hash const &);
 	bool is_send (nano::transaction const &, nano::state_block const &) const;
@@ -58,6 +64,8 @@ public:
 	nano::account const & epoch_signer (nano::link const &) const;
 	nano::link const & epoch_link (nano::epoch) const;
 	std::multimap<uint64_t, uncemented_info, std::greater<>> unconfirmed_frontiers () const;
+	uint64_t pruning_action (nano::write_transaction &, nano::block_hash const &, uint64_t const);
+	void rep_weights_snapshot_write ();
 	static nano::uint128_t const unit;
 	nano::network_params network_params;
 	nano::block_store & store;
@@ -68,9 +76,16 @@ public:
 	uint64_t bootstrap_weight_max_blocks{ 1 };
 	std::atomic<bool> check_bootstrap_weights;
 	std::function<void()> epoch_2_started_cb;
+	/** Blocks missing from the ledger may have been pruned, see node::ledger_pruning */
+	bool pruning{ false };
+	/** Representative weights and ledger counts written when the ledger is closed, loaded instead of scanning all accounts at startup */
+	boost::filesystem::path const rep_weights_snapshot;
 
 private:
 	void initialize (nano::generate_cache const &);
+	bool rep_weights_snapshot_load ();
+	/** Whether the rep weights and counts in the cache cover the whole ledger, only then a snapshot can be written */
+	bool rep_weights_complete{ false };
 };
 
 std::unique_ptr<container_info_component> collect_container_info (ledger & ledger, const std::string & name);
@@ -1,55 +1,214 @@
 #include <nano/crypto_lib/random_pool.hpp>
-#include <nano/lib/locks.hpp>
 #include <nano/secure/buffer.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/network_filter.hpp>
 
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NANO_NETWORK_FILTER_X86
+#include <immintrin.h>
+#endif
+
+/*
+ * SipHash 2/4 with 128 bit output, producing the same digests as CryptoPP::SipHash<2, 4, true>
+ * Used to digest several buffers at once, see https://131002.net/siphash/siphash.pdf for the reference algorithm
+ */
+namespace
+{
+uint64_t load_little (uint8_t const * bytes_a)
+{
+	uint64_t result;
+	std::memcpy (&result, bytes_a, sizeof (result));
+	return boost::endian::little_to_native (result);
+}
+
+uint64_t rotl (uint64_t value_a, int bits_a)
+{
+	return (value_a << bits_a) | (value_a >> (64 - bits_a));
+}
+
+class siphash_state final
+{
+public:
+	siphash_state (uint64_t k0_a, uint64_t k1_a) :
+	v{ k0_a ^ 0x736f6d6570736575ULL, k1_a ^ 0x646f72616e646f6dULL ^ 0xee, k0_a ^ 0x6c7967656e657261ULL, k1_a ^ 0x7465646279746573ULL }
+	{
+	}
+	void round ()
+	{
+		v[0] += v[1];
+		v[1] = rotl (v[1], 13);
+		v[1] ^= v[0];
+		v[0] = rotl (v[0], 32);
+		v[2] += v[3];
+		v[3] = rotl (v[3], 16);
+		v[3] ^= v[2];
+		v[0] += v[3];
+		v[3] = rotl (v[3], 21);
+		v[3] ^= v[0];
+		v[2] += v[1];
+		v[1] = rotl (v[1], 17);
+		v[1] ^= v[2];
+		v[2] = rotl (v[2], 32);
+	}
+	void compress (uint64_t message_a)
+	{
+		v[3] ^= message_a;
+		round ();
+		round ();
+		v[0] ^= message_a;
+	}
+	/** Processes the message from byte \p offset_a onwards, \p offset_a being a multiple of 8 already compressed */
+	nano::uint128_t finish (uint8_t const * bytes_a, size_t size_a, size_t offset_a)
+	{
+		for (; offset_a + sizeof (uint64_t) <= size_a; offset_a += sizeof (uint64_t))
+		{
+			compress (load_little (bytes_a + offset_a));
+		}
+		uint64_t last (static_cast<uint64_t> (size_a) << 56);
+		for (auto i (offset_a); i < size_a; ++i)
+		{
+			last |= static_cast<uint64_t> (bytes_a[i]) << (8 * (i - offset_a));
+		}
+		compress (last);
+		v[2] ^= 0xee;
+		for (auto i (0); i < 4; ++i)
+		{
+			round ();
+		}
+		auto first_half (boost::endian::native_to_little (v[0] ^ v[1] ^ v[2] ^ v[3]));
+		v[1] ^= 0xdd;
+		for (auto i (0); i < 4; ++i)
+		{
+			round ();
+		}
+		auto second_half (boost::endian::native_to_little (v[0] ^ v[1] ^ v[2] ^ v[3]));
+		nano::uint128_union digest;
+		std::memcpy (digest.bytes.data (), &first_half, sizeof (first_half));
+		std::memcpy (digest.bytes.data () + sizeof (first_half), &second_half, sizeof (second_half));
+		return digest.number ();
+	}
+	uint64_t v[4];
+};
+
+void siphash_scalar (uint64_t k0_a, uint64_t k1_a, uint8_t const * const * bytes_a, size_t const * sizes_a, size_t count_a, nano::uint128_t * digests_a)
+{
+	for (size_t i (0); i < count_a; ++i)
+	{
+		siphash_state state (k0_a, k1_a);
+		digests_a[i] = state.finish (bytes_a[i], sizes_a[i], 0);
+	}
+}
+
+#ifdef NANO_NETWORK_FILTER_X86
+/*
+ * Four buffers per pass, one per 64 bit lane. The 8 byte blocks all four buffers have in common are compressed in the vector registers,
+ * then each lane finishes its remaining blocks and the length block with the scalar code.
+ */
+#define NANO_SIPHASH_ROTL(x, b) _mm256_or_si256 (_mm256_slli_epi64 (x, b), _mm256_srli_epi64 (x, 64 - b))
+#define NANO_SIPHASH_ROUND                 \
+	v0 = _mm256_add_epi64 (v0, v1);        \
+	v1 = NANO_SIPHASH_ROTL (v1, 13);       \
+	v1 = _mm256_xor_si256 (v1, v0);        \
+	v0 = NANO_SIPHASH_ROTL (v0, 32);       \
+	v2 = _mm256_add_epi64 (v2, v3);        \
+	v3 = NANO_SIPHASH_ROTL (v3, 16);       \
+	v3 = _mm256_xor_si256 (v3, v2);        \
+	v0 = _mm256_add_epi64 (v0, v3);        \
+	v3 = NANO_SIPHASH_ROTL (v3, 21);       \
+	v3 = _mm256_xor_si256 (v3, v0);        \
+	v2 = _mm256_add_epi64 (v2, v1);        \
+	v1 = NANO_SIPHASH_ROTL (v1, 17);       \
+	v1 = _mm256_xor_si256 (v1, v2);        \
+	v2 = NANO_SIPHASH_ROTL (v2, 32);
+
+__attribute__ ((target ("avx2"))) void siphash_avx2 (uint64_t k0_a, uint64_t k1_a, uint8_t const * const * bytes_a, size_t const * sizes_a, size_t count_a, nano::uint128_t * digests_a)
+{
+	size_t constexpr lanes{ 4 };
+	size_t i (0);
+	for (; i + lanes <= count_a; i += lanes)
+	{
+		siphash_state initial (k0_a, k1_a);
+		auto v0 (_mm256_set1_epi64x (initial.v[0]));
+		auto v1 (_mm256_set1_epi64x (initial.v[1]));
+		auto v2 (_mm256_set1_epi64x (initial.v[2]));
+		auto v3 (_mm256_set1_epi64x (initial.v[3]));
+		auto common (std::min ({ sizes_a[i], sizes_a[i + 1], sizes_a[i + 2], sizes_a[i + 3] }) / sizeof (uint64_t) * sizeof (uint64_t));
+		for (size_t offset (0); offset < common; offset += sizeof (uint64_t))
+		{
+			auto m (_mm256_set_epi64x (load_little (bytes_a[i + 3] + offset), load_little (bytes_a[i + 2] + offset), load_little (bytes_a[i + 1] + offset), load_little (bytes_a[i] + offset)));
+			v3 = _mm256_xor_si256 (v3, m);
+			NANO_SIPHASH_ROUND
+			NANO_SIPHASH_ROUND
+			v0 = _mm256_xor_si256 (v0, m);
+		}
+		alignas (32) uint64_t state[4][lanes];
+		_mm256_store_si256 (reinterpret_cast<__m256i *> (state[0]), v0);
+		_mm256_store_si256 (reinterpret_cast<__m256i *> (state[1]), v1);
+		_mm256_store_si256 (reinterpret_cast<__m256i *> (state[2]), v2);
+		_mm256_store_si256 (reinterpret_cast<__m256i *> (state[3]), v3);
+		for (size_t lane (0); lane < lanes; ++lane)
+		{
+			siphash_state state_l (k0_a, k1_a);
+			for (auto j (0); j < 4; ++j)
+			{
+				state_l.v[j] = state[j][lane];
+			}
+			digests_a[i + lane] = state_l.finish (bytes_a[i + lane], sizes_a[i + lane], common);
+		}
+	}
+	siphash_scalar (k0_a, k1_a, bytes_a + i, sizes_a + i, count_a - i, digests_a + i);
+}
+#undef NANO_SIPHASH_ROUND
+#undef NANO_SIPHASH_ROTL
+
+bool avx2_supported ()
+{
+	static bool const result (__builtin_cpu_supports ("avx2"));
+	return result;
+}
+#endif
+}
+
 nano::network_filter::network_filter (size_t size_a) :
-items (size_a, nano::uint128_t{ 0 })
+items (size_a)
 {
 	nano::random_pool::generate_block (key, key.size ());
 }
 
 bool nano::network_filter::apply (uint8_t const * bytes_a, size_t count_a, nano::uint128_t * digest_a)
 {
-	// Get hash before locking
 	auto digest (hash (bytes_a, count_a));
-
-	nano::lock_guard<std::mutex> lock (mutex);
-	auto & element (get_element (digest));
-	bool existed (element == digest);
-	if (!existed)
-	{
-		// Replace likely old element with a new one
-		element = digest;
-	}
 	if (digest_a)
 	{
 		*digest_a = digest;
 	}
-	return existed;
+	return apply (digest);
 }
 
-void nano::network_filter::clear (nano::uint128_t const & digest_a)
+bool nano::network_filter::apply (nano::uint128_t const & digest_a)
 {
-	nano::lock_guard<std::mutex> lock (mutex);
+	auto tag_l (tag (digest_a));
 	auto & element (get_element (digest_a));
-	if (element == digest_a)
-	{
-		element = nano::uint128_t{ 0 };
-	}
+	// Replace likely old element with a new one, unless it is already this digest
+	return element.load (std::memory_order_relaxed) == tag_l || element.exchange (tag_l, std::memory_order_relaxed) == tag_l;
+}
+
+void nano::network_filter::clear (nano::uint128_t const & digest_a)
+{
+	auto expected (tag (digest_a));
+	get_element (digest_a).compare_exchange_strong (expected, 0, std::memory_order_relaxed);
 }
 
 void nano::network_filter::clear (std::vector<nano::uint128_t> const & digests_a)
 {
-	nano::lock_guard<std::mutex> lock (mutex);
 	for (auto const & digest : digests_a)
 	{
-		auto & element (get_element (digest));
-		if (element == digest)
-		{
-			element = nano::uint128_t{ 0 };
-		}
+		clear (digest);
 	}
 }
 
@@ -66,8 +225,10 @@ void nano::network_filter::clear (OBJECT const & object_a)
 
 void nano::network_filter::clear ()
 {
-	nano::lock_guard<std::mutex> lock (mutex);
-	items.assign (items.size (), nano::uint128_t{ 0 });
+	for (auto & element : items)
+	{
+		element.store (0, std::memory_order_relaxed);
+	}
 }
 
 template <typename OBJECT>
@@ -81,14 +242,19 @@ nano::uint128_t nano::network_filter::hash (OBJECT const & object_a) const
 	return hash (bytes.data (), bytes.size ());
 }
 
-nano::uint128_t & nano::network_filter::get_element (nano::uint128_t const & hash_a)
+std::atomic<uint64_t> & nano::network_filter::get_element (nano::uint128_t const & hash_a)
 {
-	debug_assert (!mutex.try_lock ());
 	debug_assert (items.size () > 0);
 	size_t index (hash_a % items.size ());
 	return items[index];
 }
 
+uint64_t nano::network_filter::tag (nano::uint128_t const & hash_a)
+{
+	auto result (static_cast<uint64_t> (hash_a >> 64));
+	return result != 0 ? result : 1;
+}
+
 nano::uint128_t nano::network_filter::hash (uint8_t const * bytes_a, size_t count_a) const
 {
 	nano::uint128_union digest{ 0 };
@@ -97,6 +263,22 @@ nano::uint128_t nano::network_filter::hash (uint8_t const * bytes_a, size_t coun
 	return digest.number ();
 }
 
+void nano::network_filter::hash (uint8_t const * const * bytes_a, size_t const * sizes_a, size_t count_a, nano::uint128_t * digests_a) const
+{
+	auto k0 (load_little (key.data ()));
+	auto k1 (load_little (key.data () + sizeof (uint64_t)));
+#ifdef NANO_NETWORK_FILTER_X86
+	if (avx2_supported ())
+	{
+		siphash_avx2 (k0, k1, bytes_a, sizes_a, count_a, digests_a);
+	}
+	else
+#endif
+	{
+		siphash_scalar (k0, k1, bytes_a, sizes_a, count_a, digests_a);
+	}
+}
+
 // Explicitly instantiate
 template nano::uint128_t nano::network_filter::hash (std::shared_ptr<nano::block> const &) const;
 template void nano::network_filter::clear (std::shared_ptr<nano::block> const &);
@@ -6,13 +6,15 @@
 #include <crypto/cryptopp/seckey.h>
 #include <crypto/cryptopp/siphash.h>
 
-#include <mutex>
+#include <atomic>
+#include <vector>
 
 namespace nano
 {
 /**
  * A probabilistic duplicate filter based on directed map caches, using SipHash 2/4/128
- * The probability of false negatives (unique packet marked as duplicate) is the probability of a 128-bit SipHash collision.
+ * The low bits of the digest select an element and the upper 64 bits are stored in it, elements are atomics so the filter is lock-free.
+ * The probability of false negatives (unique packet marked as duplicate) is the probability of a collision on both the element index and the stored 64 bits.
  * The probability of false positives (duplicate packet marked as unique) shrinks with a larger filter.
  * @note This class is thread-safe.
  */
@@ -29,6 +31,12 @@ public:
 	 **/
 	bool apply (uint8_t const * bytes_a, size_t count_a, nano::uint128_t * digest_a = nullptr);
 
+	/**
+	 * Inserts a digest previously computed by hash in the filter.
+	 * @return a boolean representing the previous existence of the hash in the filter.
+	 **/
+	bool apply (nano::uint128_t const & digest_a);
+
 	/**
 	 * Sets the corresponding element in the filter to zero, if it matches \p digest_a exactly.
 	 **/
@@ -62,24 +70,34 @@ public:
 	template <typename OBJECT>
 	nano::uint128_t hash (OBJECT const & object_a) const;
 
+	/**
+	 * Hashes \p count_a bytes starting from \p bytes_a .
+	 * @return the siphash digest of the contents in \p bytes_a .
+	 **/
+	nano::uint128_t hash (uint8_t const * bytes_a, size_t count_a) const;
+
+	/**
+	 * Computes the siphash digest of \p count_a buffers at once, buffer i being [ \p bytes_a[i], \p bytes_a[i] + \p sizes_a[i] ] and its digest written to \p digests_a[i].
+	 * Several buffers are digested in parallel SIMD lanes where the CPU supports it, the results are identical to hashing each buffer separately.
+	 * @warning will read out of bounds if any of the buffers is not a valid range
+	 **/
+	void hash (uint8_t const * const * bytes_a, size_t const * sizes_a, size_t count_a, nano::uint128_t * digests_a) const;
+
 private:
 	using siphash_t = CryptoPP::SipHash<2, 4, true>;
 
 	/**
 	 * Get element from digest.
-	 * @note must have a lock on mutex
 	 * @return a reference to the element with key \p hash_a
 	 **/
-	nano::uint128_t & get_element (nano::uint128_t const & hash_a);
+	std::atomic<uint64_t> & get_element (nano::uint128_t const & hash_a);
 
 	/**
-	 * Hashes \p count_a bytes starting from \p bytes_a .
-	 * @return the siphash digest of the contents in \p bytes_a .
+	 * Value stored in the element for \p hash_a , never zero as zero marks an empty element
 	 **/
-	nano::uint128_t hash (uint8_t const * bytes_a, size_t count_a) const;
+	static uint64_t tag (nano::uint128_t const & hash_a);
 
-	std::vector<nano::uint128_t> items;
+	std::vector<std::atomic<uint64_t>> items;
 	CryptoPP::SecByteBlock key{ siphash_t::KEYLENGTH };
-	std::mutex mutex;
 };
 }
@@ -453,6 +453,49 @@ TEST (node, mass_vote_by_hash)
 	}
 }
 
+// Measures how many votes per second are counted by elections with hundreds of representatives
+TEST (election, mass_vote_tally)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	// Quorum is never reached so every vote goes through the tally and quorum check
+	node_config.online_weight_minimum = std::numeric_limits<nano::uint128_t>::max ();
+	auto & node (*system.add_node (node_config));
+	size_t const rep_count (500);
+	size_t const election_count (200);
+	std::vector<nano::keypair> reps (rep_count);
+	for (auto const & rep : reps)
+	{
+		node.ledger.cache.rep_weights.representation_add (rep.pub, nano::Gxrb_ratio);
+	}
+	std::vector<std::shared_ptr<nano::election>> elections;
+	std::vector<nano::block_hash> hashes;
+	for (size_t i (0); i < election_count; ++i)
+	{
+		auto block (std::make_shared<nano::send_block> (nano::genesis_hash, nano::keypair ().pub, i, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, 0));
+		block->sideband_set ({});
+		elections.push_back (std::make_shared<nano::election> (node, block, nullptr, false, nano::election_behavior::normal));
+		hashes.push_back (block->hash ());
+	}
+	nano::lock_guard<std::mutex> guard (node.active.mutex);
+	nano::timer<std::chrono::microseconds> timer;
+	timer.start ();
+	for (size_t i (0); i < rep_count; ++i)
+	{
+		for (size_t j (0); j < election_count; ++j)
+		{
+			// Every other representative votes for a fork the elections have not seen
+			ASSERT_TRUE (elections[j]->vote (reps[i].pub, 1, i % 2 == 0 ? hashes[j] : nano::block_hash (i)).processed);
+		}
+	}
+	auto elapsed (timer.stop ());
+	std::cout << rep_count << " representatives x " << election_count << " elections: " << elapsed.count () << " " << timer.unit () << ", " << (rep_count * election_count * 1000000ULL) / std::max<uint64_t> (1, elapsed.count ()) << " votes/s" << std::endl;
+	for (auto const & election : elections)
+	{
+		ASSERT_EQ (rep_count / 2 * nano::Gxrb_ratio, election->tally ().begin ()->first);
+	}
+}
+
 namespace nano
 {
 TEST (confirmation_height, many_accounts_single_confirmation)